@@ -3,12 +3,20 @@
 
 from . import core
 
+# Default number of bytes queued by Stream.write before an eager write is attempted.
+_HIGH_WATER = 1024
+
 
 class Stream:
     def __init__(self, s, e={}):
         self.s = s
         self.e = e
-        self.out_buf = b""
+        self.out_buf = []  # queue of buffers waiting to be written
+        self.out_idx = 0  # index in out_buf of the buffer being written
+        self.out_off = 0  # number of bytes of out_buf[out_idx] already written
+        self.out_len = 0  # number of bytes in out_buf not yet written
+        self.corked = False
+        self.high_water = _HIGH_WATER
 
     def get_extra_info(self, v):
         return self.e[v]
@@ -64,28 +72,103 @@ class Stream:
                 return l
 
     def write(self, buf):
-        if not self.out_buf:
+        if not self.out_buf and not self.corked:
             # Try to write immediately to the underlying stream.
             ret = self.s.write(buf)
             if ret == len(buf):
                 return
             if ret is not None:
-                buf = buf[ret:]
-        self.out_buf += buf
+                buf = memoryview(buf)[ret:]
+        if type(buf) is not bytes:
+            # Take a copy of other buffers since the caller is free to reuse them.
+            buf = bytes(memoryview(buf))
+        self.out_buf.append(buf)
+        self.out_len += len(buf)
+        if self.out_len >= self.high_water:
+            # Too much data queued up so try to write some of it out now.
+            self._flush(False)
+
+    # Hold back written data until uncork is called so that small writes (e.g., headers and body)
+    # are coalesced and go out to the stream in a single write.
+    def cork(self):
+        self.corked = True
+
+    def uncork(self):
+        self.corked = False
+        if self.out_buf:
+            self._flush(True)
+
+    def set_write_buffer_limits(self, high=None):
+        self.high_water = _HIGH_WATER if high is None else high
+
+    def get_write_buffer_size(self):
+        return self.out_len
+
+    # Write some of the queued data with a single non-blocking write, continuing from
+    # where the last write stopped.  With gather, the queued buffers are first joined
+    # into one so they go out together, but only when the rest of the buffer being
+    # written is smaller than the data behind it, so each queued byte is copied about
+    # once however slowly the stream accepts data.
+    def _flush(self, gather):
+        q = self.out_buf
+        i = self.out_idx
+        off = self.out_off
+        if gather and len(q) - i > 1 and len(q[i]) - off < self.out_len - (len(q[i]) - off):
+            q[:] = [b"".join([q[i][off:]] + q[i + 1 :])]
+            i = off = 0
+        ret = self.s.write(memoryview(q[i])[off:])
+        if ret is not None:
+            self.out_len -= ret
+            off += ret
+            if off == len(q[i]):
+                # Drop written buffers in bulk, rather than one at a time from the
+                # front of the list, which would move the rest each time.
+                q[i] = None
+                i += 1
+                off = 0
+                if 2 * i >= len(q):
+                    del q[:i]
+                    i = 0
+        self.out_idx = i
+        self.out_off = off
 
     # async
     def drain(self):
         if not self.out_buf:
             # Drain must always yield, so a tight loop of write+drain can't block the scheduler.
             return (yield from core.sleep_ms(0))
-        mv = memoryview(self.out_buf)
-        off = 0
-        while off < len(mv):
+        self.corked = False
+        while self.out_buf:
+            yield core._io_queue.queue_write(self.s)
+            self._flush(True)
+
+    # async
+    def do_handshake(self):
+        # Drive the TLS handshake of a non-blocking SSLSocket, waiting on whichever direction
+        # it needs so that other tasks keep running in the meantime.
+        from ssl import SSLWantReadError, SSLWantWriteError
+
+        while True:
+            try:
+                return self.s.do_handshake()
+            except SSLWantReadError:
+                yield core._io_queue.queue_read(self.s)
+            except SSLWantWriteError:
+                yield core._io_queue.queue_write(self.s)
+
+    # async
+    def sendfile(self, file, offset=0, count=None):
+        # Write out any queued data first so that it is sent ahead of the file contents.
+        yield from self.drain()
+        n = 0
+        while count is None or n < count:
             yield core._io_queue.queue_write(self.s)
-            ret = self.s.write(mv[off:])
+            ret = self.s.sendfile(file, offset + n, None if count is None else count - n)
             if ret is not None:
-                off += ret
-        self.out_buf = b""
+                if not ret:
+                    break
+                n += ret
+        return n
 
 
 # Stream can be used for both reading and writing to save code size
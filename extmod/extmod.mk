@@ -18,6 +18,7 @@ SRC_EXTMOD_C += \
 	extmod/machine_uart.c \
 	extmod/machine_usb_device.c \
 	extmod/machine_wdt.c \
+	extmod/modarrayops.c \
 	extmod/modasyncio.c \
 	extmod/modbinascii.c \
 	extmod/modbluetooth.c \
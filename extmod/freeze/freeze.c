@@ -560,7 +560,8 @@ static void freeze_write_str(freeze_writer_t *self, const mp_obj_str_t *str) {
 
     freeze_align(self, __alignof__(mp_obj_str_t));
     freeze_write_base(self, &str->base);
-    freeze_write_size(self, str->hash);
+    // The frozen object can't cache its hash, so work it out now.
+    freeze_write_size(self, mp_obj_str_get_hash(MP_OBJ_FROM_PTR(str)));
     freeze_write_size(self, str->len);
     freeze_write_aliased_ptr(self, str->data, str->len + 1, __alignof__(char));
 }
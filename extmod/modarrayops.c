@@ -0,0 +1,826 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#include <limits.h>
+#include <string.h>
+
+#include "py/binary.h"
+#include "py/objint.h"
+#include "py/runtime.h"
+#include "py/smallint.h"
+
+#if MICROPY_PY_ARRAYOPS
+
+// Elementwise operations on numeric buffers: array.array, memoryview, bytearray
+// and bytes.  Each buffer is read and written directly as its C element type,
+// without boxing values.  Arithmetic is done on long long if all operands are
+// integers, otherwise on mp_float_t, and the result is converted to the
+// destination type as a C cast would, wrapping integers.  Reductions and clip
+// are exact instead: sum and dot continue with big ints if long long would
+// overflow, and 64-bit unsigned values are compared as unsigned.
+//
+// On x86-64 the common cases where all arrays have the same typecode use SSE2,
+// with the scalar loops handling the remaining elements and all other cases.
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define ARRAYOPS_SSE2 (1)
+#else
+#define ARRAYOPS_SSE2 (0)
+#endif
+
+enum {
+    ARRAYOPS_ADD,
+    ARRAYOPS_SUB,
+    ARRAYOPS_MUL,
+};
+
+typedef struct _arrayops_vec_t {
+    char typecode;
+    bool is_float;
+    byte *buf;
+    size_t len; // number of elements
+} arrayops_vec_t;
+
+// A scalar operand, or an array operand if vec.buf is not NULL.
+typedef struct _arrayops_arg_t {
+    arrayops_vec_t vec;
+    bool is_float;
+    bool i_big; // i holds an unsigned value above LLONG_MAX
+    long long i;
+    #if MICROPY_PY_BUILTINS_FLOAT
+    mp_float_t f;
+    #endif
+} arrayops_arg_t;
+
+static void arrayops_get_vec(mp_obj_t obj, arrayops_vec_t *v, mp_uint_t flags) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(obj, &bufinfo, flags);
+    char typecode = bufinfo.typecode == BYTEARRAY_TYPECODE ? 'B' : bufinfo.typecode;
+    switch (typecode) {
+        case 'b':
+        case 'B':
+        case 'h':
+        case 'H':
+        case 'i':
+        case 'I':
+        case 'l':
+        case 'L':
+        case 'q':
+        case 'Q':
+        #if MICROPY_PY_BUILTINS_FLOAT
+        case 'f':
+        case 'd':
+        #endif
+            break;
+        default:
+            mp_raise_ValueError(MP_ERROR_TEXT("unsupported typecode"));
+    }
+    v->typecode = typecode;
+    v->is_float = typecode == 'f' || typecode == 'd';
+    v->buf = bufinfo.buf;
+    v->len = bufinfo.len / mp_binary_get_size('@', typecode, NULL);
+}
+
+static void arrayops_get_arg(mp_obj_t obj, arrayops_arg_t *arg) {
+    mp_buffer_info_t bufinfo;
+    if (mp_get_buffer(obj, &bufinfo, MP_BUFFER_READ)) {
+        arrayops_get_vec(obj, &arg->vec, MP_BUFFER_READ);
+        arg->is_float = arg->vec.is_float;
+        arg->i_big = false;
+        arg->i = 0;
+        #if MICROPY_PY_BUILTINS_FLOAT
+        arg->f = 0;
+        #endif
+        return;
+    }
+    arg->vec.buf = NULL;
+    #if MICROPY_PY_BUILTINS_FLOAT
+    if (mp_obj_is_float(obj)) {
+        arg->is_float = true;
+        arg->f = mp_obj_float_get(obj);
+        return;
+    }
+    #endif
+    arg->is_float = false;
+    arg->i_big = false;
+    #if MICROPY_LONGINT_IMPL != MICROPY_LONGINT_IMPL_NONE
+    arg->i = mp_obj_get_ll(obj);
+    #if MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_MPZ
+    if (mp_obj_is_exact_type(obj, &mp_type_int) && !mp_obj_is_small_int(obj)) {
+        // values outside the range of long long and unsigned long long are
+        // truncated, which wraps as a C cast would
+        arg->i_big = arg->i < 0 && mp_obj_int_sign(obj) > 0;
+    }
+    #endif
+    #else
+    arg->i = mp_obj_get_int(obj);
+    #endif
+    #if MICROPY_PY_BUILTINS_FLOAT
+    arg->f = arg->i_big ? (mp_float_t)(unsigned long long)arg->i : (mp_float_t)arg->i;
+    #endif
+}
+
+// Get a scalar bound for clip, saturated to the range of the integer types, so
+// that it compares with every element as the Python int would.
+static void arrayops_get_bound(mp_obj_t obj, arrayops_arg_t *arg) {
+    arrayops_get_arg(obj, arg);
+    if (arg->vec.buf != NULL) {
+        mp_raise_TypeError(NULL);
+    }
+    #if MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_MPZ
+    if (!arg->is_float && mp_obj_is_exact_type(obj, &mp_type_int) && !mp_obj_is_small_int(obj)) {
+        if (mp_obj_int_sign(obj) < 0) {
+            if (mp_obj_is_true(mp_binary_op(MP_BINARY_OP_LESS, obj, mp_obj_new_int_from_ll(LLONG_MIN)))) {
+                arg->i = LLONG_MIN;
+            }
+        } else if (mp_obj_is_true(mp_binary_op(MP_BINARY_OP_MORE, obj, mp_obj_new_int_from_ull(ULLONG_MAX)))) {
+            arg->i_big = true;
+            arg->i = (long long)ULLONG_MAX;
+        }
+    }
+    #endif
+}
+
+static void arrayops_check_len(size_t len1, size_t len2) {
+    if (len1 != len2) {
+        mp_raise_ValueError(MP_ERROR_TEXT("lengths must match"));
+    }
+}
+
+static size_t arrayops_vec_nbytes(const arrayops_vec_t *v) {
+    return v->len * mp_binary_get_size('@', v->typecode, NULL);
+}
+
+// Elements are processed in increasing order, each read before it is written,
+// so dest may be exactly the same memory as a source with the same element
+// size.  If src overlaps dest in any other way, copy it to the heap so that
+// writing dest doesn't change elements of src before they are read.  Returns
+// the copy, to be freed by the caller, or NULL if src wasn't copied.
+static byte *arrayops_unalias(const arrayops_vec_t *dest, arrayops_vec_t *src) {
+    size_t src_nbytes = arrayops_vec_nbytes(src);
+    if (src->buf + src_nbytes <= dest->buf || dest->buf + arrayops_vec_nbytes(dest) <= src->buf
+        || (src->buf == dest->buf && src_nbytes == arrayops_vec_nbytes(dest))) {
+        return NULL;
+    }
+    byte *copy = m_new(byte, src_nbytes);
+    memcpy(copy, src->buf, src_nbytes);
+    src->buf = copy;
+    return copy;
+}
+
+static void arrayops_free_copy(byte *copy, const arrayops_vec_t *v) {
+    if (copy != NULL) {
+        m_del(byte, copy, arrayops_vec_nbytes(v));
+    }
+}
+
+// Whether the typecode is a 64-bit unsigned integer, which doesn't fit in a long long.
+static bool arrayops_is_u64(char typecode) {
+    return typecode == 'Q' || (typecode == 'L' && sizeof(unsigned long) == 8);
+}
+
+static mp_obj_t arrayops_new_int(long long val) {
+    if (val >= MP_SMALL_INT_MIN && val <= MP_SMALL_INT_MAX) {
+        return MP_OBJ_NEW_SMALL_INT((mp_int_t)val);
+    }
+    return mp_obj_new_int_from_ll(val);
+}
+
+// Whether x < y, where each is an unsigned value above LLONG_MAX if its flag is set.
+static bool arrayops_int_lt(long long x, bool x_big, long long y, bool y_big) {
+    if (x_big != y_big) {
+        return y_big;
+    }
+    return x_big ? (unsigned long long)x < (unsigned long long)y : x < y;
+}
+
+#if MICROPY_PY_BUILTINS_FLOAT
+// Truncate towards zero, saturating values out of range and mapping nan to 0.
+static long long arrayops_float_to_int(mp_float_t x) {
+    if (x >= (mp_float_t)LLONG_MAX) {
+        return LLONG_MAX;
+    } else if (x <= (mp_float_t)LLONG_MIN) {
+        return LLONG_MIN;
+    } else if (x != x) {
+        return 0;
+    }
+    return (long long)x;
+}
+#endif
+
+static long long arrayops_get_int(const arrayops_vec_t *v, size_t i) {
+    const void *p = v->buf;
+    switch (v->typecode) {
+        case 'b':
+            return ((const signed char *)p)[i];
+        case 'B':
+            return ((const unsigned char *)p)[i];
+        case 'h':
+            return ((const short *)p)[i];
+        case 'H':
+            return ((const unsigned short *)p)[i];
+        case 'i':
+            return ((const int *)p)[i];
+        case 'I':
+            return ((const unsigned int *)p)[i];
+        case 'l':
+            return ((const long *)p)[i];
+        case 'L':
+            return ((const unsigned long *)p)[i];
+        case 'q':
+            return ((const long long *)p)[i];
+        case 'Q':
+            return (long long)((const unsigned long long *)p)[i];
+        #if MICROPY_PY_BUILTINS_FLOAT
+        case 'f':
+            return arrayops_float_to_int(((const float *)p)[i]);
+        case 'd':
+            return arrayops_float_to_int((mp_float_t)((const double *)p)[i]);
+        #endif
+    }
+    return 0;
+}
+
+static void arrayops_set_int(const arrayops_vec_t *v, size_t i, long long val) {
+    void *p = v->buf;
+    switch (v->typecode) {
+        case 'b':
+            ((signed char *)p)[i] = (signed char)val;
+            break;
+        case 'B':
+            ((unsigned char *)p)[i] = (unsigned char)val;
+            break;
+        case 'h':
+            ((short *)p)[i] = (short)val;
+            break;
+        case 'H':
+            ((unsigned short *)p)[i] = (unsigned short)val;
+            break;
+        case 'i':
+            ((int *)p)[i] = (int)val;
+            break;
+        case 'I':
+            ((unsigned int *)p)[i] = (unsigned int)val;
+            break;
+        case 'l':
+            ((long *)p)[i] = (long)val;
+            break;
+        case 'L':
+            ((unsigned long *)p)[i] = (unsigned long)val;
+            break;
+        case 'q':
+            ((long long *)p)[i] = val;
+            break;
+        case 'Q':
+            ((unsigned long long *)p)[i] = (unsigned long long)val;
+            break;
+        #if MICROPY_PY_BUILTINS_FLOAT
+        case 'f':
+            ((float *)p)[i] = (float)val;
+            break;
+        case 'd':
+            ((double *)p)[i] = (double)val;
+            break;
+        #endif
+    }
+}
+
+#if MICROPY_PY_BUILTINS_FLOAT
+static mp_float_t arrayops_get_float(const arrayops_vec_t *v, size_t i) {
+    switch (v->typecode) {
+        case 'f':
+            return (mp_float_t)((const float *)v->buf)[i];
+        case 'd':
+            return (mp_float_t)((const double *)v->buf)[i];
+        default:
+            if (arrayops_is_u64(v->typecode)) {
+                return (mp_float_t)(unsigned long long)arrayops_get_int(v, i);
+            }
+            return (mp_float_t)arrayops_get_int(v, i);
+    }
+}
+
+static void arrayops_set_float(const arrayops_vec_t *v, size_t i, mp_float_t val) {
+    switch (v->typecode) {
+        case 'f':
+            ((float *)v->buf)[i] = (float)val;
+            break;
+        case 'd':
+            ((double *)v->buf)[i] = (double)val;
+            break;
+        default:
+            arrayops_set_int(v, i, arrayops_float_to_int(val));
+            break;
+    }
+}
+
+static mp_float_t arrayops_arg_get_float(const arrayops_arg_t *arg, size_t i) {
+    return arg->vec.buf == NULL ? arg->f : arrayops_get_float(&arg->vec, i);
+}
+#endif
+
+static long long arrayops_arg_get_int(const arrayops_arg_t *arg, size_t i) {
+    return arg->vec.buf == NULL ? arg->i : arrayops_get_int(&arg->vec, i);
+}
+
+static mp_obj_t arrayops_get_int_obj(const arrayops_vec_t *v, size_t i) {
+    long long val = arrayops_get_int(v, i);
+    if (arrayops_is_u64(v->typecode) && val < 0) {
+        return mp_obj_new_int_from_ull((unsigned long long)val);
+    }
+    return arrayops_new_int(val);
+}
+
+/******************************************************************************/
+// SSE2 kernels, each returning the number of elements it processed
+
+#if ARRAYOPS_SSE2
+
+// Return the width in bytes of an integer typecode, or 0 if it's a float.
+static size_t arrayops_int_width(char typecode) {
+    return typecode == 'f' || typecode == 'd' ? 0 : mp_binary_get_size('@', typecode, NULL);
+}
+
+static size_t arrayops_binop_sse2(int op, const arrayops_vec_t *dest, const arrayops_vec_t *a, const arrayops_arg_t *b) {
+    char tc = dest->typecode;
+    if (a->typecode != tc || (b->vec.buf != NULL && b->vec.typecode != tc)) {
+        return 0;
+    }
+    size_t n = dest->len;
+    size_t i = 0;
+    const byte *pa = a->buf;
+    const byte *pb = b->vec.buf;
+    byte *pd = dest->buf;
+    if (tc == 'f' || tc == 'd') {
+        if (tc == 'f' && b->vec.buf == NULL && (mp_float_t)(float)b->f != b->f) {
+            // the scalar would be rounded differently to the scalar loop
+            return 0;
+        }
+        if (tc == 'f') {
+            __m128 vs = _mm_set1_ps((float)b->f);
+            for (; i + 4 <= n; i += 4) {
+                __m128 x = _mm_loadu_ps((const float *)pa + i);
+                __m128 y = pb != NULL ? _mm_loadu_ps((const float *)pb + i) : vs;
+                x = op == ARRAYOPS_ADD ? _mm_add_ps(x, y) : op == ARRAYOPS_SUB ? _mm_sub_ps(x, y) : _mm_mul_ps(x, y);
+                _mm_storeu_ps((float *)pd + i, x);
+            }
+        } else {
+            __m128d vs = _mm_set1_pd((double)b->f);
+            for (; i + 2 <= n; i += 2) {
+                __m128d x = _mm_loadu_pd((const double *)pa + i);
+                __m128d y = pb != NULL ? _mm_loadu_pd((const double *)pb + i) : vs;
+                x = op == ARRAYOPS_ADD ? _mm_add_pd(x, y) : op == ARRAYOPS_SUB ? _mm_sub_pd(x, y) : _mm_mul_pd(x, y);
+                _mm_storeu_pd((double *)pd + i, x);
+            }
+        }
+        return i;
+    }
+    if (b->vec.buf == NULL && b->is_float) {
+        return 0;
+    }
+    size_t w = arrayops_int_width(tc);
+    if (op == ARRAYOPS_MUL && w != 2) {
+        // SSE2 only has a 16-bit multiply
+        return 0;
+    }
+    __m128i vs;
+    switch (w) {
+        case 1:
+            vs = _mm_set1_epi8((char)b->i);
+            break;
+        case 2:
+            vs = _mm_set1_epi16((short)b->i);
+            break;
+        case 4:
+            vs = _mm_set1_epi32((int)b->i);
+            break;
+        default:
+            vs = _mm_set1_epi64x(b->i);
+            break;
+    }
+    size_t per = 16 / w;
+    for (; i + per <= n; i += per) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(pa + i * w));
+        __m128i y = pb != NULL ? _mm_loadu_si128((const __m128i *)(pb + i * w)) : vs;
+        if (op == ARRAYOPS_MUL) {
+            x = _mm_mullo_epi16(x, y);
+        } else {
+            if (op == ARRAYOPS_SUB) {
+                y = w == 1 ? _mm_sub_epi8(_mm_setzero_si128(), y)
+                    : w == 2 ? _mm_sub_epi16(_mm_setzero_si128(), y)
+                    : w == 4 ? _mm_sub_epi32(_mm_setzero_si128(), y)
+                    : _mm_sub_epi64(_mm_setzero_si128(), y);
+            }
+            x = w == 1 ? _mm_add_epi8(x, y)
+                : w == 2 ? _mm_add_epi16(x, y)
+                : w == 4 ? _mm_add_epi32(x, y)
+                : _mm_add_epi64(x, y);
+        }
+        _mm_storeu_si128((__m128i *)(pd + i * w), x);
+    }
+    return i;
+}
+
+// Sum a->len elements into *fsum or *isum; b is NULL for sum, else it's a dot product.
+static size_t arrayops_sum_sse2(const arrayops_vec_t *a, const arrayops_vec_t *b, mp_float_t *fsum, long long *isum) {
+    size_t n = a->len;
+    size_t i = 0;
+    char tc = a->typecode;
+    if (b != NULL && b->typecode != tc) {
+        return 0;
+    }
+    if (tc == 'f' || tc == 'd') {
+        // accumulate in double, for the same precision as the scalar loop
+        __m128d acc0 = _mm_setzero_pd();
+        __m128d acc1 = _mm_setzero_pd();
+        if (tc == 'f') {
+            for (; i + 4 <= n; i += 4) {
+                __m128 x = _mm_loadu_ps((const float *)a->buf + i);
+                __m128d lo = _mm_cvtps_pd(x);
+                __m128d hi = _mm_cvtps_pd(_mm_movehl_ps(x, x));
+                if (b != NULL) {
+                    __m128 y = _mm_loadu_ps((const float *)b->buf + i);
+                    lo = _mm_mul_pd(lo, _mm_cvtps_pd(y));
+                    hi = _mm_mul_pd(hi, _mm_cvtps_pd(_mm_movehl_ps(y, y)));
+                }
+                acc0 = _mm_add_pd(acc0, lo);
+                acc1 = _mm_add_pd(acc1, hi);
+            }
+        } else {
+            for (; i + 2 <= n; i += 2) {
+                __m128d x = _mm_loadu_pd((const double *)a->buf + i);
+                if (b != NULL) {
+                    x = _mm_mul_pd(x, _mm_loadu_pd((const double *)b->buf + i));
+                }
+                acc0 = _mm_add_pd(acc0, x);
+            }
+        }
+        double out[2];
+        _mm_storeu_pd(out, _mm_add_pd(acc0, acc1));
+        *fsum += (mp_float_t)(out[0] + out[1]);
+        return i;
+    }
+    if (b != NULL) {
+        return 0;
+    }
+    if (tc == 'B') {
+        // sum of absolute differences against zero adds 8 bytes into each 64-bit half
+        __m128i acc = _mm_setzero_si128();
+        for (; i + 16 <= n; i += 16) {
+            __m128i x = _mm_loadu_si128((const __m128i *)(a->buf + i));
+            acc = _mm_add_epi64(acc, _mm_sad_epu8(x, _mm_setzero_si128()));
+        }
+        long long out[2];
+        _mm_storeu_si128((__m128i *)out, acc);
+        *isum += out[0] + out[1];
+    } else if (tc == 'h' || tc == 'H') {
+        // pairs of 16-bit values are added into 32-bit lanes, which are flushed
+        // before they can overflow; unsigned values are biased to be signed
+        __m128i ones = _mm_set1_epi16(1);
+        __m128i bias = _mm_set1_epi16(tc == 'H' ? (short)0x8000 : 0);
+        while (i + 8 <= n) {
+            __m128i acc = _mm_setzero_si128();
+            size_t end = n - i > 8 * 16384 ? i + 8 * 16384 : n;
+            for (; i + 8 <= end; i += 8) {
+                __m128i x = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(a->buf + i * 2)), bias);
+                acc = _mm_add_epi32(acc, _mm_madd_epi16(x, ones));
+            }
+            int out[4];
+            _mm_storeu_si128((__m128i *)out, acc);
+            *isum += (long long)out[0] + out[1] + out[2] + out[3];
+        }
+        if (tc == 'H') {
+            *isum += 0x8000 * (long long)i;
+        }
+    }
+    return i;
+}
+
+// Clip a into dest in place of the scalar loop, for lo and hi in range of the type.
+static size_t arrayops_clip_sse2(const arrayops_vec_t *dest, const arrayops_vec_t *a, const arrayops_arg_t *lo, const arrayops_arg_t *hi) {
+    char tc = dest->typecode;
+    if (a->typecode != tc || lo->vec.buf != NULL || hi->vec.buf != NULL) {
+        return 0;
+    }
+    size_t n = dest->len;
+    size_t i = 0;
+    if (tc == 'f') {
+        if ((mp_float_t)(float)lo->f != lo->f || (mp_float_t)(float)hi->f != hi->f) {
+            return 0;
+        }
+        __m128 vlo = _mm_set1_ps((float)lo->f);
+        __m128 vhi = _mm_set1_ps((float)hi->f);
+        for (; i + 4 <= n; i += 4) {
+            // the operand order makes nan pass through, as in the scalar loop
+            __m128 x = _mm_max_ps(vlo, _mm_loadu_ps((const float *)a->buf + i));
+            _mm_storeu_ps((float *)dest->buf + i, _mm_min_ps(vhi, x));
+        }
+    } else if (tc == 'h' && !lo->is_float && !hi->is_float && !lo->i_big && !hi->i_big
+               && lo->i >= SHRT_MIN && lo->i <= SHRT_MAX && hi->i >= SHRT_MIN && hi->i <= SHRT_MAX) {
+        __m128i vlo = _mm_set1_epi16((short)lo->i);
+        __m128i vhi = _mm_set1_epi16((short)hi->i);
+        for (; i + 8 <= n; i += 8) {
+            __m128i x = _mm_max_epi16(_mm_loadu_si128((const __m128i *)(a->buf + i * 2)), vlo);
+            _mm_storeu_si128((__m128i *)(dest->buf + i * 2), _mm_min_epi16(x, vhi));
+        }
+    } else if (tc == 'B' && !lo->is_float && !hi->is_float && !lo->i_big && !hi->i_big
+               && lo->i >= 0 && lo->i <= UCHAR_MAX && hi->i >= 0 && hi->i <= UCHAR_MAX) {
+        __m128i vlo = _mm_set1_epi8((char)lo->i);
+        __m128i vhi = _mm_set1_epi8((char)hi->i);
+        for (; i + 16 <= n; i += 16) {
+            __m128i x = _mm_max_epu8(_mm_loadu_si128((const __m128i *)(a->buf + i)), vlo);
+            _mm_storeu_si128((__m128i *)(dest->buf + i), _mm_min_epu8(x, vhi));
+        }
+    }
+    return i;
+}
+
+#endif // ARRAYOPS_SSE2
+
+/******************************************************************************/
+// Module functions
+
+static mp_obj_t arrayops_binop(int op, mp_obj_t dest_in, mp_obj_t a_in, mp_obj_t b_in) {
+    arrayops_vec_t dest, a;
+    arrayops_arg_t b;
+    arrayops_get_vec(dest_in, &dest, MP_BUFFER_WRITE);
+    arrayops_get_vec(a_in, &a, MP_BUFFER_READ);
+    arrayops_get_arg(b_in, &b);
+    arrayops_check_len(dest.len, a.len);
+    byte *b_copy = NULL;
+    if (b.vec.buf != NULL) {
+        arrayops_check_len(dest.len, b.vec.len);
+        b_copy = arrayops_unalias(&dest, &b.vec);
+    }
+    byte *a_copy = arrayops_unalias(&dest, &a);
+    size_t i = 0;
+    #if ARRAYOPS_SSE2
+    i = arrayops_binop_sse2(op, &dest, &a, &b);
+    #endif
+    #if MICROPY_PY_BUILTINS_FLOAT
+    if (dest.is_float || a.is_float || b.is_float) {
+        for (; i < dest.len; ++i) {
+            mp_float_t x = arrayops_get_float(&a, i);
+            mp_float_t y = arrayops_arg_get_float(&b, i);
+            arrayops_set_float(&dest, i, op == ARRAYOPS_ADD ? x + y : op == ARRAYOPS_SUB ? x - y : x * y);
+        }
+    } else
+    #endif
+    {
+        for (; i < dest.len; ++i) {
+            // unsigned arithmetic so that overflow wraps
+            unsigned long long x = arrayops_get_int(&a, i);
+            unsigned long long y = arrayops_arg_get_int(&b, i);
+            arrayops_set_int(&dest, i, (long long)(op == ARRAYOPS_ADD ? x + y : op == ARRAYOPS_SUB ? x - y : x * y));
+        }
+    }
+    arrayops_free_copy(a_copy, &a);
+    arrayops_free_copy(b_copy, &b.vec);
+    return mp_const_none;
+}
+
+static mp_obj_t arrayops_add(mp_obj_t dest_in, mp_obj_t a_in, mp_obj_t b_in) {
+    return arrayops_binop(ARRAYOPS_ADD, dest_in, a_in, b_in);
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(arrayops_add_obj, arrayops_add);
+
+static mp_obj_t arrayops_sub(mp_obj_t dest_in, mp_obj_t a_in, mp_obj_t b_in) {
+    return arrayops_binop(ARRAYOPS_SUB, dest_in, a_in, b_in);
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(arrayops_sub_obj, arrayops_sub);
+
+static mp_obj_t arrayops_mul(mp_obj_t dest_in, mp_obj_t a_in, mp_obj_t b_in) {
+    return arrayops_binop(ARRAYOPS_MUL, dest_in, a_in, b_in);
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(arrayops_mul_obj, arrayops_mul);
+
+static mp_obj_t arrayops_sum_helper(const arrayops_vec_t *a, const arrayops_vec_t *b) {
+    size_t i = 0;
+    #if MICROPY_PY_BUILTINS_FLOAT
+    if (a->is_float || (b != NULL && b->is_float)) {
+        mp_float_t sum = 0;
+        #if ARRAYOPS_SSE2
+        i = arrayops_sum_sse2(a, b, &sum, NULL);
+        #endif
+        for (; i < a->len; ++i) {
+            sum += arrayops_get_float(a, i) * (b != NULL ? arrayops_get_float(b, i) : 1);
+        }
+        return mp_obj_new_float(sum);
+    }
+    #endif
+    long long sum = 0;
+    #if ARRAYOPS_SSE2
+    i = arrayops_sum_sse2(a, b, NULL, &sum);
+    #endif
+    bool a_u64 = arrayops_is_u64(a->typecode);
+    bool b_u64 = b != NULL && arrayops_is_u64(b->typecode);
+    for (; i < a->len; ++i) {
+        long long x = arrayops_get_int(a, i);
+        long long y = b != NULL ? arrayops_get_int(b, i) : 1;
+        long long t;
+        if ((a_u64 && x < 0) || (b_u64 && y < 0)
+            || mp_mul_ll_overflow(x, y, &t) || mp_add_ll_overflow(sum, t, &t)) {
+            break;
+        }
+        sum = t;
+    }
+    if (i == a->len) {
+        return arrayops_new_int(sum);
+    }
+    // the sum doesn't fit in a long long, so continue with int objects, which
+    // raises OverflowError if there are no big ints
+    mp_obj_t sum_obj = arrayops_new_int(sum);
+    for (; i < a->len; ++i) {
+        mp_obj_t x = arrayops_get_int_obj(a, i);
+        if (b != NULL) {
+            x = mp_binary_op(MP_BINARY_OP_MULTIPLY, x, arrayops_get_int_obj(b, i));
+        }
+        sum_obj = mp_binary_op(MP_BINARY_OP_ADD, sum_obj, x);
+    }
+    return sum_obj;
+}
+
+static mp_obj_t arrayops_sum(mp_obj_t a_in) {
+    arrayops_vec_t a;
+    arrayops_get_vec(a_in, &a, MP_BUFFER_READ);
+    return arrayops_sum_helper(&a, NULL);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(arrayops_sum_obj, arrayops_sum);
+
+static mp_obj_t arrayops_dot(mp_obj_t a_in, mp_obj_t b_in) {
+    arrayops_vec_t a, b;
+    arrayops_get_vec(a_in, &a, MP_BUFFER_READ);
+    arrayops_get_vec(b_in, &b, MP_BUFFER_READ);
+    arrayops_check_len(a.len, b.len);
+    return arrayops_sum_helper(&a, &b);
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(arrayops_dot_obj, arrayops_dot);
+
+static mp_obj_t arrayops_min_max(mp_obj_t a_in, bool is_max) {
+    arrayops_vec_t a;
+    arrayops_get_vec(a_in, &a, MP_BUFFER_READ);
+    if (a.len == 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("arg is an empty sequence"));
+    }
+    #if MICROPY_PY_BUILTINS_FLOAT
+    if (a.is_float) {
+        mp_float_t best = arrayops_get_float(&a, 0);
+        for (size_t i = 1; i < a.len; ++i) {
+            mp_float_t x = arrayops_get_float(&a, i);
+            if (is_max ? best < x : x < best) {
+                best = x;
+            }
+        }
+        return mp_obj_new_float(best);
+    }
+    #endif
+    if (arrayops_is_u64(a.typecode)) {
+        unsigned long long best = arrayops_get_int(&a, 0);
+        for (size_t i = 1; i < a.len; ++i) {
+            unsigned long long x = arrayops_get_int(&a, i);
+            if (is_max ? best < x : x < best) {
+                best = x;
+            }
+        }
+        if (best <= MP_SMALL_INT_MAX) {
+            return MP_OBJ_NEW_SMALL_INT((mp_int_t)best);
+        }
+        return mp_obj_new_int_from_ull(best);
+    }
+    long long best = arrayops_get_int(&a, 0);
+    for (size_t i = 1; i < a.len; ++i) {
+        long long x = arrayops_get_int(&a, i);
+        if (is_max ? best < x : x < best) {
+            best = x;
+        }
+    }
+    return arrayops_new_int(best);
+}
+
+static mp_obj_t arrayops_min(mp_obj_t a_in) {
+    return arrayops_min_max(a_in, false);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(arrayops_min_obj, arrayops_min);
+
+static mp_obj_t arrayops_max(mp_obj_t a_in) {
+    return arrayops_min_max(a_in, true);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(arrayops_max_obj, arrayops_max);
+
+static mp_obj_t arrayops_clip(size_t n_args, const mp_obj_t *args) {
+    arrayops_vec_t dest, a;
+    arrayops_arg_t lo, hi;
+    arrayops_get_vec(args[0], &dest, MP_BUFFER_WRITE);
+    arrayops_get_vec(args[1], &a, MP_BUFFER_READ);
+    arrayops_check_len(dest.len, a.len);
+    arrayops_get_bound(args[2], &lo);
+    arrayops_get_bound(args[3], &hi);
+    byte *a_copy = arrayops_unalias(&dest, &a);
+    size_t i = 0;
+    #if ARRAYOPS_SSE2
+    i = arrayops_clip_sse2(&dest, &a, &lo, &hi);
+    #endif
+    // the result is min(max(x, lo), hi), so it's hi if lo > hi
+    #if MICROPY_PY_BUILTINS_FLOAT
+    if (dest.is_float || a.is_float || lo.is_float || hi.is_float) {
+        for (; i < dest.len; ++i) {
+            mp_float_t x = arrayops_get_float(&a, i);
+            x = x < lo.f ? lo.f : x;
+            arrayops_set_float(&dest, i, x > hi.f ? hi.f : x);
+        }
+    } else
+    #endif
+    {
+        bool a_u64 = arrayops_is_u64(a.typecode);
+        for (; i < dest.len; ++i) {
+            long long x = arrayops_get_int(&a, i);
+            bool x_big = a_u64 && x < 0;
+            if (arrayops_int_lt(x, x_big, lo.i, lo.i_big)) {
+                x = lo.i;
+                x_big = lo.i_big;
+            }
+            arrayops_set_int(&dest, i, arrayops_int_lt(hi.i, hi.i_big, x, x_big) ? hi.i : x);
+        }
+    }
+    arrayops_free_copy(a_copy, &a);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(arrayops_clip_obj, 4, 4, arrayops_clip);
+
+static mp_obj_t arrayops_convert(mp_obj_t dest_in, mp_obj_t src_in) {
+    arrayops_vec_t dest, src;
+    arrayops_get_vec(dest_in, &dest, MP_BUFFER_WRITE);
+    arrayops_get_vec(src_in, &src, MP_BUFFER_READ);
+    arrayops_check_len(dest.len, src.len);
+    byte *src_copy = arrayops_unalias(&dest, &src);
+    #if MICROPY_PY_BUILTINS_FLOAT
+    if (dest.is_float || src.is_float) {
+        for (size_t i = 0; i < dest.len; ++i) {
+            arrayops_set_float(&dest, i, arrayops_get_float(&src, i));
+        }
+    } else
+    #endif
+    {
+        for (size_t i = 0; i < dest.len; ++i) {
+            arrayops_set_int(&dest, i, arrayops_get_int(&src, i));
+        }
+    }
+    arrayops_free_copy(src_copy, &src);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(arrayops_convert_obj, arrayops_convert);
+
+static mp_obj_t arrayops_byteswap(mp_obj_t a_in) {
+    arrayops_vec_t a;
+    arrayops_get_vec(a_in, &a, MP_BUFFER_WRITE);
+    size_t w = mp_binary_get_size('@', a.typecode, NULL);
+    size_t i = 0;
+    #if ARRAYOPS_SSE2
+    if (w == 2 || w == 4) {
+        for (; i + 16 / w <= a.len; i += 16 / w) {
+            __m128i x = _mm_loadu_si128((const __m128i *)(a.buf + i * w));
+            if (w == 4) {
+                // swap the 16-bit halves of each 32-bit value
+                x = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xb1), 0xb1);
+            }
+            x = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+            _mm_storeu_si128((__m128i *)(a.buf + i * w), x);
+        }
+    }
+    #endif
+    for (byte *p = a.buf + i * w; i < a.len; ++i, p += w) {
+        for (size_t j = 0; j < w / 2; ++j) {
+            byte b = p[j];
+            p[j] = p[w - 1 - j];
+            p[w - 1 - j] = b;
+        }
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(arrayops_byteswap_obj, arrayops_byteswap);
+
+static const mp_rom_map_elem_t mp_module_arrayops_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_arrayops) },
+    { MP_ROM_QSTR(MP_QSTR_add), MP_ROM_PTR(&arrayops_add_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sub), MP_ROM_PTR(&arrayops_sub_obj) },
+    { MP_ROM_QSTR(MP_QSTR_mul), MP_ROM_PTR(&arrayops_mul_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sum), MP_ROM_PTR(&arrayops_sum_obj) },
+    { MP_ROM_QSTR(MP_QSTR_dot), MP_ROM_PTR(&arrayops_dot_obj) },
+    { MP_ROM_QSTR(MP_QSTR_min), MP_ROM_PTR(&arrayops_min_obj) },
+    { MP_ROM_QSTR(MP_QSTR_max), MP_ROM_PTR(&arrayops_max_obj) },
+    { MP_ROM_QSTR(MP_QSTR_clip), MP_ROM_PTR(&arrayops_clip_obj) },
+    { MP_ROM_QSTR(MP_QSTR_convert), MP_ROM_PTR(&arrayops_convert_obj) },
+    { MP_ROM_QSTR(MP_QSTR_byteswap), MP_ROM_PTR(&arrayops_byteswap_obj) },
+};
+
+static MP_DEFINE_CONST_DICT(mp_module_arrayops_globals, mp_module_arrayops_globals_table);
+
+const mp_obj_module_t mp_module_arrayops = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&mp_module_arrayops_globals,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_arrayops, mp_module_arrayops);
+
+#endif // MICROPY_PY_ARRAYOPS
@@ -31,6 +31,19 @@
 
 // the algorithm here is modelled on CPython's heapq.py
 
+// Fast path for the common case of int or float items, avoiding the generic comparison.
+static bool heapq_lt(mp_obj_t a, mp_obj_t b) {
+    if (mp_obj_is_small_int(a) && mp_obj_is_small_int(b)) {
+        return MP_OBJ_SMALL_INT_VALUE(a) < MP_OBJ_SMALL_INT_VALUE(b);
+    }
+    #if MICROPY_PY_BUILTINS_FLOAT && !MICROPY_ENABLE_DYNRUNTIME
+    if (mp_obj_is_float(a) && mp_obj_is_float(b)) {
+        return mp_obj_float_get(a) < mp_obj_float_get(b);
+    }
+    #endif
+    return mp_binary_op(MP_BINARY_OP_LESS, a, b) == mp_const_true;
+}
+
 static mp_obj_list_t *heapq_get_heap(mp_obj_t heap_in) {
     if (!mp_obj_is_type(heap_in, &mp_type_list)) {
         mp_raise_TypeError(MP_ERROR_TEXT("heap must be a list"));
@@ -43,7 +56,7 @@ static void heapq_heap_siftdown(mp_obj_list_t *heap, mp_uint_t start_pos, mp_uin
     while (pos > start_pos) {
         mp_uint_t parent_pos = (pos - 1) >> 1;
         mp_obj_t parent = heap->items[parent_pos];
-        if (mp_binary_op(MP_BINARY_OP_LESS, item, parent) == mp_const_true) {
+        if (heapq_lt(item, parent)) {
             heap->items[pos] = parent;
             pos = parent_pos;
         } else {
@@ -59,7 +72,7 @@ static void heapq_heap_siftup(mp_obj_list_t *heap, mp_uint_t pos) {
     mp_obj_t item = heap->items[pos];
     for (mp_uint_t child_pos = 2 * pos + 1; child_pos < end_pos; child_pos = 2 * pos + 1) {
         // choose right child if it's <= left child
-        if (child_pos + 1 < end_pos && mp_binary_op(MP_BINARY_OP_LESS, heap->items[child_pos], heap->items[child_pos + 1]) == mp_const_false) {
+        if (child_pos + 1 < end_pos && !heapq_lt(heap->items[child_pos], heap->items[child_pos + 1])) {
             child_pos += 1;
         }
         // bubble up the smaller child
@@ -103,12 +116,265 @@ static mp_obj_t mod_heapq_heapify(mp_obj_t heap_in) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(mod_heapq_heapify_obj, mod_heapq_heapify);
 
+#if MICROPY_PY_HEAPQ_PRIORITYQUEUE && !MICROPY_ENABLE_DYNRUNTIME
+
+// PriorityQueue is a binary heap in an array of pointers to entry objects. Each
+// entry has an explicit priority and knows its position in the array, so it can
+// be used as a handle to update its priority or remove it in O(log n). Entries
+// with equal priorities come out in the order they were pushed or last updated.
+// The heap is only rearranged by swapping, so it stays a valid array if
+// comparing priorities raises an exception.  A comparison that pushes to or
+// removes from the same queue raises RuntimeError, because the sift that made
+// the comparison can't continue once the array has changed under it.
+
+#define PQUEUE_NOT_QUEUED ((size_t)-1)
+
+typedef struct _mp_obj_pqueue_entry_t {
+    mp_obj_base_t base;
+    mp_obj_t priority;
+    mp_obj_t item;
+    size_t seq;
+    size_t pos;
+} mp_obj_pqueue_entry_t;
+
+typedef struct _mp_obj_pqueue_t {
+    mp_obj_base_t base;
+    size_t len;
+    size_t alloc;
+    size_t seq;
+    size_t version; // changes whenever the heap array is changed
+    mp_obj_pqueue_entry_t **heap;
+} mp_obj_pqueue_t;
+
+static const mp_obj_type_t mp_type_pqueue_entry;
+
+static bool pqueue_lt(mp_obj_pqueue_t *self, const mp_obj_pqueue_entry_t *a, const mp_obj_pqueue_entry_t *b) {
+    size_t version = self->version;
+    bool lt;
+    if (heapq_lt(a->priority, b->priority)) {
+        lt = true;
+    } else if (heapq_lt(b->priority, a->priority)) {
+        lt = false;
+    } else {
+        lt = (mp_int_t)(a->seq - b->seq) < 0;
+    }
+    if (self->version != version) {
+        mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("queue changed during comparison"));
+    }
+    return lt;
+}
+
+static void pqueue_swap(mp_obj_pqueue_t *self, size_t pos1, size_t pos2) {
+    mp_obj_pqueue_entry_t *e1 = self->heap[pos1];
+    mp_obj_pqueue_entry_t *e2 = self->heap[pos2];
+    self->heap[pos1] = e2;
+    e2->pos = pos1;
+    self->heap[pos2] = e1;
+    e1->pos = pos2;
+}
+
+// Moves the entry at pos towards the root while it's less than its parent and
+// returns its new position.
+static size_t pqueue_sift_up(mp_obj_pqueue_t *self, size_t pos) {
+    while (pos > 0) {
+        size_t parent_pos = (pos - 1) / 2;
+        if (!pqueue_lt(self, self->heap[pos], self->heap[parent_pos])) {
+            break;
+        }
+        pqueue_swap(self, pos, parent_pos);
+        pos = parent_pos;
+    }
+    return pos;
+}
+
+// Moves the entry at pos away from the root while it's greater than its children.
+static void pqueue_sift_down(mp_obj_pqueue_t *self, size_t pos) {
+    for (size_t child_pos = 2 * pos + 1; child_pos < self->len; child_pos = 2 * pos + 1) {
+        if (child_pos + 1 < self->len && pqueue_lt(self, self->heap[child_pos + 1], self->heap[child_pos])) {
+            child_pos += 1;
+        }
+        if (!pqueue_lt(self, self->heap[child_pos], self->heap[pos])) {
+            break;
+        }
+        pqueue_swap(self, pos, child_pos);
+        pos = child_pos;
+    }
+}
+
+static void pqueue_resift(mp_obj_pqueue_t *self, size_t pos) {
+    if (pqueue_sift_up(self, pos) == pos) {
+        pqueue_sift_down(self, pos);
+    }
+}
+
+static mp_obj_pqueue_entry_t *pqueue_get_entry(mp_obj_pqueue_t *self, mp_obj_t entry_in) {
+    if (mp_obj_is_type(entry_in, &mp_type_pqueue_entry)) {
+        mp_obj_pqueue_entry_t *entry = MP_OBJ_TO_PTR(entry_in);
+        if (entry->pos < self->len && self->heap[entry->pos] == entry) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static mp_obj_pqueue_entry_t *pqueue_get_entry_raise(mp_obj_pqueue_t *self, mp_obj_t entry_in) {
+    mp_obj_pqueue_entry_t *entry = pqueue_get_entry(self, entry_in);
+    if (entry == NULL) {
+        mp_raise_ValueError(MP_ERROR_TEXT("entry not in queue"));
+    }
+    return entry;
+}
+
+static void pqueue_entry_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
+    if (dest[0] != MP_OBJ_NULL) {
+        // not load attribute
+        return;
+    }
+    mp_obj_pqueue_entry_t *self = MP_OBJ_TO_PTR(self_in);
+    if (attr == MP_QSTR_priority) {
+        dest[0] = self->priority;
+    } else if (attr == MP_QSTR_item) {
+        dest[0] = self->item;
+    }
+}
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    mp_type_pqueue_entry,
+    MP_QSTR_PriorityQueueEntry,
+    MP_TYPE_FLAG_NONE,
+    attr, pqueue_entry_attr
+    );
+
+static mp_obj_t pqueue_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 0, 0, false);
+    mp_obj_pqueue_t *self = mp_obj_malloc(mp_obj_pqueue_t, type);
+    self->len = 0;
+    self->alloc = 0;
+    self->seq = 0;
+    self->version = 0;
+    self->heap = NULL;
+    return MP_OBJ_FROM_PTR(self);
+}
+
+static mp_obj_t pqueue_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
+    mp_obj_pqueue_t *self = MP_OBJ_TO_PTR(self_in);
+    switch (op) {
+        case MP_UNARY_OP_BOOL:
+            return mp_obj_new_bool(self->len != 0);
+        case MP_UNARY_OP_LEN:
+            return MP_OBJ_NEW_SMALL_INT(self->len);
+        default:
+            return MP_OBJ_NULL; // op not supported
+    }
+}
+
+static mp_obj_t pqueue_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_in) {
+    if (op != MP_BINARY_OP_CONTAINS) {
+        return MP_OBJ_NULL; // op not supported
+    }
+    return mp_obj_new_bool(pqueue_get_entry(MP_OBJ_TO_PTR(lhs_in), rhs_in) != NULL);
+}
+
+static mp_obj_t pqueue_push(mp_obj_t self_in, mp_obj_t priority, mp_obj_t item) {
+    mp_obj_pqueue_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->len == self->alloc) {
+        size_t new_alloc = self->alloc ? 2 * self->alloc : 8;
+        self->heap = m_renew(mp_obj_pqueue_entry_t *, self->heap, self->alloc, new_alloc);
+        self->alloc = new_alloc;
+    }
+    mp_obj_pqueue_entry_t *entry = mp_obj_malloc(mp_obj_pqueue_entry_t, &mp_type_pqueue_entry);
+    entry->priority = priority;
+    entry->item = item;
+    entry->seq = self->seq++;
+    entry->pos = self->len;
+    self->heap[self->len++] = entry;
+    self->version += 1;
+    pqueue_sift_up(self, entry->pos);
+    return MP_OBJ_FROM_PTR(entry);
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(pqueue_push_obj, pqueue_push);
+
+static mp_obj_pqueue_entry_t *pqueue_peek_helper(mp_obj_t self_in) {
+    mp_obj_pqueue_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->len == 0) {
+        mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("empty heap"));
+    }
+    return self->heap[0];
+}
+
+static void pqueue_remove_helper(mp_obj_pqueue_t *self, mp_obj_pqueue_entry_t *entry) {
+    size_t pos = entry->pos;
+    entry->pos = PQUEUE_NOT_QUEUED;
+    self->version += 1;
+    mp_obj_pqueue_entry_t *last = self->heap[--self->len];
+    self->heap[self->len] = NULL; // so we don't retain a pointer
+    if (pos < self->len) {
+        self->heap[pos] = last;
+        last->pos = pos;
+        pqueue_resift(self, pos);
+    }
+}
+
+static mp_obj_t pqueue_peek(mp_obj_t self_in) {
+    return MP_OBJ_FROM_PTR(pqueue_peek_helper(self_in));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(pqueue_peek_obj, pqueue_peek);
+
+static mp_obj_t pqueue_pop(mp_obj_t self_in) {
+    mp_obj_pqueue_entry_t *entry = pqueue_peek_helper(self_in);
+    pqueue_remove_helper(MP_OBJ_TO_PTR(self_in), entry);
+    return MP_OBJ_FROM_PTR(entry);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(pqueue_pop_obj, pqueue_pop);
+
+static mp_obj_t pqueue_update(mp_obj_t self_in, mp_obj_t entry_in, mp_obj_t priority) {
+    mp_obj_pqueue_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_pqueue_entry_t *entry = pqueue_get_entry_raise(self, entry_in);
+    entry->priority = priority;
+    entry->seq = self->seq++;
+    self->version += 1;
+    pqueue_resift(self, entry->pos);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(pqueue_update_obj, pqueue_update);
+
+static mp_obj_t pqueue_remove(mp_obj_t self_in, mp_obj_t entry_in) {
+    mp_obj_pqueue_t *self = MP_OBJ_TO_PTR(self_in);
+    pqueue_remove_helper(self, pqueue_get_entry_raise(self, entry_in));
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(pqueue_remove_obj, pqueue_remove);
+
+static const mp_rom_map_elem_t pqueue_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_push), MP_ROM_PTR(&pqueue_push_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pop), MP_ROM_PTR(&pqueue_pop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_peek), MP_ROM_PTR(&pqueue_peek_obj) },
+    { MP_ROM_QSTR(MP_QSTR_update), MP_ROM_PTR(&pqueue_update_obj) },
+    { MP_ROM_QSTR(MP_QSTR_remove), MP_ROM_PTR(&pqueue_remove_obj) },
+};
+static MP_DEFINE_CONST_DICT(pqueue_locals_dict, pqueue_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    mp_type_pqueue,
+    MP_QSTR_PriorityQueue,
+    MP_TYPE_FLAG_NONE,
+    make_new, pqueue_make_new,
+    unary_op, pqueue_unary_op,
+    binary_op, pqueue_binary_op,
+    locals_dict, &pqueue_locals_dict
+    );
+
+#endif // MICROPY_PY_HEAPQ_PRIORITYQUEUE && !MICROPY_ENABLE_DYNRUNTIME
+
 #if !MICROPY_ENABLE_DYNRUNTIME
 static const mp_rom_map_elem_t mp_module_heapq_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_heapq) },
     { MP_ROM_QSTR(MP_QSTR_heappush), MP_ROM_PTR(&mod_heapq_heappush_obj) },
     { MP_ROM_QSTR(MP_QSTR_heappop), MP_ROM_PTR(&mod_heapq_heappop_obj) },
     { MP_ROM_QSTR(MP_QSTR_heapify), MP_ROM_PTR(&mod_heapq_heapify_obj) },
+    #if MICROPY_PY_HEAPQ_PRIORITYQUEUE
+    { MP_ROM_QSTR(MP_QSTR_PriorityQueue), MP_ROM_PTR(&mp_type_pqueue) },
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(mp_module_heapq_globals, mp_module_heapq_globals_table);
@@ -288,34 +288,61 @@ static mp_obj_t mp_os_read(mp_obj_t fd_in, mp_obj_t n_in) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(mp_os_read_obj, mp_os_read);
 
+// Copies data from in_fd to out_fd without the GIL, so must not touch any Python objects.
+// Progress is accumulated in *progress so that the call can be restarted after EINTR. If out_fd
+// does not accept all the data read (e.g., a non-blocking socket), in_fd is seeked back over the
+// unwritten data so that it is not lost.
+static int mp_os_sendfile_nogil(int out_fd, int in_fd, size_t count, char *buf, size_t *progress) {
+    while (*progress < count) {
+        int br = read(in_fd, buf, MIN(count - *progress, MP_OS_SENDFILE_BUFFER_SIZE));
+        if (br <= 0) {
+            return br;
+        }
+        int bw = 0;
+        while (bw < br) {
+            int ret = write(out_fd, buf + bw, br - bw);
+            if (ret < 0) {
+                int errsv = errno;
+                lseek(in_fd, bw - br, SEEK_CUR);
+                errno = errsv;
+                *progress += bw;
+                return ret;
+            }
+            bw += ret;
+        }
+        *progress += br;
+    }
+    return 0;
+}
+
+__attribute__((visibility("hidden")))
+int mp_os_sendfile_fd(int out_fd, int in_fd, size_t count, size_t *progress) {
+    char *buf = m_new(char, MP_OS_SENDFILE_BUFFER_SIZE);
+    *progress = 0;
+    int ret;
+    MP_OS_CALL(ret, mp_os_sendfile_nogil, out_fd, in_fd, count, buf, progress);
+    m_del(char, buf, MP_OS_SENDFILE_BUFFER_SIZE);
+    return ret;
+}
+
 static mp_obj_t mp_os_sendfile(size_t n_args, const mp_obj_t *args) {
     int out_fd = mp_os_get_fd(args[0]);
     int in_fd = mp_os_get_fd(args[1]);
-    int count = mp_obj_get_int(args[3]);
+    mp_int_t count = mp_obj_get_int(args[3]);
+    if (count < 0) {
+        mp_raise_ValueError(NULL);
+    }
 
     if (args[2] != mp_const_none) {
         mp_os_lseek(MP_OBJ_NEW_SMALL_INT(in_fd), args[2], MP_OBJ_NEW_SMALL_INT(SEEK_SET));
     }
 
-    vstr_t buf;
-    vstr_init(&buf, MP_OS_DEFAULT_BUFFER_SIZE);
-    int progress = 0;
-    while (progress < count) {
-        int br = mp_os_read_vstr(in_fd, &buf, MIN(count - progress, MP_OS_DEFAULT_BUFFER_SIZE));
-        if (br == 0) {
-            break;
-        }
-        mp_os_check_ret(br);
-        int bw = 0;
-        while (bw < br) {
-            int ret = mp_os_write_str(out_fd, vstr_str(&buf) + bw, br - bw);
-            mp_os_check_ret(ret);
-            bw += ret;
-        }
-        progress += br;
-        vstr_clear(&buf);
+    size_t progress;
+    int ret = mp_os_sendfile_fd(out_fd, in_fd, count, &progress);
+    if (progress == 0) {
+        mp_os_check_ret(ret);
     }
-    return mp_obj_new_int(progress);
+    return mp_obj_new_int_from_uint(progress);
 }
 static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_os_sendfile_obj, 4, 4, mp_os_sendfile);
 
@@ -13,6 +13,10 @@
 #define MP_OS_DEFAULT_BUFFER_SIZE 256
 #endif
 
+#ifndef MP_OS_SENDFILE_BUFFER_SIZE
+#define MP_OS_SENDFILE_BUFFER_SIZE 1460
+#endif
+
 #define MP_OS_CALL(ret, func, ...) for (;;) { \
         MP_THREAD_GIL_EXIT(); \
         ret = func(__VA_ARGS__); \
@@ -55,6 +59,8 @@ int mp_os_read_vstr(int fd, vstr_t *vstr, size_t size);
 
 int mp_os_write_str(int fd, const char *str, size_t len);
 
+int mp_os_sendfile_fd(int out_fd, int in_fd, size_t count, size_t *progress);
+
 static inline mp_obj_t mp_time_to_obj(const time_t *t) {
     return mp_obj_new_int_from_ll(*t);
 }
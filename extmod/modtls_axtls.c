@@ -130,7 +130,7 @@ static MP_NORETURN void ssl_raise_error(int err) {
     o_str->base.type = &mp_type_str;
     o_str->data = (const byte *)errstr;
     o_str->len = strlen((char *)o_str->data);
-    o_str->hash = qstr_compute_hash(o_str->data, o_str->len);
+    o_str->hash = MP_OBJ_STR_HASH_LAZY;
 
     // Raise OSError(err, str).
     mp_obj_t args[2] = { MP_OBJ_NEW_SMALL_INT(err), MP_OBJ_FROM_PTR(o_str)};
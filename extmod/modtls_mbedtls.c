@@ -194,7 +194,7 @@ static MP_NORETURN void mbedtls_raise_error(int err) {
     o_str->base.type = &mp_type_str;
     o_str->data = o_str_buf;
     o_str->len = len;
-    o_str->hash = qstr_compute_hash(o_str->data, o_str->len);
+    o_str->hash = MP_OBJ_STR_HASH_LAZY;
     // raise
     mp_obj_t args[2] = { MP_OBJ_NEW_SMALL_INT(err), MP_OBJ_FROM_PTR(o_str)};
     nlr_raise(mp_obj_exception_make_new(&mp_type_OSError, 2, 0, args));
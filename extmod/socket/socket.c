@@ -134,7 +134,8 @@ static mp_obj_t mp_socket_bind(mp_obj_t self_in, mp_obj_t address_in) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(mp_socket_bind_obj, mp_socket_bind);
 
-static mp_obj_t mp_socket_close(mp_obj_t self_in) {
+__attribute__((visibility("hidden")))
+mp_obj_t mp_socket_close(mp_obj_t self_in) {
     mp_obj_socket_t *self = MP_OBJ_TO_PTR(self_in);
     if (self->fd >= 0) {
         int ret = close(self->fd);
@@ -443,6 +444,45 @@ static mp_obj_t mp_socket_sendall(size_t n_args, const mp_obj_t *args) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_socket_sendall_obj, 2, 3, mp_socket_sendall);
 
+static mp_obj_t mp_socket_sendfile(size_t n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    mp_obj_socket_t *self = mp_socket_get(args[0]);
+    const qstr kws[] = { MP_QSTR_file, MP_QSTR_offset, MP_QSTR_count, 0 };
+    mp_obj_t file;
+    mp_int_t offset = 0;
+    mp_obj_t count_in = mp_const_none;
+    parse_args_and_kw_map(n_args - 1, args + 1, kw_args, "O|iO", kws, &file, &offset, &count_in);
+    size_t count = SIZE_MAX;
+    if (count_in != mp_const_none) {
+        mp_int_t value = mp_obj_get_int(count_in);
+        if (value < 0) {
+            mp_raise_ValueError(NULL);
+        }
+        count = value;
+    }
+
+    int in_fd = mp_os_get_fd(file);
+    mp_os_check_ret(lseek(in_fd, offset, SEEK_SET));
+    size_t progress;
+    int ret = mp_os_sendfile_fd(self->fd, in_fd, count, &progress);
+
+    // Keep the position of the file object consistent with the data sent.
+    if (!mp_obj_is_int(file)) {
+        mp_obj_t seek_args[3];
+        mp_load_method(file, MP_QSTR_seek, seek_args);
+        seek_args[2] = mp_obj_new_int_from_uint(offset + progress);
+        mp_call_method_n_kw(1, 0, seek_args);
+    }
+
+    if (progress == 0) {
+        if (mp_os_nonblocking_ret(ret)) {
+            return mp_const_none;
+        }
+        mp_os_check_ret(ret);
+    }
+    return mp_obj_new_int_from_uint(progress);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(mp_socket_sendfile_obj, 2, mp_socket_sendfile);
+
 static mp_obj_t mp_socket_sendto(size_t n_args, const mp_obj_t *args) {
     return mp_socket_sendto_internal(n_args - 1, args, args[n_args - 1]);
 }
@@ -591,6 +631,7 @@ static const mp_rom_map_elem_t mp_socket_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_recvfrom_into),   MP_ROM_PTR(&mp_socket_recvfrom_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_send),            MP_ROM_PTR(&mp_socket_send_obj) },
     { MP_ROM_QSTR(MP_QSTR_sendall),         MP_ROM_PTR(&mp_socket_sendall_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sendfile),        MP_ROM_PTR(&mp_socket_sendfile_obj) },
     { MP_ROM_QSTR(MP_QSTR_sendto),          MP_ROM_PTR(&mp_socket_sendto_obj) },
     { MP_ROM_QSTR(MP_QSTR_setblocking),     MP_ROM_PTR(&mp_socket_setblocking_obj) },
     { MP_ROM_QSTR(MP_QSTR_settimeout),      MP_ROM_PTR(&mp_socket_settimeout_obj) },
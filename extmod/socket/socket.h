@@ -25,4 +25,6 @@ extern mp_float_t mp_socket_defaulttimeout;
 
 mp_obj_socket_t *mp_socket_get(mp_obj_t self_in);
 
+mp_obj_t mp_socket_close(mp_obj_t self_in);
+
 void mp_socket_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind);
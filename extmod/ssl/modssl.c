@@ -6,6 +6,7 @@
 
 #include "extmod/ssl/modssl.h"
 #include "extmod/ssl/sslcontext.h"
+#include "extmod/ssl/sslsession.h"
 #include "extmod/ssl/sslsocket.h"
 #include "py/extras.h"
 #include "py/objstr.h"
@@ -147,6 +148,7 @@ static const mp_rom_map_elem_t mp_module_ssl_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_SSLCertVerificationError),    MP_ROM_PTR(&mp_type_certificate_error) },
     { MP_ROM_QSTR(MP_QSTR_SSLContext),                  MP_ROM_PTR(&mp_type_sslcontext) },
     { MP_ROM_QSTR(MP_QSTR_SSLError),                    MP_ROM_PTR(&mp_type_sslerror) },
+    { MP_ROM_QSTR(MP_QSTR_SSLSession),                  MP_ROM_PTR(&mp_type_sslsession) },
     { MP_ROM_QSTR(MP_QSTR_SSLSocket),                   MP_ROM_PTR(&mp_type_sslsocket) },
     { MP_ROM_QSTR(MP_QSTR_SSLWantReadError),            MP_ROM_PTR(&mp_type_ssl_read_error) },
     { MP_ROM_QSTR(MP_QSTR_SSLWantWriteError),           MP_ROM_PTR(&mp_type_ssl_write_error) },
@@ -3,6 +3,7 @@ if(MICROPY_SSL_MBEDTLS AND MICROPY_PY_LWIP)
         ${MICROPY_EXTMOD_DIR}/ssl/certificate.c
         ${MICROPY_EXTMOD_DIR}/ssl/modssl.c
         ${MICROPY_EXTMOD_DIR}/ssl/sslcontext.c
+        ${MICROPY_EXTMOD_DIR}/ssl/sslsession.c
         ${MICROPY_EXTMOD_DIR}/ssl/sslsocket.c
     )
 endif()
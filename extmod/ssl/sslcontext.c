@@ -3,6 +3,7 @@
 
 #include <errno.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "FreeRTOS.h"
@@ -22,6 +23,14 @@
 #include "py/runtime.h"
 
 
+#define MP_SSL_SESSION_DEFAULT_TIMEOUT (86400)
+
+#if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+#define MP_SSL_HAS_CLIENT_TICKETS (1)
+#else
+#define MP_SSL_HAS_CLIENT_TICKETS (0)
+#endif
+
 static socket_tls_context_t *mp_sslcontext_get(mp_obj_t self_in) {
     mp_obj_sslcontext_t *self = MP_OBJ_TO_PTR(self_in);
     if (!self->context) {
@@ -45,9 +54,196 @@ static mp_obj_t mp_sslcontext_make_new(const mp_obj_type_t *type, size_t n_args,
     }
     self->protocol = endpoint;
     self->check_hostname = !endpoint;
+    self->session_tickets = (endpoint == MBEDTLS_SSL_IS_CLIENT) && MP_SSL_HAS_CLIENT_TICKETS;
+    self->session_cache_size = 0;
+    self->session_timeout = MP_SSL_SESSION_DEFAULT_TIMEOUT;
+    self->sessions = MP_OBJ_NULL;
+    #ifdef MBEDTLS_SSL_CACHE_C
+    self->cache = NULL;
+    #endif
+    #ifdef MBEDTLS_SSL_TICKET_C
+    self->ticket = NULL;
+    #endif
+    self->mutex = xSemaphoreCreateMutexStatic(&self->mutex_buffer);
     return MP_OBJ_FROM_PTR(self);
 }
 
+static bool mp_sslcontext_is_server(mp_obj_sslcontext_t *self) {
+    return (self->protocol & 1) == MBEDTLS_SSL_IS_SERVER;
+}
+
+// The server-side cache and ticket callbacks below are given the SSLContext
+// rather than the mbedtls contexts, so that they can hold its mutex while
+// using them. MBEDTLS_THREADING_C isn't enabled, so mbedtls doesn't lock them
+// itself.
+#ifdef MBEDTLS_SSL_CACHE_C
+static int mp_sslcontext_cache_get(void *data, unsigned char const *session_id, size_t session_id_len, mbedtls_ssl_session *session) {
+    mp_obj_sslcontext_t *self = data;
+    xSemaphoreTake(self->mutex, portMAX_DELAY);
+    int ret = self->cache ? mbedtls_ssl_cache_get(self->cache, session_id, session_id_len, session) : MBEDTLS_ERR_SSL_CACHE_ENTRY_NOT_FOUND;
+    xSemaphoreGive(self->mutex);
+    return ret;
+}
+
+static int mp_sslcontext_cache_set(void *data, unsigned char const *session_id, size_t session_id_len, const mbedtls_ssl_session *session) {
+    mp_obj_sslcontext_t *self = data;
+    xSemaphoreTake(self->mutex, portMAX_DELAY);
+    int ret = self->cache ? mbedtls_ssl_cache_set(self->cache, session_id, session_id_len, session) : MBEDTLS_ERR_SSL_CACHE_ENTRY_NOT_FOUND;
+    xSemaphoreGive(self->mutex);
+    return ret;
+}
+#endif
+
+#ifdef MBEDTLS_SSL_TICKET_C
+static int mp_sslcontext_ticket_write(void *p_ticket, const mbedtls_ssl_session *session, unsigned char *start, const unsigned char *end, size_t *tlen, uint32_t *lifetime) {
+    mp_obj_sslcontext_t *self = p_ticket;
+    xSemaphoreTake(self->mutex, portMAX_DELAY);
+    int ret = self->ticket ? mbedtls_ssl_ticket_write(self->ticket, session, start, end, tlen, lifetime) : MBEDTLS_ERR_SSL_FEATURE_UNAVAILABLE;
+    xSemaphoreGive(self->mutex);
+    return ret;
+}
+
+static int mp_sslcontext_ticket_parse(void *p_ticket, mbedtls_ssl_session *session, unsigned char *buf, size_t len) {
+    mp_obj_sslcontext_t *self = p_ticket;
+    xSemaphoreTake(self->mutex, portMAX_DELAY);
+    int ret = self->ticket ? mbedtls_ssl_ticket_parse(self->ticket, session, buf, len) : MBEDTLS_ERR_SSL_INVALID_MAC;
+    xSemaphoreGive(self->mutex);
+    return ret;
+}
+#endif
+
+static void mp_sslcontext_update_cache(mp_obj_sslcontext_t *self) {
+    socket_tls_context_t *context = mp_sslcontext_get(MP_OBJ_FROM_PTR(self));
+    if (!mp_sslcontext_is_server(self)) {
+        // The client-side cache is a dict of SSLSession objects that is created on demand.
+        if (self->session_cache_size <= 0) {
+            self->sessions = MP_OBJ_NULL;
+        }
+        return;
+    }
+    #ifdef MBEDTLS_SSL_CACHE_C
+    if (self->session_cache_size <= 0) {
+        mbedtls_ssl_conf_session_cache(&context->conf, NULL, NULL, NULL);
+        return;
+    }
+    xSemaphoreTake(self->mutex, portMAX_DELAY);
+    if (!self->cache) {
+        self->cache = malloc(sizeof(mbedtls_ssl_cache_context));
+        if (!self->cache) {
+            xSemaphoreGive(self->mutex);
+            mp_raise_OSError(errno);
+        }
+        mbedtls_ssl_cache_init(self->cache);
+    }
+    mbedtls_ssl_cache_set_max_entries(self->cache, self->session_cache_size);
+    mbedtls_ssl_cache_set_timeout(self->cache, self->session_timeout);
+    xSemaphoreGive(self->mutex);
+    mbedtls_ssl_conf_session_cache(&context->conf, self, mp_sslcontext_cache_get, mp_sslcontext_cache_set);
+    #else
+    (void)context;
+    if (self->session_cache_size > 0) {
+        self->session_cache_size = 0;
+        mp_raise_NotImplementedError(NULL);
+    }
+    #endif
+}
+
+static void mp_sslcontext_update_tickets(mp_obj_sslcontext_t *self) {
+    socket_tls_context_t *context = mp_sslcontext_get(MP_OBJ_FROM_PTR(self));
+    if (!mp_sslcontext_is_server(self)) {
+        #if MP_SSL_HAS_CLIENT_TICKETS
+        mbedtls_ssl_conf_session_tickets(&context->conf, self->session_tickets ? MBEDTLS_SSL_SESSION_TICKETS_ENABLED : MBEDTLS_SSL_SESSION_TICKETS_DISABLED);
+        return;
+        #endif
+    } else {
+        #ifdef MBEDTLS_SSL_TICKET_C
+        if (!self->session_tickets) {
+            mbedtls_ssl_conf_session_tickets_cb(&context->conf, NULL, NULL, NULL);
+            return;
+        }
+        if (!self->ticket) {
+            mbedtls_ssl_ticket_context *ticket = malloc(sizeof(mbedtls_ssl_ticket_context));
+            if (!ticket) {
+                self->session_tickets = 0;
+                mp_raise_OSError(errno);
+            }
+            mbedtls_ssl_ticket_init(ticket);
+            int ret = mbedtls_ssl_ticket_setup(ticket, context->conf.private_f_rng, context->conf.private_p_rng, MBEDTLS_CIPHER_AES_256_GCM, self->session_timeout);
+            if (ret < 0) {
+                mbedtls_ssl_ticket_free(ticket);
+                free(ticket);
+                self->session_tickets = 0;
+                mp_ssl_check_ret(ret);
+            }
+            xSemaphoreTake(self->mutex, portMAX_DELAY);
+            self->ticket = ticket;
+            xSemaphoreGive(self->mutex);
+        }
+        mbedtls_ssl_conf_session_tickets_cb(&context->conf, mp_sslcontext_ticket_write, mp_sslcontext_ticket_parse, self);
+        return;
+        #endif
+    }
+    (void)context;
+    if (self->session_tickets) {
+        self->session_tickets = 0;
+        mp_raise_NotImplementedError(NULL);
+    }
+}
+
+#ifdef MBEDTLS_SSL_TICKET_C
+static void mp_sslcontext_free_ticket(mp_obj_sslcontext_t *self) {
+    xSemaphoreTake(self->mutex, portMAX_DELAY);
+    if (self->ticket) {
+        mbedtls_ssl_ticket_free(self->ticket);
+        free(self->ticket);
+        self->ticket = NULL;
+    }
+    xSemaphoreGive(self->mutex);
+}
+#endif
+
+static void mp_sslcontext_free_sessions(mp_obj_sslcontext_t *self) {
+    #ifdef MBEDTLS_SSL_CACHE_C
+    xSemaphoreTake(self->mutex, portMAX_DELAY);
+    if (self->cache) {
+        mbedtls_ssl_cache_free(self->cache);
+        free(self->cache);
+        self->cache = NULL;
+    }
+    xSemaphoreGive(self->mutex);
+    #endif
+    #ifdef MBEDTLS_SSL_TICKET_C
+    mp_sslcontext_free_ticket(self);
+    #endif
+}
+
+mp_obj_t mp_sslcontext_get_session(mp_obj_sslcontext_t *self, mp_obj_t server_hostname) {
+    if ((self->session_cache_size <= 0) || (server_hostname == mp_const_none) || !self->sessions) {
+        return mp_const_none;
+    }
+    mp_map_elem_t *elem = mp_map_lookup(mp_obj_dict_get_map(self->sessions), server_hostname, MP_MAP_LOOKUP);
+    return elem ? elem->value : mp_const_none;
+}
+
+void mp_sslcontext_set_session(mp_obj_sslcontext_t *self, mp_obj_t server_hostname, mp_obj_t session) {
+    if ((self->session_cache_size <= 0) || (server_hostname == mp_const_none) || (session == mp_const_none)) {
+        return;
+    }
+    if (!self->sessions) {
+        self->sessions = mp_obj_new_dict(0);
+    }
+    mp_map_t *map = mp_obj_dict_get_map(self->sessions);
+    if (!mp_map_lookup(map, server_hostname, MP_MAP_LOOKUP)) {
+        // Evict entries to make room for the new session.
+        for (size_t i = 0; (i < map->alloc) && (map->used >= (size_t)self->session_cache_size); i++) {
+            if (mp_map_slot_is_filled(map, i)) {
+                mp_map_lookup(map, map->table[i].key, MP_MAP_LOOKUP_REMOVE_IF_FOUND);
+            }
+        }
+    }
+    mp_obj_dict_store(self->sessions, server_hostname, session);
+}
+
 static void mp_sslcontext_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
     switch (attr) {
         case MP_QSTR_check_hostname: {
@@ -65,6 +261,72 @@ static void mp_sslcontext_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
             break;
 
         }
+        #ifdef MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
+        case MP_QSTR_maximum_fragment_length: {
+            socket_tls_context_t *context = mp_sslcontext_get(self_in);
+            if (dest[0] != MP_OBJ_SENTINEL) {
+                // Fragment length codes 1 to 4 stand for 512, 1024, 2048 and 4096 bytes.
+                unsigned char code = context->conf.private_mfl_code;
+                dest[0] = code ? MP_OBJ_NEW_SMALL_INT(256 << code) : mp_const_none;
+            } else if (dest[1] != MP_OBJ_NULL) {
+                unsigned char code = MBEDTLS_SSL_MAX_FRAG_LEN_NONE;
+                if (dest[1] != mp_const_none) {
+                    mp_int_t value = mp_obj_get_int(dest[1]);
+                    code = MBEDTLS_SSL_MAX_FRAG_LEN_512;
+                    while ((code < MBEDTLS_SSL_MAX_FRAG_LEN_INVALID) && ((256 << code) != value)) {
+                        code++;
+                    }
+                }
+                if (mbedtls_ssl_conf_max_frag_len(&context->conf, code) < 0) {
+                    mp_raise_ValueError(NULL);
+                }
+                dest[0] = MP_OBJ_NULL;
+            }
+            break;
+        }
+        #endif
+        case MP_QSTR_session_cache_size: {
+            mp_obj_sslcontext_t *self = MP_OBJ_TO_PTR(self_in);
+            if (dest[0] != MP_OBJ_SENTINEL) {
+                dest[0] = mp_obj_new_int(self->session_cache_size);
+            } else if (dest[1] != MP_OBJ_NULL) {
+                self->session_cache_size = MAX(0, mp_obj_get_int(dest[1]));
+                mp_sslcontext_update_cache(self);
+                dest[0] = MP_OBJ_NULL;
+            }
+            break;
+        }
+        case MP_QSTR_session_tickets: {
+            mp_obj_sslcontext_t *self = MP_OBJ_TO_PTR(self_in);
+            if (dest[0] != MP_OBJ_SENTINEL) {
+                dest[0] = mp_obj_new_bool(self->session_tickets);
+            } else if (dest[1] != MP_OBJ_NULL) {
+                self->session_tickets = mp_obj_is_true(dest[1]);
+                mp_sslcontext_update_tickets(self);
+                dest[0] = MP_OBJ_NULL;
+            }
+            break;
+        }
+        case MP_QSTR_session_timeout: {
+            mp_obj_sslcontext_t *self = MP_OBJ_TO_PTR(self_in);
+            if (dest[0] != MP_OBJ_SENTINEL) {
+                dest[0] = mp_obj_new_int(self->session_timeout);
+            } else if (dest[1] != MP_OBJ_NULL) {
+                mp_int_t value = mp_obj_get_int(dest[1]);
+                if (value <= 0) {
+                    mp_raise_ValueError(NULL);
+                }
+                self->session_timeout = value;
+                #ifdef MBEDTLS_SSL_TICKET_C
+                // Ticket lifetime is fixed when the ticket keys are created, so recreate them.
+                mp_sslcontext_free_ticket(self);
+                #endif
+                mp_sslcontext_update_cache(self);
+                mp_sslcontext_update_tickets(self);
+                dest[0] = MP_OBJ_NULL;
+            }
+            break;
+        }
         case MP_QSTR_protocol: {
             mp_obj_sslcontext_t *self = MP_OBJ_TO_PTR(self_in);
             if (dest[0] != MP_OBJ_SENTINEL) {
@@ -103,6 +365,7 @@ static mp_obj_t mp_sslcontext_del(mp_obj_t self_in) {
         socket_tls_context_free(self->context);
         self->context = NULL;
     }
+    mp_sslcontext_free_sessions(self);
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(mp_sslcontext_del_obj, mp_sslcontext_del);
@@ -421,7 +684,7 @@ static mp_obj_t mp_sslcontext_wrap_socket(size_t n_args, const mp_obj_t *pos_arg
     flags |= server_side ? SOCKET_TLS_FLAG_SERVER_SIDE : 0;
     flags |= do_handshake_on_connect ? SOCKET_TLS_FLAG_DO_HANDSHAKE_ON_CONNECT : 0;
     flags |= suppress_ragged_eofs ? SOCKET_TLS_FLAG_SUPPRESS_RAGGED_EOFS : 0;
-    return mp_sslsocket_make_new(sock, MP_OBJ_TO_PTR(pos_args[0]), flags, server_hostname);
+    return mp_sslsocket_make_new(sock, MP_OBJ_TO_PTR(pos_args[0]), flags, server_hostname, session);
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(mp_sslcontext_wrap_socket_obj, 1, mp_sslcontext_wrap_socket);
 
@@ -3,10 +3,15 @@
 
 #pragma once
 
+#include "FreeRTOS.h"
+#include "semphr.h"
+
 #include "morelib/lwip/tls.h"
 
 #include "mbedtls/ctr_drbg.h"
 #include "mbedtls/ssl.h"
+#include "mbedtls/ssl_cache.h"
+#include "mbedtls/ssl_ticket.h"
 #include "mbedtls/x509_crt.h"
 
 #include "py/obj.h"
@@ -18,6 +23,27 @@ typedef struct {
     socket_tls_context_t *context;
     int protocol:1;
     int check_hostname:1;
+    int session_tickets:1;
+    mp_int_t session_cache_size;
+    mp_int_t session_timeout;
+    // Client-side session cache mapping server hostname to SSLSession
+    mp_obj_t sessions;
+    #ifdef MBEDTLS_SSL_CACHE_C
+    // Server-side session cache
+    mbedtls_ssl_cache_context *cache;
+    #endif
+    #ifdef MBEDTLS_SSL_TICKET_C
+    // Server-side session ticket keys
+    mbedtls_ssl_ticket_context *ticket;
+    #endif
+    // Guards cache and ticket, which the handshakes of all sockets share and
+    // run with the GIL released
+    SemaphoreHandle_t mutex;
+    StaticSemaphore_t mutex_buffer;
 } mp_obj_sslcontext_t;
 
-extern const mp_obj_type_t mp_type_sslcontext;
\ No newline at end of file
+extern const mp_obj_type_t mp_type_sslcontext;
+
+mp_obj_t mp_sslcontext_get_session(mp_obj_sslcontext_t *self, mp_obj_t server_hostname);
+
+void mp_sslcontext_set_session(mp_obj_sslcontext_t *self, mp_obj_t server_hostname, mp_obj_t session);
\ No newline at end of file
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#include "extmod/ssl/modssl.h"
+#include "extmod/ssl/sslsession.h"
+#include "py/runtime.h"
+
+
+mp_obj_t mp_sslsession_new(const mbedtls_ssl_session *session) {
+    size_t len = 0;
+    mbedtls_ssl_session_save(session, NULL, 0, &len);
+    vstr_t vstr;
+    vstr_init_len(&vstr, len);
+    int ret = mbedtls_ssl_session_save(session, (unsigned char *)vstr_str(&vstr), len, &len);
+    if (ret < 0) {
+        vstr_clear(&vstr);
+        mp_ssl_check_ret(ret);
+    }
+
+    mp_obj_sslsession_t *self = mp_obj_malloc(mp_obj_sslsession_t, &mp_type_sslsession);
+    self->data = mp_obj_new_bytes_from_vstr(&vstr);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+int mp_sslsession_load(mp_obj_t self_in, mbedtls_ssl_session *session) {
+    if (!mp_obj_is_type(self_in, &mp_type_sslsession)) {
+        mp_raise_TypeError(NULL);
+    }
+    mp_obj_sslsession_t *self = MP_OBJ_TO_PTR(self_in);
+    size_t len;
+    const char *data = mp_obj_str_get_data(self->data, &len);
+    return mbedtls_ssl_session_load(session, (const unsigned char *)data, len);
+}
+
+static void mp_sslsession_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
+    if (dest[0] != MP_OBJ_NULL) {
+        return;
+    }
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    int ret = mp_sslsession_load(self_in, &session);
+    if (ret < 0) {
+        mbedtls_ssl_session_free(&session);
+        mp_ssl_check_ret(ret);
+    }
+    switch (attr) {
+        case MP_QSTR_id:
+            dest[0] = mp_obj_new_bytes(session.private_id, session.private_id_len);
+            break;
+        #ifdef MBEDTLS_HAVE_TIME
+        case MP_QSTR_time:
+            dest[0] = mp_obj_new_int_from_ll(session.private_start);
+            break;
+        #endif
+        #if defined(MBEDTLS_SSL_SESSION_TICKETS) && defined(MBEDTLS_SSL_CLI_C)
+        case MP_QSTR_has_ticket:
+            dest[0] = mp_obj_new_bool(session.private_ticket_len > 0);
+            break;
+        case MP_QSTR_ticket_lifetime_hint:
+            dest[0] = mp_obj_new_int_from_uint(session.private_ticket_lifetime);
+            break;
+        #endif
+        default:
+            dest[1] = MP_OBJ_SENTINEL;
+            break;
+    }
+    mbedtls_ssl_session_free(&session);
+}
+
+static mp_obj_t mp_sslsession_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_in) {
+    if ((op != MP_BINARY_OP_EQUAL) || !mp_obj_is_type(rhs_in, &mp_type_sslsession)) {
+        return MP_OBJ_NULL;
+    }
+    mp_obj_sslsession_t *lhs = MP_OBJ_TO_PTR(lhs_in);
+    mp_obj_sslsession_t *rhs = MP_OBJ_TO_PTR(rhs_in);
+    return mp_obj_new_bool(mp_obj_equal(lhs->data, rhs->data));
+}
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    mp_type_sslsession,
+    MP_QSTR_SSLSession,
+    MP_TYPE_FLAG_NONE,
+    attr, mp_sslsession_attr,
+    binary_op, mp_sslsession_binary_op
+    );
@@ -0,0 +1,21 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "mbedtls/ssl.h"
+
+#include "py/obj.h"
+
+
+typedef struct {
+    mp_obj_base_t base;
+    // Serialized mbedtls_ssl_session
+    mp_obj_t data;
+} mp_obj_sslsession_t;
+
+extern const mp_obj_type_t mp_type_sslsession;
+
+mp_obj_t mp_sslsession_new(const mbedtls_ssl_session *session);
+
+int mp_sslsession_load(mp_obj_t self_in, mbedtls_ssl_session *session);
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: 2025 Gregory Neverov
 // SPDX-License-Identifier: MIT
 
+#include <string.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
@@ -9,6 +10,7 @@
 #include "extmod/io/modio.h"
 #include "extmod/modos_newlib.h"
 #include "extmod/ssl/modssl.h"
+#include "extmod/ssl/sslsession.h"
 #include "extmod/ssl/sslsocket.h"
 #include "py/extras.h"
 #include "py/runtime.h"
@@ -32,6 +34,65 @@ static struct socket_tls *mp_sslsocket_acquire(mp_obj_sslsocket_t *self) {
 
 static mp_obj_t mp_sslsocket_do_handshake(mp_obj_t self_in);
 
+// Returns the session of the socket as an SSLSession object, or None if the handshake is not complete.
+static mp_obj_t mp_sslsocket_get_session(mp_obj_sslsocket_t *self) {
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    struct socket_tls *socket = mp_sslsocket_acquire(self);
+    int ret = -1;
+    if (mbedtls_ssl_is_handshake_over(&socket->ssl)) {
+        ret = mbedtls_ssl_get_session(&socket->ssl, &session);
+    }
+    socket_tls_release(socket);
+
+    mp_obj_t result = mp_const_none;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        if (ret >= 0) {
+            result = mp_sslsession_new(&session);
+        }
+        nlr_pop();
+    } else {
+        mbedtls_ssl_session_free(&session);
+        nlr_jump(nlr.ret_val);
+    }
+    mbedtls_ssl_session_free(&session);
+    return result;
+}
+
+// Stores the session of a client socket in the context's session cache for later resumption.
+static void mp_sslsocket_save_session(mp_obj_sslsocket_t *self) {
+    if (self->server_side || (self->sslcontext->session_cache_size <= 0) || (self->server_hostname == mp_const_none)) {
+        return;
+    }
+    mp_obj_t session = mp_sslsocket_get_session(self);
+    mp_sslcontext_set_session(self->sslcontext, self->server_hostname, session);
+}
+
+static bool mp_sslsocket_session_reused(mp_obj_sslsocket_t *self) {
+    bool reused = false;
+    #ifdef MBEDTLS_SSL_PROTO_TLS1_2
+    if (self->session == mp_const_none) {
+        return false;
+    }
+    mbedtls_ssl_session offered;
+    mbedtls_ssl_session current;
+    mbedtls_ssl_session_init(&offered);
+    mbedtls_ssl_session_init(&current);
+    if (mp_sslsession_load(self->session, &offered) >= 0) {
+        struct socket_tls *socket = mp_sslsocket_acquire(self);
+        if (mbedtls_ssl_is_handshake_over(&socket->ssl) && (mbedtls_ssl_get_session(&socket->ssl, &current) >= 0)) {
+            // A resumed session keeps the master secret of the original session.
+            reused = memcmp(offered.private_master, current.private_master, sizeof(offered.private_master)) == 0;
+        }
+        socket_tls_release(socket);
+    }
+    mbedtls_ssl_session_free(&current);
+    mbedtls_ssl_session_free(&offered);
+    #endif
+    return reused;
+}
+
 static int mp_sslsocket_call_handshake(mp_obj_sslsocket_t *self) {
     struct socket_tls *socket = mp_sslsocket_acquire(self);
     int ret;
@@ -40,10 +101,16 @@ static int mp_sslsocket_call_handshake(mp_obj_sslsocket_t *self) {
     return ret;
 }
 
-mp_obj_t mp_sslsocket_make_new(mp_obj_t sock, mp_obj_sslcontext_t *sslcontext, int flags, mp_obj_t server_hostname_in) {
-    if ((flags & SOCKET_TLS_FLAG_SERVER_SIDE) && (server_hostname_in != mp_const_none)) {
+mp_obj_t mp_sslsocket_make_new(mp_obj_t sock, mp_obj_sslcontext_t *sslcontext, int flags, mp_obj_t server_hostname_in, mp_obj_t session) {
+    if ((flags & SOCKET_TLS_FLAG_SERVER_SIDE) && ((server_hostname_in != mp_const_none) || (session != mp_const_none))) {
         mp_raise_ValueError(NULL);
     }
+    if ((session != mp_const_none) && !mp_obj_is_type(session, &mp_type_sslsession)) {
+        mp_raise_TypeError(NULL);
+    }
+    if (session == mp_const_none) {
+        session = mp_sslcontext_get_session(sslcontext, server_hostname_in);
+    }
     const char *server_hostname = NULL;
     if (sslcontext->check_hostname) {
         if (server_hostname_in != mp_const_none) {
@@ -68,12 +135,14 @@ mp_obj_t mp_sslsocket_make_new(mp_obj_t sock, mp_obj_sslcontext_t *sslcontext, i
     self->sslcontext = sslcontext;
     self->server_side = flags & SOCKET_TLS_FLAG_SERVER_SIDE;
     self->server_hostname = server_hostname_in;
+    self->session = session;
 
     mp_load_method(MP_OBJ_FROM_PTR(self), MP_QSTR_settimeout, args);
     mp_call_method_n_kw(1, 0, args);
 
     struct socket_tls *socket = mp_sslsocket_acquire(self);
     int ret = 0;
+    bool handshake = false;
     if (sslcontext->check_hostname) {
         ret = socket_tls_check_ret(mbedtls_ssl_set_hostname(&socket->ssl, server_hostname));
         if (ret < 0) {
@@ -81,16 +150,31 @@ mp_obj_t mp_sslsocket_make_new(mp_obj_t sock, mp_obj_sslcontext_t *sslcontext, i
         }
     }
 
+    if (session != mp_const_none) {
+        // Resumption is best effort, so fall back to a full handshake if the session can't be used.
+        mbedtls_ssl_session ssl_session;
+        mbedtls_ssl_session_init(&ssl_session);
+        if (mp_sslsession_load(session, &ssl_session) >= 0) {
+            mbedtls_ssl_set_session(&socket->ssl, &ssl_session);
+        }
+        mbedtls_ssl_session_free(&ssl_session);
+    }
+
     if (flags & SOCKET_TLS_FLAG_DO_HANDSHAKE_ON_CONNECT) {
         ret = mp_sslsocket_call_handshake(self);
         if ((ret < 0) && (errno == ENOTCONN)) {
             ret = 0;
-        }        
+        } else {
+            handshake = ret >= 0;
+        }
     }
 
 exit:
     socket_tls_release(socket);
     mp_os_check_ret(ret);
+    if (handshake) {
+        mp_sslsocket_save_session(self);
+    }
     return MP_OBJ_FROM_PTR(self);
 }
 
@@ -108,6 +192,12 @@ static void mp_sslsocket_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
         case MP_QSTR_server_hostname:
             dest[0] = mp_sslsocket_get(self_in)->server_hostname;
             break;
+        case MP_QSTR_session:
+            dest[0] = mp_sslsocket_get_session(mp_sslsocket_get(self_in));
+            break;
+        case MP_QSTR_session_reused:
+            dest[0] = mp_obj_new_bool(mp_sslsocket_session_reused(mp_sslsocket_get(self_in)));
+            break;
         default:
             mp_super_attr(self_in, &mp_type_sslsocket, attr, dest);
             break;
@@ -134,10 +224,33 @@ static mp_obj_t mp_sslsocket_cipher(mp_obj_t self_in) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(mp_sslsocket_cipher_obj, mp_sslsocket_cipher);
 
+static mp_obj_t mp_sslsocket_close(mp_obj_t self_in) {
+    mp_obj_sslsocket_t *self = MP_OBJ_TO_PTR(self_in);
+    if (self->sock.fd >= 0) {
+        // Save the session in case the handshake happened implicitly during read or write.
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            mp_sslsocket_save_session(self);
+            nlr_pop();
+        }
+    }
+    return mp_socket_close(self_in);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(mp_sslsocket_close_obj, mp_sslsocket_close);
+
 static mp_obj_t mp_sslsocket_do_handshake(mp_obj_t self_in) {
     mp_obj_sslsocket_t *self = mp_sslsocket_get(self_in);
     int ret = mp_sslsocket_call_handshake(self);
+    if (mp_os_nonblocking_ret(ret)) {
+        // Tell the caller which poll event the handshake is waiting on: data left unsent
+        // means it is blocked on writing, otherwise it is waiting for the peer.
+        struct socket_tls *socket = mp_sslsocket_acquire(self);
+        bool want_write = socket->ssl.private_out_left > 0;
+        socket_tls_release(socket);
+        mp_ssl_check_ret(want_write ? MBEDTLS_ERR_SSL_WANT_WRITE : MBEDTLS_ERR_SSL_WANT_READ);
+    }
     mp_os_check_ret(ret);
+    mp_sslsocket_save_session(self);
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(mp_sslsocket_do_handshake_obj, mp_sslsocket_do_handshake);
@@ -182,6 +295,95 @@ static mp_obj_t mp_sslsocket_selected_alpn_protocol(mp_obj_t self_in) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(mp_sslsocket_selected_alpn_protocol_obj, mp_sslsocket_selected_alpn_protocol);
 
+// Writes all of buf, returning the number of bytes written, or an error if nothing was written.
+static int mp_sslsocket_write_all(mp_obj_sslsocket_t *self, const byte *buf, size_t len, int flags) {
+    size_t offset = 0;
+    while (offset < len) {
+        int ret;
+        MP_OS_CALL(ret, send, self->sock.fd, buf + offset, len - offset, flags);
+        if (ret < 0) {
+            return offset ? (int)offset : ret;
+        }
+        offset += ret;
+    }
+    return offset;
+}
+
+static mp_obj_t mp_sslsocket_sendmsg(size_t n_args, const mp_obj_t *args) {
+    mp_obj_sslsocket_t *self = mp_sslsocket_get(args[0]);
+    if ((n_args > 2) && mp_obj_is_true(args[2])) {
+        mp_raise_ValueError(NULL);
+    }
+    int flags = (n_args > 3) ? mp_obj_get_int(args[3]) : 0;
+
+    struct socket_tls *socket = mp_sslsocket_acquire(self);
+    int ret = mbedtls_ssl_get_max_out_record_payload(&socket->ssl);
+    socket_tls_release(socket);
+    if (ret < 0) {
+        mp_ssl_check_ret(ret);
+    }
+
+    // Coalesce the buffers into full records so that small buffers don't each cost a record of
+    // their own. Buffers that span whole records are written directly without copying.
+    size_t record_len = ret;
+    vstr_t record;
+    vstr_init(&record, MIN(record_len, MP_OS_DEFAULT_BUFFER_SIZE));
+    size_t total = 0;
+    ret = 0;
+    mp_obj_iter_buf_t iter_buf;
+    mp_obj_t iterable = mp_getiter(args[1], &iter_buf);
+    mp_obj_t item;
+    while ((item = mp_iternext(iterable)) != MP_OBJ_STOP_ITERATION) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(item, &bufinfo, MP_BUFFER_READ);
+        const byte *buf = bufinfo.buf;
+        size_t len = bufinfo.len;
+        while (len > 0) {
+            size_t n;
+            size_t expected;
+            if ((vstr_len(&record) == 0) && (len >= record_len)) {
+                n = expected = len - len % record_len;
+                ret = mp_sslsocket_write_all(self, buf, n, flags);
+            } else {
+                n = MIN(len, record_len - vstr_len(&record));
+                vstr_add_strn(&record, (const char *)buf, n);
+                buf += n;
+                len -= n;
+                if (vstr_len(&record) < record_len) {
+                    continue;
+                }
+                n = 0;
+                expected = record_len;
+                ret = mp_sslsocket_write_all(self, (const byte *)vstr_str(&record), record_len, flags);
+                vstr_reset(&record);
+            }
+            if (ret < 0) {
+                goto exit;
+            }
+            total += ret;
+            if ((size_t)ret < expected) {
+                goto exit;
+            }
+            buf += n;
+            len -= n;
+        }
+    }
+    if (vstr_len(&record) > 0) {
+        ret = mp_sslsocket_write_all(self, (const byte *)vstr_str(&record), vstr_len(&record), flags);
+        if (ret > 0) {
+            total += ret;
+        }
+    }
+
+exit:
+    vstr_clear(&record);
+    if (total == 0) {
+        mp_os_check_ret(ret);
+    }
+    return mp_obj_new_int_from_uint(total);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_sslsocket_sendmsg_obj, 2, 4, mp_sslsocket_sendmsg);
+
 static mp_obj_t mp_sslsocket_unwrap(mp_obj_t self_in) {
     mp_obj_sslsocket_t *self = mp_sslsocket_get(self_in);
     struct socket_tls *socket = mp_sslsocket_acquire(self);
@@ -210,11 +412,13 @@ static MP_DEFINE_CONST_FUN_OBJ_1(mp_sslsocket_version_obj, mp_sslsocket_version)
 
 static const mp_rom_map_elem_t mp_sslsocket_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_cipher),          MP_ROM_PTR(&mp_sslsocket_cipher_obj) },
+    { MP_ROM_QSTR(MP_QSTR_close),           MP_ROM_PTR(&mp_sslsocket_close_obj) },
     { MP_ROM_QSTR(MP_QSTR_do_handshake),    MP_ROM_PTR(&mp_sslsocket_do_handshake_obj) },
     { MP_ROM_QSTR(MP_QSTR_getpeercert),     MP_ROM_PTR(&mp_sslsocket_getpeercert_obj) },
     { MP_ROM_QSTR(MP_QSTR_compression),     MP_ROM_PTR(&mp_sslsocket_compression_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_channel_binding), MP_ROM_PTR(&mp_sslsocket_get_channel_binding_obj) },
     { MP_ROM_QSTR(MP_QSTR_selected_alpn_protocol), MP_ROM_PTR(&mp_sslsocket_selected_alpn_protocol_obj) },
+    { MP_ROM_QSTR(MP_QSTR_sendmsg),         MP_ROM_PTR(&mp_sslsocket_sendmsg_obj) },
     { MP_ROM_QSTR(MP_QSTR_unwrap),          MP_ROM_PTR(&mp_sslsocket_unwrap_obj) },
     { MP_ROM_QSTR(MP_QSTR_version),         MP_ROM_PTR(&mp_sslsocket_version_obj) },
 };
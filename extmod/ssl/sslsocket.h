@@ -14,8 +14,10 @@ typedef struct {
     int server_side:1;
     int do_handshake:1;
     mp_obj_t server_hostname;
+    // Session offered for resumption, or None
+    mp_obj_t session;
 } mp_obj_sslsocket_t;
 
 extern const mp_obj_type_t mp_type_sslsocket;
 
-mp_obj_t mp_sslsocket_make_new(mp_obj_t sock, mp_obj_sslcontext_t *sslcontext, int flags, mp_obj_t server_hostname);
+mp_obj_t mp_sslsocket_make_new(mp_obj_t sock, mp_obj_sslcontext_t *sslcontext, int flags, mp_obj_t server_hostname, mp_obj_t session);
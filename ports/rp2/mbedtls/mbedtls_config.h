@@ -44,10 +44,11 @@
 #define MBEDTLS_PKCS1_V15
 // #define MBEDTLS_SSL_ALPN
 #define MBEDTLS_SSL_KEEP_PEER_CERTIFICATE
-// #define MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
+#define MBEDTLS_SSL_MAX_FRAGMENT_LENGTH
 #define MBEDTLS_SSL_PROTO_TLS1_2
 #define MBEDTLS_SSL_SERVER_NAME_INDICATION
-// #define MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH
+#define MBEDTLS_SSL_SESSION_TICKETS
+#define MBEDTLS_SSL_VARIABLE_BUFFER_LENGTH
 #define MBEDTLS_X509_TRUSTED_CERTIFICATE_CALLBACK
 
 /* Mbed TLS modules */
@@ -74,9 +75,10 @@
 #define MBEDTLS_SHA256_C
 #define MBEDTLS_SHA384_C
 #define MBEDTLS_SHA512_C
-// #define MBEDTLS_SSL_CACHE_C
+#define MBEDTLS_SSL_CACHE_C
 #define MBEDTLS_SSL_CLI_C
 #define MBEDTLS_SSL_SRV_C
+#define MBEDTLS_SSL_TICKET_C
 #define MBEDTLS_SSL_TLS_C
 // #define MBEDTLS_THREADING_C
 #define MBEDTLS_X509_USE_C
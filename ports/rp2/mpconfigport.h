@@ -129,6 +129,7 @@
 #define MICROPY_EMIT_INLINE_RV32                (1)
 #endif
 #define MICROPY_PERSISTENT_CODE_SAVE            (1)
+#define MICROPY_PERSISTENT_CODE_SAVE_FILE       (MICROPY_MODULE_BYTECODE_CACHE)
 #define MICROPY_COMP_ALLOW_TOP_LEVEL_AWAIT      (1)
 
 // Optimisations
@@ -137,6 +138,10 @@
 // Python internal features
 #define MICROPY_TRACKED_ALLOC                   (MICROPY_BLUETOOTH_BTSTACK)
 #define MICROPY_READER_POSIX                    (1)
+#ifndef MICROPY_MODULE_BYTECODE_CACHE
+// Off by default, because it writes to flash on the first import of each module.
+#define MICROPY_MODULE_BYTECODE_CACHE           (0)
+#endif
 #define MICROPY_ENABLE_GC                       (1)
 #define MICROPY_STACK_CHECK_MARGIN              (256)
 #define MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF  (1)
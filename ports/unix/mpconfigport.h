@@ -73,6 +73,11 @@
     #define MICROPY_EMIT_ARM        (1)
 #endif
 
+// Hash strings 8 bytes at a time on 64-bit hosts.
+#if !defined(MICROPY_QSTR_HASH_WORDWISE) && defined(__LP64__)
+#define MICROPY_QSTR_HASH_WORDWISE  (1)
+#endif
+
 // Cannot include <sys/types.h>, as it may lead to symbol name clashes
 #if _FILE_OFFSET_BITS == 64 && !defined(__LP64__)
 typedef long long mp_off_t;
@@ -171,6 +176,10 @@ void mp_unix_free_exec(void *ptr, size_t size);
 #define MP_PLAT_ALLOC_EXEC(min_size, ptr, size) mp_unix_alloc_exec(min_size, ptr, size)
 #define MP_PLAT_FREE_EXEC(ptr, size) mp_unix_free_exec(ptr, size)
 
+// The sampling profiler is driven by a SIGPROF interval timer, see unix_mphal.c.
+#define MICROPY_PY_MICROPYTHON_PROFILE_TIMER_START(period_ms) mp_hal_profile_timer_start(period_ms)
+#define MICROPY_PY_MICROPYTHON_PROFILE_TIMER_STOP() mp_hal_profile_timer_stop()
+
 // If enabled, configure how to seed random on init.
 #ifdef MICROPY_PY_RANDOM_SEED_INIT_FUNC
 #include <stddef.h>
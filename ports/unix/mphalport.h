@@ -114,6 +114,11 @@ static inline void mp_hal_delay_us(mp_uint_t us) {
 
 void mp_hal_get_random(size_t n, void *buf);
 
+#if MICROPY_PY_MICROPYTHON_PROFILE
+void mp_hal_profile_timer_start(mp_uint_t period_ms);
+void mp_hal_profile_timer_stop(void);
+#endif
+
 #if MICROPY_PY_BLUETOOTH
 enum {
     MP_HAL_MAC_BDADDR,
@@ -259,3 +259,32 @@ void mp_hal_get_random(size_t n, void *buf) {
     close(fd);
     #endif
 }
+
+#if MICROPY_PY_MICROPYTHON_PROFILE
+#include "py/profsample.h"
+
+static void profile_sighandler(int signum) {
+    (void)signum;
+    mp_profile_tick();
+}
+
+// The timer counts CPU time used by the process, so time spent blocked isn't sampled.
+void mp_hal_profile_timer_start(mp_uint_t period_ms) {
+    struct sigaction sa;
+    sa.sa_flags = SA_RESTART;
+    sa.sa_handler = profile_sighandler;
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGPROF, &sa, NULL);
+    struct itimerval it;
+    it.it_interval.tv_sec = period_ms / 1000;
+    it.it_interval.tv_usec = period_ms % 1000 * 1000;
+    it.it_value = it.it_interval;
+    RAISE_ERRNO(setitimer(ITIMER_PROF, &it, NULL), errno);
+}
+
+void mp_hal_profile_timer_stop(void) {
+    struct itimerval it;
+    memset(&it, 0, sizeof(it));
+    setitimer(ITIMER_PROF, &it, NULL);
+}
+#endif
@@ -69,8 +69,9 @@
 #define MICROPY_ENABLE_EMERGENCY_EXCEPTION_BUF (1)
 #define MICROPY_EMERGENCY_EXCEPTION_BUF_SIZE (256)
 
-// Allow loading of .mpy files.
+// Allow loading of .mpy files, using their data in place from memory-mapped files.
 #define MICROPY_PERSISTENT_CODE_LOAD   (1)
+#define MICROPY_PERSISTENT_CODE_LOAD_MMAP (1)
 
 // Extra memory debugging.
 #define MICROPY_MALLOC_USES_ALLOCATED_SIZE (1)
@@ -0,0 +1,265 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/allocprof.h"
+#include "py/bc.h"
+#include "py/gc.h"
+#include "py/objfun.h"
+#include "py/runtime.h"
+
+#if MICROPY_PY_MICROPYTHON_ALLOC_PROFILE
+
+typedef struct _mp_alloc_profile_site_t {
+    // Bytecode function and offset that made the allocation, or NULL if no bytecode was running.
+    const struct _mp_obj_fun_bc_t *fun_bc;
+    size_t offset;
+    // Type of the allocated object, or NULL if it is not an object.
+    const mp_obj_type_t *type;
+    size_t bytes;
+    size_t count;
+    // Number of tracked samples that survived the last collection
+    size_t live;
+} mp_alloc_profile_site_t;
+
+typedef struct _mp_alloc_profile_track_t {
+    // Inverted pointer to the sampled block, so the GC doesn't see it as a reference, or 0 if free.
+    uintptr_t ptr;
+    size_t site;
+} mp_alloc_profile_track_t;
+
+// Number of bits in the filter of tracked pointers
+#define ALLOC_PROFILE_FILTER_BITS (256)
+
+typedef struct _mp_alloc_profile_t {
+    bool active;
+    size_t interval;
+    // Bytes to allocate until the next sample
+    size_t countdown;
+    size_t samples;
+    // Samples that didn't fit in the site table
+    size_t dropped;
+    size_t n_sites;
+    size_t n_used_sites;
+    mp_alloc_profile_site_t *sites;
+    size_t n_track;
+    // Index of the next entry to write in the tracking ring buffer
+    size_t track_head;
+    mp_alloc_profile_track_t *track;
+    // A bit is set for the hash of each tracked pointer, so freeing a block that isn't
+    // tracked (most of them) doesn't need to search the ring buffer. Bits of entries
+    // that have been freed or overwritten stay set until the next collection.
+    uint32_t filter[ALLOC_PROFILE_FILTER_BITS / 32];
+    // Most recent sample, which is recorded once the object allocator has set its type (if any).
+    struct {
+        uintptr_t ptr;
+        size_t n_bytes;
+        const struct _mp_obj_fun_bc_t *fun_bc;
+        size_t offset;
+    } pending;
+} mp_alloc_profile_t;
+
+void mp_alloc_profile_start(size_t interval, size_t n_sites, size_t n_track) {
+    if ((interval == 0) || (n_sites == 0) || (n_track == 0)
+        || (n_sites > SIZE_MAX / sizeof(mp_alloc_profile_site_t))
+        || (n_track > SIZE_MAX / sizeof(mp_alloc_profile_track_t))) {
+        mp_raise_ValueError(NULL);
+    }
+    mp_alloc_profile_stop();
+    MP_STATE_VM(alloc_profile) = NULL;
+    mp_alloc_profile_t *profile = m_new0(mp_alloc_profile_t, 1);
+    profile->sites = m_new0(mp_alloc_profile_site_t, n_sites);
+    profile->track = m_new0(mp_alloc_profile_track_t, n_track);
+    profile->interval = interval;
+    profile->countdown = interval;
+    profile->n_sites = n_sites;
+    profile->n_track = n_track;
+    profile->active = true;
+    MP_STATE_VM(alloc_profile) = profile;
+}
+
+void mp_alloc_profile_stop(void) {
+    mp_alloc_profile_t *profile = MP_STATE_VM(alloc_profile);
+    if (profile) {
+        profile->active = false;
+    }
+}
+
+static size_t mp_alloc_profile_hash(uintptr_t ptr) {
+    return (~ptr / MICROPY_BYTES_PER_GC_BLOCK) % ALLOC_PROFILE_FILTER_BITS;
+}
+
+static void mp_alloc_profile_filter_add(mp_alloc_profile_t *profile, uintptr_t ptr) {
+    size_t hash = mp_alloc_profile_hash(ptr);
+    profile->filter[hash / 32] |= 1u << (hash % 32);
+}
+
+static bool mp_alloc_profile_site_match(const mp_alloc_profile_site_t *site, const struct _mp_obj_fun_bc_t *fun_bc, size_t offset, const mp_obj_type_t *type) {
+    if ((site->type != type) || (site->offset != offset)) {
+        return false;
+    }
+    if (!site->fun_bc || !fun_bc) {
+        return site->fun_bc == fun_bc;
+    }
+    // Closures of the same definition share their bytecode.
+    return site->fun_bc->bytecode == fun_bc->bytecode;
+}
+
+static void mp_alloc_profile_commit(mp_alloc_profile_t *profile, const mp_obj_type_t *type) {
+    if (!profile->pending.ptr) {
+        return;
+    }
+    size_t index = 0;
+    while ((index < profile->n_used_sites) && !mp_alloc_profile_site_match(&profile->sites[index], profile->pending.fun_bc, profile->pending.offset, type)) {
+        index++;
+    }
+    if (index == profile->n_used_sites) {
+        if (index == profile->n_sites) {
+            profile->dropped++;
+            profile->pending.ptr = 0;
+            return;
+        }
+        mp_alloc_profile_site_t *site = &profile->sites[index];
+        site->fun_bc = profile->pending.fun_bc;
+        site->offset = profile->pending.offset;
+        site->type = type;
+        profile->n_used_sites++;
+    }
+    mp_alloc_profile_site_t *site = &profile->sites[index];
+    site->bytes += profile->pending.n_bytes;
+    site->count++;
+
+    mp_alloc_profile_track_t *track = &profile->track[profile->track_head];
+    track->ptr = profile->pending.ptr;
+    track->site = index;
+    mp_alloc_profile_filter_add(profile, track->ptr);
+    profile->track_head = (profile->track_head + 1) % profile->n_track;
+    profile->pending.ptr = 0;
+}
+
+void mp_alloc_profile_record_alloc(void *ptr, size_t n_bytes) {
+    mp_alloc_profile_t *profile = MP_STATE_VM(alloc_profile);
+    mp_alloc_profile_commit(profile, NULL);
+    if (!profile->active) {
+        return;
+    }
+    if (n_bytes < profile->countdown) {
+        profile->countdown -= n_bytes;
+        return;
+    }
+    profile->countdown = profile->interval;
+    profile->samples++;
+
+    const mp_code_state_t *code_state = MP_STATE_THREAD(current_code_state);
+    profile->pending.ptr = ~(uintptr_t)ptr;
+    profile->pending.n_bytes = n_bytes;
+    profile->pending.fun_bc = code_state ? code_state->fun_bc : NULL;
+    profile->pending.offset = code_state ? (size_t)(code_state->ip - code_state->fun_bc->bytecode) : 0;
+}
+
+void mp_alloc_profile_record_type(void *ptr, const mp_obj_type_t *type) {
+    mp_alloc_profile_t *profile = MP_STATE_VM(alloc_profile);
+    if (profile->pending.ptr == ~(uintptr_t)ptr) {
+        mp_alloc_profile_commit(profile, type);
+    }
+}
+
+void mp_alloc_profile_record_free(void *ptr) {
+    mp_alloc_profile_t *profile = MP_STATE_VM(alloc_profile);
+    mp_alloc_profile_commit(profile, NULL);
+    uintptr_t inv_ptr = ~(uintptr_t)ptr;
+    size_t hash = mp_alloc_profile_hash(inv_ptr);
+    if (!(profile->filter[hash / 32] & (1u << (hash % 32)))) {
+        return;
+    }
+    // A block is tracked at most once, as its entry is cleared when it's freed.
+    for (size_t i = 0; i < profile->n_track; i++) {
+        if (profile->track[i].ptr == inv_ptr) {
+            profile->track[i].ptr = 0;
+            break;
+        }
+    }
+}
+
+void mp_alloc_profile_record_collect(void) {
+    mp_alloc_profile_t *profile = MP_STATE_VM(alloc_profile);
+    mp_alloc_profile_commit(profile, NULL);
+    for (size_t i = 0; i < profile->n_used_sites; i++) {
+        profile->sites[i].live = 0;
+    }
+    memset(profile->filter, 0, sizeof(profile->filter));
+    for (size_t i = 0; i < profile->n_track; i++) {
+        mp_alloc_profile_track_t *track = &profile->track[i];
+        if (!track->ptr) {
+            continue;
+        }
+        if (gc_nbytes((void *)~track->ptr)) {
+            profile->sites[track->site].live++;
+            mp_alloc_profile_filter_add(profile, track->ptr);
+        } else {
+            track->ptr = 0;
+        }
+    }
+}
+
+static void mp_alloc_profile_print_site(const mp_print_t *print, const mp_alloc_profile_site_t *site) {
+    mp_printf(print, "%u %u %u ", (uint)site->bytes, (uint)site->count, (uint)site->live);
+    if (site->type) {
+        mp_printf(print, "%q ", (qstr)site->type->name);
+    } else {
+        mp_print_str(print, "- ");
+    }
+    if (site->fun_bc) {
+        qstr block_name;
+        qstr source_file;
+        size_t source_line = mp_bytecode_get_location(site->fun_bc, site->fun_bc->bytecode + site->offset, &block_name, &source_file);
+        mp_printf(print, "%q (%q:%u)\n", block_name, source_file, (uint)source_line);
+    } else {
+        mp_print_str(print, "-\n");
+    }
+}
+
+void mp_alloc_profile_dump(const mp_print_t *print) {
+    mp_alloc_profile_t *profile = MP_STATE_VM(alloc_profile);
+    if (!profile) {
+        return;
+    }
+    // Don't sample the allocations made while printing.
+    bool active = profile->active;
+    profile->active = false;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_alloc_profile_commit(profile, NULL);
+        mp_printf(print, "# interval=%u samples=%u dropped=%u\n", (uint)profile->interval, (uint)profile->samples, (uint)profile->dropped);
+        mp_print_str(print, "# bytes count live type location\n");
+        // Print the sites in decreasing order of bytes, then of index.
+        size_t prev = profile->n_used_sites;
+        for (size_t n = 0; n < profile->n_used_sites; n++) {
+            size_t best = profile->n_used_sites;
+            for (size_t i = 0; i < profile->n_used_sites; i++) {
+                const mp_alloc_profile_site_t *site = &profile->sites[i];
+                if ((prev < profile->n_used_sites) && ((site->bytes > profile->sites[prev].bytes) || ((site->bytes == profile->sites[prev].bytes) && (i <= prev)))) {
+                    continue;
+                }
+                if ((best == profile->n_used_sites) || (site->bytes > profile->sites[best].bytes)) {
+                    best = i;
+                }
+            }
+            if (best == profile->n_used_sites) {
+                break;
+            }
+            mp_alloc_profile_print_site(print, &profile->sites[best]);
+            prev = best;
+        }
+        nlr_pop();
+        profile->active = active;
+    } else {
+        profile->active = active;
+        nlr_jump(nlr.ret_val);
+    }
+}
+
+MP_REGISTER_ROOT_POINTER(struct _mp_alloc_profile_t *alloc_profile);
+
+#endif // MICROPY_PY_MICROPYTHON_ALLOC_PROFILE
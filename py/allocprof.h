@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/mpprint.h"
+#include "py/mpstate.h"
+#include "py/obj.h"
+
+#if MICROPY_PY_MICROPYTHON_ALLOC_PROFILE
+
+// Starts sampling heap allocations, one every interval bytes, attributing them to at most n_sites distinct
+// allocation sites and following the survival of the most recent n_track samples across collections.
+void mp_alloc_profile_start(size_t interval, size_t n_sites, size_t n_track);
+
+// Stops sampling. Samples are kept, and still followed across collections, until the next start.
+void mp_alloc_profile_stop(void);
+
+// Prints one line per allocation site, with the most bytes allocated first.
+void mp_alloc_profile_dump(const mp_print_t *print);
+
+void mp_alloc_profile_record_alloc(void *ptr, size_t n_bytes);
+void mp_alloc_profile_record_type(void *ptr, const mp_obj_type_t *type);
+void mp_alloc_profile_record_free(void *ptr);
+void mp_alloc_profile_record_collect(void);
+
+// Hooks called by the GC and the object allocator.
+static inline void mp_alloc_profile_alloc(void *ptr, size_t n_bytes) {
+    if (MP_STATE_VM(alloc_profile)) {
+        mp_alloc_profile_record_alloc(ptr, n_bytes);
+    }
+}
+
+static inline void mp_alloc_profile_set_type(void *ptr, const mp_obj_type_t *type) {
+    if (MP_STATE_VM(alloc_profile)) {
+        mp_alloc_profile_record_type(ptr, type);
+    }
+}
+
+static inline void mp_alloc_profile_free(void *ptr) {
+    if (MP_STATE_VM(alloc_profile)) {
+        mp_alloc_profile_record_free(ptr);
+    }
+}
+
+static inline void mp_alloc_profile_collect(void) {
+    if (MP_STATE_VM(alloc_profile)) {
+        mp_alloc_profile_record_collect();
+    }
+}
+
+#endif
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/arena.h"
+
+#define ARENA_ROUND(num_bytes) (((num_bytes) + sizeof(mp_uint_t) - 1) & ~(sizeof(mp_uint_t) - 1))
+
+void mp_arena_init(mp_arena_t *arena, size_t chunk_size) {
+    arena->chunk = NULL;
+    arena->chunk_size = chunk_size;
+}
+
+void mp_arena_free_all(mp_arena_t *arena) {
+    mp_arena_chunk_t *chunk = arena->chunk;
+    while (chunk != NULL) {
+        mp_arena_chunk_t *next = chunk->next;
+        m_del(byte, chunk, sizeof(mp_arena_chunk_t) + chunk->alloc);
+        chunk = next;
+    }
+    arena->chunk = NULL; // Avoid dangling pointer that may live on stack
+}
+
+void *mp_arena_alloc(mp_arena_t *arena, size_t num_bytes) {
+    num_bytes = ARENA_ROUND(num_bytes);
+    mp_arena_chunk_t *chunk = arena->chunk;
+
+    if (chunk != NULL && chunk->used + num_bytes > chunk->alloc) {
+        // Not enough room at the end of the current chunk, so try to grow it in place.
+        if (m_renew_maybe(byte, chunk, sizeof(mp_arena_chunk_t) + chunk->alloc,
+            sizeof(mp_arena_chunk_t) + chunk->alloc + num_bytes, false) != NULL) {
+            chunk->alloc += num_bytes;
+        } else {
+            // Could not grow the chunk, so shrink it to fit and start a new one.
+            (void)m_renew_maybe(byte, chunk, sizeof(mp_arena_chunk_t) + chunk->alloc,
+                sizeof(mp_arena_chunk_t) + chunk->used, false);
+            chunk->alloc = chunk->used;
+            chunk = NULL;
+        }
+    }
+
+    if (chunk == NULL) {
+        size_t alloc = MAX(arena->chunk_size, num_bytes);
+        chunk = (mp_arena_chunk_t *)m_new(byte, sizeof(mp_arena_chunk_t) + alloc);
+        chunk->next = arena->chunk;
+        chunk->alloc = alloc;
+        chunk->used = 0;
+        arena->chunk = chunk;
+    }
+
+    byte *ret = chunk->data + chunk->used;
+    chunk->used += num_bytes;
+    return ret;
+}
+
+void *mp_arena_alloc0(mp_arena_t *arena, size_t num_bytes) {
+    void *ptr = mp_arena_alloc(arena, num_bytes);
+    memset(ptr, 0, num_bytes);
+    return ptr;
+}
+
+static bool mp_arena_is_last(mp_arena_t *arena, void *ptr, size_t num_bytes) {
+    mp_arena_chunk_t *chunk = arena->chunk;
+    return chunk != NULL && (byte *)ptr + num_bytes == chunk->data + chunk->used;
+}
+
+void *mp_arena_realloc(mp_arena_t *arena, void *ptr, size_t old_num_bytes, size_t new_num_bytes) {
+    old_num_bytes = ARENA_ROUND(old_num_bytes);
+    new_num_bytes = ARENA_ROUND(new_num_bytes);
+    if (ptr != NULL && mp_arena_is_last(arena, ptr, old_num_bytes)) {
+        mp_arena_chunk_t *chunk = arena->chunk;
+        if (chunk->used - old_num_bytes + new_num_bytes <= chunk->alloc) {
+            chunk->used = chunk->used - old_num_bytes + new_num_bytes;
+            return ptr;
+        }
+    }
+    // The old memory is not reclaimed until the whole arena is freed.
+    void *new_ptr = mp_arena_alloc(arena, new_num_bytes);
+    if (ptr != NULL) {
+        memcpy(new_ptr, ptr, MIN(old_num_bytes, new_num_bytes));
+    }
+    return new_ptr;
+}
+
+void mp_arena_free(mp_arena_t *arena, void *ptr, size_t num_bytes) {
+    num_bytes = ARENA_ROUND(num_bytes);
+    if (mp_arena_is_last(arena, ptr, num_bytes)) {
+        arena->chunk->used -= num_bytes;
+    }
+}
@@ -0,0 +1,40 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/misc.h"
+
+// A bump allocator for many small allocations that share a lifetime, such as
+// the parse tree and the compiler's scratch data. Memory is carved out of
+// large chunks of heap, and is only released all at once by mp_arena_free_all.
+
+typedef struct _mp_arena_chunk_t {
+    struct _mp_arena_chunk_t *next;
+    size_t alloc;
+    size_t used;
+    byte data[];
+} mp_arena_chunk_t;
+
+typedef struct _mp_arena_t {
+    // Chunk that new allocations come from, followed by the earlier chunks.
+    mp_arena_chunk_t *chunk;
+    size_t chunk_size;
+} mp_arena_t;
+
+void mp_arena_init(mp_arena_t *arena, size_t chunk_size);
+void mp_arena_free_all(mp_arena_t *arena);
+
+// Returns uninitialised memory, rounded up to a multiple of the word size.
+void *mp_arena_alloc(mp_arena_t *arena, size_t num_bytes);
+void *mp_arena_alloc0(mp_arena_t *arena, size_t num_bytes);
+
+// Grows the given allocation, in place if it was the most recent one.
+void *mp_arena_realloc(mp_arena_t *arena, void *ptr, size_t old_num_bytes, size_t new_num_bytes);
+
+// Returns memory to the arena if it was the most recent allocation, otherwise does nothing.
+void mp_arena_free(mp_arena_t *arena, void *ptr, size_t num_bytes);
+
+#define mp_arena_new(arena, type, num) ((type *)mp_arena_alloc((arena), sizeof(type) * (num)))
+#define mp_arena_new0(arena, type, num) ((type *)mp_arena_alloc0((arena), sizeof(type) * (num)))
+#define mp_arena_renew(arena, type, ptr, old_num, new_num) ((type *)mp_arena_realloc((arena), (ptr), sizeof(type) * (old_num), sizeof(type) * (new_num)))
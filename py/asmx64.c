@@ -639,4 +639,82 @@ void asm_x64_call_ind(asm_x64_t *as, size_t fun_id, int temp_r64) {
     asm_x64_write_byte_2(as, OPCODE_CALL_RM32, MODRM_R64(2) | MODRM_RM_REG | MODRM_RM_R64(temp_r64));
 }
 
+#if MICROPY_EMIT_NATIVE_FLOAT
+
+#define OPCODE_MOVQ_R64_TO_XMM  (0x6e) /* 0x66 0x0f 0x6e /r */
+#define OPCODE_MOVQ_XMM_TO_R64  (0x7e) /* 0x66 0x0f 0x7e /r */
+#define OPCODE_CVTSI2SD         (0x2a) /* 0xf2 0x0f 0x2a /r */
+#define OPCODE_CVTTSD2SI        (0x2c) /* 0xf2 0x0f 0x2c /r */
+#define OPCODE_CMPSD            (0xc2) /* 0xf2 0x0f 0xc2 /r ib */
+#define OPCODE_BTC_RM64_I8      (0xba) /* 0x0f 0xba /7 ib */
+#define OPCODE_AND_I8_TO_RM32   (0x83) /* /4 */
+
+#define ASM_X64_REG_XMM0 (0)
+#define ASM_X64_REG_XMM1 (1)
+
+#if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE
+#define SSE_PREFIX_SCALAR (0xf2) // selects the sd variant of an instruction
+#define REX_W_FLOAT (REX_W) // movq
+#define FLOAT_SIGN_BIT (63)
+#else
+#define SSE_PREFIX_SCALAR (0xf3) // selects the ss variant of an instruction
+#define REX_W_FLOAT (0) // movd
+#define FLOAT_SIGN_BIT (31)
+#endif
+
+static void asm_x64_mov_r64_to_xmm(asm_x64_t *as, int dest_xmm, int src_r64) {
+    asm_x64_write_byte_1(as, OP_SIZE_PREFIX);
+    asm_x64_write_byte_3(as, REX_PREFIX | REX_W_FLOAT | REX_B_FROM_R64(src_r64), 0x0f, OPCODE_MOVQ_R64_TO_XMM);
+    asm_x64_write_byte_1(as, MODRM_R64(dest_xmm) | MODRM_RM_REG | MODRM_RM_R64(src_r64));
+}
+
+static void asm_x64_mov_xmm_to_r64(asm_x64_t *as, int dest_r64, int src_xmm) {
+    asm_x64_write_byte_1(as, OP_SIZE_PREFIX);
+    asm_x64_write_byte_3(as, REX_PREFIX | REX_W_FLOAT | REX_B_FROM_R64(dest_r64), 0x0f, OPCODE_MOVQ_XMM_TO_R64);
+    asm_x64_write_byte_1(as, MODRM_R64(src_xmm) | MODRM_RM_REG | MODRM_RM_R64(dest_r64));
+}
+
+void asm_x64_float_op_r64_r64(asm_x64_t *as, int op, int dest_r64, int src_r64) {
+    asm_x64_mov_r64_to_xmm(as, ASM_X64_REG_XMM0, dest_r64);
+    asm_x64_mov_r64_to_xmm(as, ASM_X64_REG_XMM1, src_r64);
+    asm_x64_write_byte_2(as, SSE_PREFIX_SCALAR, 0x0f);
+    asm_x64_write_byte_2(as, op, MODRM_R64(ASM_X64_REG_XMM0) | MODRM_RM_REG | MODRM_RM_R64(ASM_X64_REG_XMM1));
+    asm_x64_mov_xmm_to_r64(as, dest_r64, ASM_X64_REG_XMM0);
+}
+
+void asm_x64_float_cmp_r64_r64(asm_x64_t *as, int cmp, int dest_r64, int src_r64_a, int src_r64_b) {
+    asm_x64_mov_r64_to_xmm(as, ASM_X64_REG_XMM0, src_r64_a);
+    asm_x64_mov_r64_to_xmm(as, ASM_X64_REG_XMM1, src_r64_b);
+    asm_x64_write_byte_3(as, SSE_PREFIX_SCALAR, 0x0f, OPCODE_CMPSD);
+    asm_x64_write_byte_2(as, MODRM_R64(ASM_X64_REG_XMM0) | MODRM_RM_REG | MODRM_RM_R64(ASM_X64_REG_XMM1), cmp);
+    asm_x64_mov_xmm_to_r64(as, dest_r64, ASM_X64_REG_XMM0);
+    // the comparison yields an all-ones mask for true, reduce it to 0 or 1
+    if (dest_r64 >= 8) {
+        asm_x64_write_byte_1(as, REX_PREFIX | REX_B);
+    }
+    asm_x64_write_byte_3(as, OPCODE_AND_I8_TO_RM32, MODRM_R64(4) | MODRM_RM_REG | MODRM_RM_R64(dest_r64), 1);
+}
+
+void asm_x64_float_from_int_r64(asm_x64_t *as, int dest_r64, int src_r64) {
+    asm_x64_write_byte_1(as, SSE_PREFIX_SCALAR);
+    asm_x64_write_byte_3(as, REX_PREFIX | REX_W | REX_B_FROM_R64(src_r64), 0x0f, OPCODE_CVTSI2SD);
+    asm_x64_write_byte_1(as, MODRM_R64(ASM_X64_REG_XMM0) | MODRM_RM_REG | MODRM_RM_R64(src_r64));
+    asm_x64_mov_xmm_to_r64(as, dest_r64, ASM_X64_REG_XMM0);
+}
+
+void asm_x64_float_to_int_r64(asm_x64_t *as, int dest_r64, int src_r64) {
+    asm_x64_mov_r64_to_xmm(as, ASM_X64_REG_XMM0, src_r64);
+    asm_x64_write_byte_1(as, SSE_PREFIX_SCALAR);
+    asm_x64_write_byte_3(as, REX_PREFIX | REX_W | REX_R_FROM_R64(dest_r64), 0x0f, OPCODE_CVTTSD2SI);
+    asm_x64_write_byte_1(as, MODRM_R64(dest_r64) | MODRM_RM_REG | MODRM_RM_R64(ASM_X64_REG_XMM0));
+}
+
+void asm_x64_float_neg_r64(asm_x64_t *as, int dest_r64) {
+    // flip the sign bit in place
+    asm_x64_write_byte_3(as, REX_PREFIX | REX_W_FLOAT | REX_B_FROM_R64(dest_r64), 0x0f, OPCODE_BTC_RM64_I8);
+    asm_x64_write_byte_2(as, MODRM_R64(7) | MODRM_RM_REG | MODRM_RM_R64(dest_r64), FLOAT_SIGN_BIT);
+}
+
+#endif // MICROPY_EMIT_NATIVE_FLOAT
+
 #endif // MICROPY_EMIT_X64
@@ -73,6 +73,20 @@
 #define ASM_X64_CC_JLE (0xe) // less or equal, signed
 #define ASM_X64_CC_JG  (0xf) // greater, signed
 
+#if MICROPY_EMIT_NATIVE_FLOAT
+// scalar SSE2 floating point operations, the low byte of the opcode
+#define ASM_X64_FLOAT_OP_ADD (0x58)
+#define ASM_X64_FLOAT_OP_MUL (0x59)
+#define ASM_X64_FLOAT_OP_SUB (0x5c)
+#define ASM_X64_FLOAT_OP_DIV (0x5e)
+
+// predicates for cmpsd/cmpss; all are false for NaN except NE, as per Python
+#define ASM_X64_FLOAT_CMP_EQ (0)
+#define ASM_X64_FLOAT_CMP_LT (1)
+#define ASM_X64_FLOAT_CMP_LE (2)
+#define ASM_X64_FLOAT_CMP_NE (4)
+#endif
+
 typedef struct _asm_x64_t {
     mp_asm_base_t base;
     int num_locals;
@@ -123,6 +137,16 @@ void asm_x64_mov_local_addr_to_r64(asm_x64_t *as, int local_num, int dest_r64);
 void asm_x64_mov_reg_pcrel(asm_x64_t *as, int dest_r64, mp_uint_t label);
 void asm_x64_call_ind(asm_x64_t *as, size_t fun_id, int temp_r32);
 
+#if MICROPY_EMIT_NATIVE_FLOAT
+// Floats are held as the bits of an mp_float_t in general purpose registers;
+// these functions move them through xmm0/xmm1 to operate on them.
+void asm_x64_float_op_r64_r64(asm_x64_t *as, int op, int dest_r64, int src_r64);
+void asm_x64_float_cmp_r64_r64(asm_x64_t *as, int cmp, int dest_r64, int src_r64_a, int src_r64_b);
+void asm_x64_float_from_int_r64(asm_x64_t *as, int dest_r64, int src_r64);
+void asm_x64_float_to_int_r64(asm_x64_t *as, int dest_r64, int src_r64);
+void asm_x64_float_neg_r64(asm_x64_t *as, int dest_r64);
+#endif
+
 // Holds a pointer to mp_fun_table
 #define ASM_X64_REG_FUN_TABLE ASM_X64_REG_RBP
 
@@ -221,6 +245,23 @@ void asm_x64_call_ind(asm_x64_t *as, size_t fun_id, int temp_r32);
 #define ASM_STORE32_REG_REG(as, reg_src, reg_base) ASM_STORE32_REG_REG_OFFSET((as), (reg_src), (reg_base), 0)
 #define ASM_STORE32_REG_REG_OFFSET(as, reg_src, reg_base, dword_offset) asm_x64_mov_r32_to_mem32((as), (reg_src), (reg_base), 4 * (dword_offset))
 
+#if MICROPY_EMIT_NATIVE_FLOAT
+#define ASM_FLOAT_OP_ADD ASM_X64_FLOAT_OP_ADD
+#define ASM_FLOAT_OP_SUB ASM_X64_FLOAT_OP_SUB
+#define ASM_FLOAT_OP_MUL ASM_X64_FLOAT_OP_MUL
+#define ASM_FLOAT_OP_DIV ASM_X64_FLOAT_OP_DIV
+#define ASM_FLOAT_CMP_EQ ASM_X64_FLOAT_CMP_EQ
+#define ASM_FLOAT_CMP_LT ASM_X64_FLOAT_CMP_LT
+#define ASM_FLOAT_CMP_LE ASM_X64_FLOAT_CMP_LE
+#define ASM_FLOAT_CMP_NE ASM_X64_FLOAT_CMP_NE
+
+#define ASM_FLOAT_OP_REG_REG(as, op, reg_dest, reg_src) asm_x64_float_op_r64_r64((as), (op), (reg_dest), (reg_src))
+#define ASM_FLOAT_CMP_REG_REG(as, cmp, reg_dest, reg_a, reg_b) asm_x64_float_cmp_r64_r64((as), (cmp), (reg_dest), (reg_a), (reg_b))
+#define ASM_FLOAT_FROM_INT_REG(as, reg_dest, reg_src) asm_x64_float_from_int_r64((as), (reg_dest), (reg_src))
+#define ASM_FLOAT_TO_INT_REG(as, reg_dest, reg_src) asm_x64_float_to_int_r64((as), (reg_dest), (reg_src))
+#define ASM_FLOAT_NEG_REG(as, reg) asm_x64_float_neg_r64((as), (reg))
+#endif
+
 #endif // GENERIC_ASM_API
 
 #endif // MICROPY_INCLUDED_PY_ASMX64_H
@@ -88,6 +88,32 @@ const byte *mp_decode_uint_skip(const byte *ptr) {
     return ptr;
 }
 
+size_t mp_bytecode_get_location(const mp_obj_fun_bc_t *fun_bc, const byte *ip, qstr *block_name, qstr *source_file) {
+    const byte *prelude = fun_bc->bytecode;
+    MP_BC_PRELUDE_SIG_DECODE(prelude);
+    MP_BC_PRELUDE_SIZE_DECODE(prelude);
+    const byte *line_info_top = prelude + n_info;
+    const byte *bytecode_start = prelude + n_info + n_cell;
+    qstr name = mp_decode_uint_value(prelude);
+    for (size_t i = 0; i < 1 + n_pos_args + n_kwonly_args; ++i) {
+        prelude = mp_decode_uint_skip(prelude);
+    }
+    #if MICROPY_EMIT_BYTECODE_USES_QSTR_TABLE
+    name = fun_bc->context->constants.qstr_table[name];
+    qstr file = fun_bc->context->constants.qstr_table[0];
+    #else
+    qstr file = fun_bc->context->constants.source_file;
+    #endif
+    if (block_name) {
+        *block_name = name;
+    }
+    if (source_file) {
+        *source_file = file;
+    }
+    size_t bc = ip ? (size_t)(ip - bytecode_start) : 0;
+    return mp_bytecode_get_source_line(prelude, line_info_top, bc);
+}
+
 static MP_NORETURN void fun_pos_args_mismatch(mp_obj_fun_bc_t *f, size_t expected, size_t given) {
     #if MICROPY_ERROR_REPORTING <= MICROPY_ERROR_REPORTING_TERSE
     // generic message, used also for other argument issues
@@ -325,8 +351,10 @@ void mp_setup_code_state(mp_code_state_t *code_state, size_t n_args, size_t n_kw
     #if MICROPY_STACKLESS
     code_state->prev = NULL;
     #endif
-    #if MICROPY_PY_SYS_SETTRACE
+    #if MICROPY_TRACK_CODE_STATE
     code_state->prev_state = NULL;
+    #endif
+    #if MICROPY_PY_SYS_SETTRACE
     code_state->frame = NULL;
     #endif
     mp_setup_code_state_helper(code_state, n_args, n_kw, args);
@@ -196,6 +196,205 @@ static void do_execute_proto_fun(const mp_module_context_t *context, mp_proto_fu
 }
 #endif
 
+#if MICROPY_MODULE_BYTECODE_CACHE
+
+#if !MICROPY_ENABLE_COMPILER || !MICROPY_PERSISTENT_CODE_LOAD || !MICROPY_PERSISTENT_CODE_SAVE || !MICROPY_PERSISTENT_CODE_SAVE_FILE || !MICROPY_READER_POSIX
+#error MICROPY_MODULE_BYTECODE_CACHE requires the compiler, POSIX reader and persistent code load and save
+#endif
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if MICROPY_PERSISTENT_CODE_LOAD_MMAP
+#include <sys/mman.h>
+#endif
+
+// Name of the directory, next to the source file, that holds its cached bytecode.
+#define MP_BYTECODE_CACHE_DIR "__pycache__"
+
+// Header that precedes the .mpy data in a cache file. A cache file is only
+// used if its header is identical to the one computed for the current source.
+// The reserved field makes the layout the same on all ABIs, 24 bytes.
+typedef struct _mp_bytecode_cache_header_t {
+    byte magic[4];
+    uint32_t opt_level;
+    uint32_t source_size;
+    uint32_t reserved;
+    int64_t source_mtime;
+} mp_bytecode_cache_header_t;
+
+// Given "dir/name.py", set cache_dir to "dir/__pycache__" and cache_file to
+// "dir/__pycache__/name.mpy".
+static void bytecode_cache_paths(vstr_t *file, vstr_t *cache_dir, vstr_t *cache_file) {
+    const char *file_str = vstr_str(file);
+    size_t dir_len = file->len;
+    while (dir_len > 0 && file_str[dir_len - 1] != PATH_SEP_CHAR[0]) {
+        --dir_len;
+    }
+    vstr_add_strn(cache_dir, file_str, dir_len);
+    vstr_add_str(cache_dir, MP_BYTECODE_CACHE_DIR);
+    vstr_add_strn(cache_file, vstr_str(cache_dir), cache_dir->len);
+    vstr_add_char(cache_file, PATH_SEP_CHAR[0]);
+    vstr_add_strn(cache_file, file_str + dir_len, file->len - dir_len - 3);
+    vstr_add_str(cache_file, ".mpy");
+}
+
+// Try to load cm from the cache file. Returns false if the file doesn't exist,
+// is out of date, or can't be loaded by this firmware.
+static bool bytecode_cache_load(mp_compiled_module_t *cm, vstr_t *cache_file, const mp_bytecode_cache_header_t *expected) {
+    mp_bytecode_cache_header_t header;
+    MP_THREAD_GIL_EXIT();
+    int fd = open(vstr_null_terminated_str(cache_file), O_RDONLY);
+    bool valid = (fd >= 0)
+        && (read(fd, &header, sizeof(header)) == sizeof(header))
+        && (memcmp(&header, expected, sizeof(header)) == 0);
+    if (!valid && (fd >= 0)) {
+        close(fd);
+    }
+    #if MICROPY_PERSISTENT_CODE_LOAD_MMAP
+    // Map the file, like mp_raw_code_load_file does, so the code is used in
+    // place. The cache file is only ever replaced with rename(), so the
+    // mapping stays valid when the cache is rewritten.
+    struct stat st;
+    void *data = MAP_FAILED;
+    if (valid && (fstat(fd, &st) == 0) && ((size_t)st.st_size > sizeof(header))) {
+        data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            close(fd);
+        }
+    }
+    #endif
+    MP_THREAD_GIL_ENTER();
+    if (!valid) {
+        return false;
+    }
+
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        mp_reader_t reader;
+        #if MICROPY_PERSISTENT_CODE_LOAD_MMAP
+        if (data != MAP_FAILED) {
+            mp_reader_new_mem(&reader, (const byte *)data + sizeof(header), st.st_size - sizeof(header), MP_READER_IS_ROM);
+        } else
+        #endif
+        {
+            mp_reader_new_file_from_fd(&reader, fd, true);
+        }
+        mp_raw_code_load(&reader, cm);
+        nlr_pop();
+        return true;
+    }
+    // Fall back to the source if the cache file is unreadable or incompatible,
+    // e.g. because it was written by a different firmware version.
+    if (!mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(((mp_obj_base_t *)nlr.ret_val)->type), MP_OBJ_FROM_PTR(&mp_type_Exception))) {
+        nlr_jump(nlr.ret_val);
+    }
+    return false;
+}
+
+// Save cm to the cache file, ignoring any errors. The data is written to a
+// temporary file in the same directory which is then renamed over the cache
+// file, so that a concurrent importer (or one that has the old cache file
+// mapped into memory) never sees a partially written or truncated file. The
+// temporary file is named after the process and the calling thread's stack so
+// that concurrent writers don't share it. On any error it is removed.
+static void bytecode_cache_save(mp_compiled_module_t *cm, vstr_t *cache_dir, vstr_t *cache_file, const mp_bytecode_cache_header_t *header) {
+    const char *cache_file_str = vstr_null_terminated_str(cache_file);
+    vstr_t tmp_file;
+    vstr_init(&tmp_file, cache_file->len + 24);
+    vstr_add_strn(&tmp_file, cache_file_str, cache_file->len);
+    vstr_printf(&tmp_file, ".%u.%x.tmp", (unsigned)getpid(), (unsigned)(uintptr_t)&tmp_file);
+    const char *tmp_file_str = vstr_null_terminated_str(&tmp_file);
+
+    MP_THREAD_GIL_EXIT();
+    mkdir(vstr_null_terminated_str(cache_dir), 0777);
+    int fd = open(tmp_file_str, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool ok = (fd >= 0) && (write(fd, header, sizeof(*header)) == sizeof(*header));
+    MP_THREAD_GIL_ENTER();
+
+    if (ok) {
+        nlr_buf_t nlr;
+        if (nlr_push(&nlr) == 0) {
+            ok = mp_raw_code_save_fd(cm, fd) == 0;
+            nlr_pop();
+        } else {
+            MP_THREAD_GIL_EXIT();
+            close(fd);
+            unlink(tmp_file_str);
+            MP_THREAD_GIL_ENTER();
+            vstr_clear(&tmp_file);
+            if (!mp_obj_is_subclass_fast(MP_OBJ_FROM_PTR(((mp_obj_base_t *)nlr.ret_val)->type), MP_OBJ_FROM_PTR(&mp_type_Exception))) {
+                nlr_jump(nlr.ret_val);
+            }
+            return;
+        }
+    }
+
+    MP_THREAD_GIL_EXIT();
+    if ((fd >= 0) && (close(fd) != 0)) {
+        ok = false;
+    }
+    if (ok && rename(tmp_file_str, cache_file_str) != 0) {
+        // Some filesystems (e.g. FAT) can't rename over an existing file.
+        unlink(cache_file_str);
+        ok = rename(tmp_file_str, cache_file_str) == 0;
+    }
+    if (!ok) {
+        unlink(tmp_file_str);
+    }
+    MP_THREAD_GIL_ENTER();
+    vstr_clear(&tmp_file);
+}
+
+// Load the .py file, from its bytecode cache if that is up to date, otherwise
+// by compiling it and updating the cache. Returns false if the source can't be
+// stat'd, in which case the caller compiles it without a cache.
+static bool do_load_with_bytecode_cache(mp_module_context_t *module_obj, vstr_t *file, qstr file_qstr) {
+    struct stat st;
+    MP_THREAD_GIL_EXIT();
+    int ret = stat(vstr_null_terminated_str(file), &st);
+    MP_THREAD_GIL_ENTER();
+    if (ret != 0) {
+        return false;
+    }
+
+    mp_bytecode_cache_header_t header;
+    memset(&header, 0, sizeof(header));
+    header.magic[0] = 'M';
+    header.magic[1] = 'P';
+    header.magic[2] = 'C';
+    header.magic[3] = MPY_VERSION;
+    header.opt_level = MP_STATE_VM(mp_optimise_value);
+    header.source_size = st.st_size;
+    header.source_mtime = st.st_mtime;
+
+    vstr_t cache_dir;
+    vstr_t cache_file;
+    vstr_init(&cache_dir, file->len + sizeof(MP_BYTECODE_CACHE_DIR));
+    vstr_init(&cache_file, file->len + sizeof(MP_BYTECODE_CACHE_DIR) + 2);
+    bytecode_cache_paths(file, &cache_dir, &cache_file);
+
+    mp_compiled_module_t cm;
+    cm.context = module_obj;
+    cm.arch_flags = 0;
+    if (!bytecode_cache_load(&cm, &cache_file, &header)) {
+        mp_lexer_t *lex = mp_lexer_new_from_file(file_qstr);
+        mp_parse_tree_t parse_tree = mp_parse(lex, MP_PARSE_FILE_INPUT);
+        mp_compile_to_raw_code(&parse_tree, file_qstr, false, &cm);
+        // Native code is position dependent, so it can't be cached.
+        if (!cm.has_native) {
+            bytecode_cache_save(&cm, &cache_dir, &cache_file, &header);
+        }
+    }
+    vstr_clear(&cache_dir);
+    vstr_clear(&cache_file);
+
+    do_execute_proto_fun(cm.context, cm.rc, file_qstr);
+    return true;
+}
+
+#endif // MICROPY_MODULE_BYTECODE_CACHE
+
 static void do_load(mp_module_context_t *module_obj, vstr_t *file) {
     #if MICROPY_MODULE_FROZEN || MICROPY_ENABLE_COMPILER || (MICROPY_PERSISTENT_CODE_LOAD && MICROPY_HAS_FILE_READER)
     const char *file_str = vstr_null_terminated_str(file);
@@ -255,6 +454,11 @@ static void do_load(mp_module_context_t *module_obj, vstr_t *file) {
     // If we can compile scripts then load the file and compile and execute it.
     #if MICROPY_ENABLE_COMPILER
     {
+        #if MICROPY_MODULE_BYTECODE_CACHE
+        if (do_load_with_bytecode_cache(module_obj, file, file_qstr)) {
+            return;
+        }
+        #endif
         mp_lexer_t *lex = mp_lexer_new_from_file(file_qstr);
         do_load_from_lexer(module_obj, lex);
         return;
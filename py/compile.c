@@ -191,6 +191,7 @@ typedef struct _compiler_t {
     uint16_t cur_except_level; // increased for SETUP_EXCEPT, SETUP_FINALLY; decreased for POP_BLOCK, POP_EXCEPT
     uint16_t break_continue_except_level;
 
+    mp_arena_t *arena; // arena of the parse tree, which also holds the scopes
     scope_t *scope_head;
     scope_t *scope_cur;
 
@@ -311,7 +312,7 @@ static void compile_decrease_except_level(compiler_t *comp) {
 }
 
 static scope_t *scope_new_and_link(compiler_t *comp, scope_kind_t kind, mp_parse_node_t pn, uint emit_options) {
-    scope_t *scope = scope_new(kind, pn, emit_options);
+    scope_t *scope = scope_new(comp->arena, kind, pn, emit_options);
     scope->parent = comp->scope_cur;
     scope->next = NULL;
     if (comp->scope_head == NULL) {
@@ -1319,18 +1320,29 @@ static void compile_assert_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
     EMIT_ARG(label_assign, l_end);
 }
 
+// Returns true if pn_cond is a constant with the given truth value and the branches
+// of the statement pns that it makes unreachable can be left out.  They can't if
+// the statement contains a yield, await or :=, which affect the enclosing scope
+// even when they are never run.
+static bool compile_is_const_cond(mp_parse_node_t pn_cond, bool value, mp_parse_node_struct_t *pns) {
+    if (value ? !mp_parse_node_is_const_true(pn_cond) : !mp_parse_node_is_const_false(pn_cond)) {
+        return false;
+    }
+    return !mp_parse_node_affects_scope((mp_parse_node_t)pns);
+}
+
 static void compile_if_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
     uint l_end = comp_next_label(comp);
 
     // optimisation: don't emit anything when "if False"
-    if (!mp_parse_node_is_const_false(pns->nodes[0])) {
+    if (!compile_is_const_cond(pns->nodes[0], false, pns)) {
         uint l_fail = comp_next_label(comp);
         c_if_cond(comp, pns->nodes[0], false, l_fail); // if condition
 
         compile_node(comp, pns->nodes[1]); // if block
 
         // optimisation: skip everything else when "if True"
-        if (mp_parse_node_is_const_true(pns->nodes[0])) {
+        if (compile_is_const_cond(pns->nodes[0], true, pns)) {
             goto done;
         }
 
@@ -1351,14 +1363,14 @@ static void compile_if_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
         mp_parse_node_struct_t *pns_elif = (mp_parse_node_struct_t *)pn_elif[i];
 
         // optimisation: don't emit anything when "if False"
-        if (!mp_parse_node_is_const_false(pns_elif->nodes[0])) {
+        if (!compile_is_const_cond(pns_elif->nodes[0], false, pns)) {
             uint l_fail = comp_next_label(comp);
             c_if_cond(comp, pns_elif->nodes[0], false, l_fail); // elif condition
 
             compile_node(comp, pns_elif->nodes[1]); // elif block
 
             // optimisation: skip everything else when "elif True"
-            if (mp_parse_node_is_const_true(pns_elif->nodes[0])) {
+            if (compile_is_const_cond(pns_elif->nodes[0], true, pns)) {
                 goto done;
             }
 
@@ -1392,7 +1404,7 @@ done:
 static void compile_while_stmt(compiler_t *comp, mp_parse_node_struct_t *pns) {
     START_BREAK_CONTINUE_BLOCK
 
-    if (!mp_parse_node_is_const_false(pns->nodes[0])) { // optimisation: don't emit anything for "while False"
+    if (!compile_is_const_cond(pns->nodes[0], false, pns)) { // optimisation: don't emit anything for "while False"
         uint top_label = comp_next_label(comp);
         if (!mp_parse_node_is_const_true(pns->nodes[0])) { // optimisation: don't jump to cond for "while True"
             EMIT_ARG(jump, continue_label);
@@ -3479,6 +3491,7 @@ void mp_compile_to_raw_code(mp_parse_tree_t *parse_tree, qstr source_file, bool
     compiler_t *comp = &comp_state;
 
     comp->is_repl = is_repl;
+    comp->arena = &parse_tree->arena;
     comp->break_label = INVALID_LABEL;
     comp->continue_label = INVALID_LABEL;
     mp_emit_common_init(&comp->emit_common, source_file);
@@ -3671,16 +3684,9 @@ emit_finished:
     }
     #endif
 
-    // free the parse tree
+    // free the parse tree, along with the scopes that were allocated in its arena
     mp_parse_tree_clear(parse_tree);
 
-    // free the scopes
-    for (scope_t *s = module_scope; s;) {
-        scope_t *next = s->next;
-        scope_free(s);
-        s = next;
-    }
-
     if (comp->compile_error != MP_OBJ_NULL) {
         nlr_raise(comp->compile_error);
     }
@@ -61,6 +61,13 @@
 // wrapper around everything in this file
 #if N_X64 || N_X86 || N_THUMB || N_ARM || N_XTENSA || N_XTENSAWIN || N_RV32 || N_DEBUG
 
+// Whether viper code on this architecture has an unboxed native float type
+#if MICROPY_EMIT_NATIVE_FLOAT && defined(ASM_FLOAT_OP_REG_REG)
+#define N_FLOAT (1)
+#else
+#define N_FLOAT (0)
+#endif
+
 // C stack layout for native functions:
 //  0:                          nlr_buf_t [optional]
 //                              return_value [optional word]
@@ -133,8 +140,10 @@
 
 // Whether registers can be used to store locals (only true if there are no
 // exception handlers, because otherwise an nlr_jump will restore registers to
-// their state at the start of the function and updates to locals will be lost)
-#define CAN_USE_REGS_FOR_LOCALS(emit) ((emit)->scope->exc_stack_size == 0 && !(emit->scope->scope_flags & MP_SCOPE_FLAG_GENERATOR))
+// their state at the start of the function and updates to locals will be lost).
+// A generator reloads these registers from its state each time it is resumed,
+// and writes them back to its state before each yield.
+#define CAN_USE_REGS_FOR_LOCALS(emit) ((emit)->scope->exc_stack_size == 0)
 
 // Indices within the local C stack for various variables
 #define LOCAL_IDX_EXC_VAL(emit) (NLR_BUF_IDX_RET_VAL)
@@ -151,7 +160,7 @@
 
 // When building with the ability to save native code to .mpy files:
 //  - Qstrs are indirect via qstr_table, and REG_LOCAL_3 always points to qstr_table.
-//  - In a generator no registers are used to store locals, and REG_LOCAL_2 points to the generator state.
+//  - In a generator REG_LOCAL_2 points to the generator state, so only REG_LOCAL_1 can hold a local.
 //  - At most 2 registers hold local variables (see CAN_USE_REGS_FOR_LOCALS for when this is possible).
 
 #define REG_GENERATOR_STATE (REG_LOCAL_2)
@@ -164,7 +173,7 @@ static const uint8_t reg_local_table[MAX_REGS_FOR_LOCAL_VARS] = {REG_LOCAL_1, RE
 
 // When building without the ability to save native code to .mpy files:
 //  - Qstrs values are written directly into the machine code.
-//  - In a generator no registers are used to store locals, and REG_LOCAL_3 points to the generator state.
+//  - In a generator REG_LOCAL_3 points to the generator state, so only REG_LOCAL_1/2 can hold locals.
 //  - At most 3 registers hold local variables (see CAN_USE_REGS_FOR_LOCALS for when this is possible).
 
 #define REG_GENERATOR_STATE (REG_LOCAL_3)
@@ -176,6 +185,12 @@ static const uint8_t reg_local_table[MAX_REGS_FOR_LOCAL_VARS] = {REG_LOCAL_1, RE
 
 #define REG_LOCAL_LAST (reg_local_table[MAX_REGS_FOR_LOCAL_VARS - 1])
 
+// The number of registers that hold locals, in a generator the last one is REG_GENERATOR_STATE
+#define NUM_REGS_FOR_LOCAL_VARS(emit) (((emit)->scope->scope_flags & MP_SCOPE_FLAG_GENERATOR) ? MAX_REGS_FOR_LOCAL_VARS - 1 : MAX_REGS_FOR_LOCAL_VARS)
+
+// Whether the given local lives in a register rather than in the state
+#define LOCAL_IS_IN_REG(emit, local_num) ((local_num) < NUM_REGS_FOR_LOCAL_VARS(emit) && CAN_USE_REGS_FOR_LOCALS(emit))
+
 #define EMIT_NATIVE_VIPER_TYPE_ERROR(emit, ...) do { \
         *emit->error_slot = mp_obj_new_exception_msg_varg(&mp_type_ViperTypeError, __VA_ARGS__); \
 } while (0)
@@ -197,6 +212,7 @@ typedef enum {
     VTYPE_PTR8 = 0x00 | MP_NATIVE_TYPE_PTR8,
     VTYPE_PTR16 = 0x00 | MP_NATIVE_TYPE_PTR16,
     VTYPE_PTR32 = 0x00 | MP_NATIVE_TYPE_PTR32,
+    VTYPE_FLOAT = 0x00 | MP_NATIVE_TYPE_FLOAT,
 
     VTYPE_PTR_NONE = 0x50 | MP_NATIVE_TYPE_PTR,
 
@@ -222,6 +238,10 @@ static qstr vtype_to_qstr(vtype_kind_t vtype) {
             return MP_QSTR_ptr16;
         case VTYPE_PTR32:
             return MP_QSTR_ptr32;
+        #if MICROPY_PY_BUILTINS_FLOAT
+        case VTYPE_FLOAT:
+            return MP_QSTR_float;
+        #endif
         case VTYPE_PTR_NONE:
         default:
             return MP_QSTR_None;
@@ -361,6 +381,24 @@ static void emit_native_mov_reg_state_addr(emit_t *emit, int reg_dest, int local
     }
 }
 
+// Load the locals that live in registers from the state.
+static void emit_native_load_reg_locals(emit_t *emit) {
+    if (CAN_USE_REGS_FOR_LOCALS(emit)) {
+        for (int i = 0; i < NUM_REGS_FOR_LOCAL_VARS(emit) && i < emit->scope->num_locals; ++i) {
+            emit_native_mov_reg_state(emit, reg_local_table[i], LOCAL_IDX_LOCAL_VAR(emit, i));
+        }
+    }
+}
+
+// Store the locals that live in registers back to the state, used by a generator before it yields.
+static void emit_native_store_reg_locals(emit_t *emit) {
+    if (CAN_USE_REGS_FOR_LOCALS(emit)) {
+        for (int i = 0; i < NUM_REGS_FOR_LOCAL_VARS(emit) && i < emit->scope->num_locals; ++i) {
+            emit_native_mov_state_reg(emit, LOCAL_IDX_LOCAL_VAR(emit, i), reg_local_table[i]);
+        }
+    }
+}
+
 static void emit_native_mov_reg_qstr(emit_t *emit, int arg_reg, qstr qst) {
     #if MICROPY_PERSISTENT_CODE_SAVE
     ASM_LOAD16_REG_REG_OFFSET(emit->as, arg_reg, REG_QSTR_TABLE, mp_emit_common_use_qstr(emit->emit_common, qst));
@@ -659,10 +697,9 @@ static void emit_native_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scop
         emit_native_global_exc_entry(emit);
 
         // cache some locals in registers, but only if no exception handlers
-        if (CAN_USE_REGS_FOR_LOCALS(emit)) {
-            for (int i = 0; i < MAX_REGS_FOR_LOCAL_VARS && i < scope->num_locals; ++i) {
-                ASM_MOV_REG_LOCAL(emit->as, reg_local_table[i], LOCAL_IDX_LOCAL_VAR(emit, i));
-            }
+        // (a generator does this on each entry, in emit_native_global_exc_entry)
+        if (!(emit->scope->scope_flags & MP_SCOPE_FLAG_GENERATOR)) {
+            emit_native_load_reg_locals(emit);
         }
 
         // set the type of closed over variables
@@ -1298,6 +1335,8 @@ static void emit_native_global_exc_entry(emit_t *emit) {
         emit_native_label_assign(emit, start_label);
 
         if (emit->scope->scope_flags & MP_SCOPE_FLAG_GENERATOR) {
+            // Restore locals held in registers, then jump to the re-entry point
+            emit_native_load_reg_locals(emit);
             emit_native_mov_reg_state(emit, REG_TEMP0, LOCAL_IDX_GEN_PC(emit));
             ASM_JUMP_REG(emit->as, REG_TEMP0);
             emit->start_offset = mp_asm_base_get_code_pos(&emit->as->base);
@@ -1451,7 +1490,7 @@ static void emit_native_load_fast(emit_t *emit, qstr qst, mp_uint_t local_num) {
         EMIT_NATIVE_VIPER_TYPE_ERROR(emit, MP_ERROR_TEXT("local '%q' used before type known"), qst);
     }
     emit_native_pre(emit);
-    if (local_num < MAX_REGS_FOR_LOCAL_VARS && CAN_USE_REGS_FOR_LOCALS(emit)) {
+    if (LOCAL_IS_IN_REG(emit, local_num)) {
         emit_post_push_reg(emit, vtype, reg_local_table[local_num]);
     } else {
         need_reg_single(emit, REG_TEMP0, 0);
@@ -1680,7 +1719,7 @@ static void emit_native_load_subscr(emit_t *emit) {
 
 static void emit_native_store_fast(emit_t *emit, qstr qst, mp_uint_t local_num) {
     vtype_kind_t vtype;
-    if (local_num < MAX_REGS_FOR_LOCAL_VARS && CAN_USE_REGS_FOR_LOCALS(emit)) {
+    if (LOCAL_IS_IN_REG(emit, local_num)) {
         emit_pre_pop_reg(emit, &vtype, reg_local_table[local_num]);
     } else {
         emit_pre_pop_reg(emit, &vtype, REG_TEMP0);
@@ -2362,6 +2401,14 @@ static void emit_native_unary_op(emit_t *emit, mp_unary_op_t op) {
             EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
                 MP_ERROR_TEXT("'not' not implemented"), mp_binary_op_method_name[op]);
         }
+    #if N_FLOAT
+    } else if (vtype == VTYPE_FLOAT && (op == MP_UNARY_OP_POSITIVE || op == MP_UNARY_OP_NEGATIVE)) {
+        if (op == MP_UNARY_OP_NEGATIVE) {
+            emit_pre_pop_reg(emit, &vtype, REG_RET);
+            ASM_FLOAT_NEG_REG(emit->as, REG_RET);
+            emit_post_push_reg(emit, vtype, REG_RET);
+        }
+    #endif
     } else if (vtype == VTYPE_PYOBJ) {
         emit_pre_pop_reg(emit, &vtype, REG_ARG_2);
         emit_call_with_imm_arg(emit, MP_F_UNARY_OP, op, REG_ARG_1);
@@ -2372,10 +2419,37 @@ static void emit_native_unary_op(emit_t *emit, mp_unary_op_t op) {
     }
 }
 
+#if N_FLOAT
+static bool vtype_is_number(vtype_kind_t vtype) {
+    return vtype == VTYPE_INT || vtype == VTYPE_UINT || vtype == VTYPE_FLOAT;
+}
+
+// Converts the native value at the given stack position (pos=1 is TOS) to a Python object.
+static void emit_box_stack_entry(emit_t *emit, int pos) {
+    vtype_kind_t vtype;
+    emit_access_stack(emit, pos, &vtype, REG_ARG_1);
+    emit_call_with_imm_arg(emit, MP_F_CONVERT_NATIVE_TO_OBJ, vtype, REG_ARG_2);
+    stack_info_t *si = &emit->stack_info[emit->stack_size - pos];
+    si->vtype = VTYPE_PYOBJ;
+    si->kind = STACK_REG;
+    si->data.u_reg = REG_RET;
+}
+#endif
+
 static void emit_native_binary_op(emit_t *emit, mp_binary_op_t op) {
     DEBUG_printf("binary_op(" UINT_FMT ")\n", op);
     vtype_kind_t vtype_lhs = peek_vtype(emit, 1);
     vtype_kind_t vtype_rhs = peek_vtype(emit, 0);
+    #if N_FLOAT
+    // a native float combined with an object is boxed, and the object decides the result
+    if (vtype_lhs == VTYPE_FLOAT && vtype_rhs == VTYPE_PYOBJ) {
+        emit_box_stack_entry(emit, 2);
+        vtype_lhs = VTYPE_PYOBJ;
+    } else if (vtype_lhs == VTYPE_PYOBJ && vtype_rhs == VTYPE_FLOAT) {
+        emit_box_stack_entry(emit, 1);
+        vtype_rhs = VTYPE_PYOBJ;
+    }
+    #endif
     if ((vtype_lhs == VTYPE_INT || vtype_lhs == VTYPE_UINT)
         && (vtype_rhs == VTYPE_INT || vtype_rhs == VTYPE_UINT)) {
         // for integers, inplace and normal ops are equivalent, so use just normal ops
@@ -2642,6 +2716,64 @@ static void emit_native_binary_op(emit_t *emit, mp_binary_op_t op) {
             EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
                 MP_ERROR_TEXT("binary op %q not implemented"), mp_binary_op_method_name[op]);
         }
+    #if N_FLOAT
+    } else if ((vtype_lhs == VTYPE_FLOAT || vtype_rhs == VTYPE_FLOAT)
+               && vtype_is_number(vtype_lhs) && vtype_is_number(vtype_rhs)) {
+        // for floats, inplace and normal ops are equivalent, so use just normal ops
+        if (MP_BINARY_OP_INPLACE_OR <= op && op <= MP_BINARY_OP_INPLACE_POWER) {
+            op += MP_BINARY_OP_OR - MP_BINARY_OP_INPLACE_OR;
+        }
+
+        // an int operand is converted to float first (a uint is treated as signed)
+        int reg_rhs = REG_ARG_3;
+        if (vtype_rhs == VTYPE_FLOAT) {
+            emit_pre_pop_reg_flexible(emit, &vtype_rhs, &reg_rhs, REG_RET, REG_ARG_2);
+        } else {
+            emit_pre_pop_reg(emit, &vtype_rhs, reg_rhs);
+            ASM_FLOAT_FROM_INT_REG(emit->as, reg_rhs, reg_rhs);
+        }
+        emit_pre_pop_reg(emit, &vtype_lhs, REG_ARG_2);
+        if (vtype_lhs != VTYPE_FLOAT) {
+            ASM_FLOAT_FROM_INT_REG(emit->as, REG_ARG_2, REG_ARG_2);
+        }
+
+        if (op == MP_BINARY_OP_ADD
+            || op == MP_BINARY_OP_SUBTRACT
+            || op == MP_BINARY_OP_MULTIPLY
+            || op == MP_BINARY_OP_TRUE_DIVIDE) {
+            static const byte float_ops[] = {
+                [MP_BINARY_OP_ADD - MP_BINARY_OP_ADD] = ASM_FLOAT_OP_ADD,
+                [MP_BINARY_OP_SUBTRACT - MP_BINARY_OP_ADD] = ASM_FLOAT_OP_SUB,
+                [MP_BINARY_OP_MULTIPLY - MP_BINARY_OP_ADD] = ASM_FLOAT_OP_MUL,
+                [MP_BINARY_OP_TRUE_DIVIDE - MP_BINARY_OP_ADD] = ASM_FLOAT_OP_DIV,
+            };
+            // note: division by zero gives inf or nan rather than raising
+            ASM_FLOAT_OP_REG_REG(emit->as, float_ops[op - MP_BINARY_OP_ADD], REG_ARG_2, reg_rhs);
+            emit_post_push_reg(emit, VTYPE_FLOAT, REG_ARG_2);
+        } else if (MP_BINARY_OP_LESS <= op && op <= MP_BINARY_OP_NOT_EQUAL) {
+            // > and >= are done as < and <= with the operands swapped
+            static const byte float_cmp[6] = {
+                ASM_FLOAT_CMP_LT, // MP_BINARY_OP_LESS
+                ASM_FLOAT_CMP_LT, // MP_BINARY_OP_MORE (swapped)
+                ASM_FLOAT_CMP_EQ, // MP_BINARY_OP_EQUAL
+                ASM_FLOAT_CMP_LE, // MP_BINARY_OP_LESS_EQUAL
+                ASM_FLOAT_CMP_LE, // MP_BINARY_OP_MORE_EQUAL (swapped)
+                ASM_FLOAT_CMP_NE, // MP_BINARY_OP_NOT_EQUAL
+            };
+            byte cmp = float_cmp[op - MP_BINARY_OP_LESS];
+            need_reg_single(emit, REG_RET, 0);
+            if (op == MP_BINARY_OP_MORE || op == MP_BINARY_OP_MORE_EQUAL) {
+                ASM_FLOAT_CMP_REG_REG(emit->as, cmp, REG_RET, reg_rhs, REG_ARG_2);
+            } else {
+                ASM_FLOAT_CMP_REG_REG(emit->as, cmp, REG_RET, REG_ARG_2, reg_rhs);
+            }
+            emit_post_push_reg(emit, VTYPE_BOOL, REG_RET);
+        } else {
+            adjust_stack(emit, 1);
+            EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
+                MP_ERROR_TEXT("binary op %q not implemented"), mp_binary_op_method_name[op]);
+        }
+    #endif
     } else if (vtype_lhs == VTYPE_PYOBJ && vtype_rhs == VTYPE_PYOBJ) {
         emit_pre_pop_reg_reg(emit, &vtype_rhs, REG_ARG_3, &vtype_lhs, REG_ARG_2);
         bool invert = false;
@@ -2847,9 +2979,39 @@ static void emit_native_call_function(emit_t *emit, mp_uint_t n_positional, mp_u
             case VTYPE_PTR16:
             case VTYPE_PTR32:
             case VTYPE_PTR_NONE:
+                #if N_FLOAT
+                if (vtype_cast == VTYPE_FLOAT) {
+                    // int to float converts the value, it doesn't reinterpret the bits
+                    vtype_kind_t vtype;
+                    emit_pre_pop_reg(emit, &vtype, REG_RET);
+                    emit_pre_pop_discard(emit);
+                    ASM_FLOAT_FROM_INT_REG(emit->as, REG_RET, REG_RET);
+                    emit_post_push_reg(emit, VTYPE_FLOAT, REG_RET);
+                    break;
+                }
+                #endif
                 emit_fold_stack_top(emit, REG_ARG_1);
                 emit_post_top_set_vtype(emit, vtype_cast);
                 break;
+            #if N_FLOAT
+            case VTYPE_FLOAT:
+                if (vtype_cast == VTYPE_FLOAT) {
+                    emit_fold_stack_top(emit, REG_ARG_1);
+                } else if (vtype_cast == VTYPE_INT || vtype_cast == VTYPE_UINT) {
+                    // truncates towards zero
+                    vtype_kind_t vtype;
+                    emit_pre_pop_reg(emit, &vtype, REG_RET);
+                    emit_pre_pop_discard(emit);
+                    ASM_FLOAT_TO_INT_REG(emit->as, REG_RET, REG_RET);
+                    emit_post_push_reg(emit, vtype_cast, REG_RET);
+                } else {
+                    emit_fold_stack_top(emit, REG_ARG_1);
+                    EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
+                        MP_ERROR_TEXT("can't convert '%q' to '%q'"),
+                        vtype_to_qstr(VTYPE_FLOAT), vtype_to_qstr(vtype_cast));
+                }
+                break;
+            #endif
             default:
                 // this can happen when casting a cast: int(int)
                 mp_raise_NotImplementedError(MP_ERROR_TEXT("casting"));
@@ -2989,6 +3151,9 @@ static void emit_native_yield(emit_t *emit, int kind) {
     ASM_MOV_REG_PCREL(emit->as, REG_TEMP0, *emit->label_slot);
     emit_native_mov_state_reg(emit, LOCAL_IDX_GEN_PC(emit), REG_TEMP0);
 
+    // Save locals held in registers, they are restored on re-entry
+    emit_native_store_reg_locals(emit);
+
     // Jump to exit handler
     ASM_JUMP(emit->as, emit->exit_label);
 
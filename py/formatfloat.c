@@ -34,6 +34,10 @@
 #include <math.h>
 #include "py/formatfloat.h"
 #include "py/parsenum.h"
+#if MICROPY_FLOAT_FORMAT_SHORTEST && MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_MPZ && MICROPY_ENABLE_GC
+#include "py/gc.h"
+#include "py/mpz.h"
+#endif
 
 /***********************************************************************
 
@@ -269,6 +273,384 @@ static int mp_format_mantissa(mp_large_float_uint_t mantissa, mp_large_float_uin
     return s - buf;
 }
 
+#if MICROPY_FLOAT_FORMAT_SHORTEST
+
+/***********************************************************************
+
+  Shortest round-trip digits for `repr`, using Grisu3 from Florian Loitsch,
+  "Printing Floating-Point Numbers Quickly and Accurately with Integers"
+  (PLDI 2010), structured like its implementation in the double-conversion
+  library.
+
+  It uses only 64-bit integer arithmetic to find the shortest digits that
+  parse back to the same float, and the closest ones if there are several.
+  For about 0.5% of inputs it can't prove its answer is both, and then
+  mp_format_float falls back to an exact method using mpz, or to the
+  search below if there is no mpz or the heap is locked.
+
+***********************************************************************/
+
+// A number f * 2^e with a 64-bit significand
+typedef struct _grisu_fp_t {
+    uint64_t f;
+    int e;
+} grisu_fp_t;
+
+// Significands of 10^k for k = GRISU_MIN_K + 8 * i, normalised and rounded to
+// nearest. The binary exponent of each is ((217706 * k) >> 16) - 63. Single
+// precision only needs 1e-36 to 1e52.
+#if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE
+#define GRISU_MIN_K (-348)
+#else
+#define GRISU_MIN_K (-36)
+#endif
+static const uint64_t grisu_cached_powers[] = {
+    #if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE
+    0xfa8fd5a0081c0288, // 1e-348
+    0xbaaee17fa23ebf76, // 1e-340
+    0x8b16fb203055ac76, // 1e-332
+    0xcf42894a5dce35ea, // 1e-324
+    0x9a6bb0aa55653b2d, // 1e-316
+    0xe61acf033d1a45df, // 1e-308
+    0xab70fe17c79ac6ca, // 1e-300
+    0xff77b1fcbebcdc4f, // 1e-292
+    0xbe5691ef416bd60c, // 1e-284
+    0x8dd01fad907ffc3c, // 1e-276
+    0xd3515c2831559a83, // 1e-268
+    0x9d71ac8fada6c9b5, // 1e-260
+    0xea9c227723ee8bcb, // 1e-252
+    0xaecc49914078536d, // 1e-244
+    0x823c12795db6ce57, // 1e-236
+    0xc21094364dfb5637, // 1e-228
+    0x9096ea6f3848984f, // 1e-220
+    0xd77485cb25823ac7, // 1e-212
+    0xa086cfcd97bf97f4, // 1e-204
+    0xef340a98172aace5, // 1e-196
+    0xb23867fb2a35b28e, // 1e-188
+    0x84c8d4dfd2c63f3b, // 1e-180
+    0xc5dd44271ad3cdba, // 1e-172
+    0x936b9fcebb25c996, // 1e-164
+    0xdbac6c247d62a584, // 1e-156
+    0xa3ab66580d5fdaf6, // 1e-148
+    0xf3e2f893dec3f126, // 1e-140
+    0xb5b5ada8aaff80b8, // 1e-132
+    0x87625f056c7c4a8b, // 1e-124
+    0xc9bcff6034c13053, // 1e-116
+    0x964e858c91ba2655, // 1e-108
+    0xdff9772470297ebd, // 1e-100
+    0xa6dfbd9fb8e5b88f, // 1e-92
+    0xf8a95fcf88747d94, // 1e-84
+    0xb94470938fa89bcf, // 1e-76
+    0x8a08f0f8bf0f156b, // 1e-68
+    0xcdb02555653131b6, // 1e-60
+    0x993fe2c6d07b7fac, // 1e-52
+    0xe45c10c42a2b3b06, // 1e-44
+    #endif
+    0xaa242499697392d3, // 1e-36
+    0xfd87b5f28300ca0e, // 1e-28
+    0xbce5086492111aeb, // 1e-20
+    0x8cbccc096f5088cc, // 1e-12
+    0xd1b71758e219652c, // 1e-4
+    0x9c40000000000000, // 1e4
+    0xe8d4a51000000000, // 1e12
+    0xad78ebc5ac620000, // 1e20
+    0x813f3978f8940984, // 1e28
+    0xc097ce7bc90715b3, // 1e36
+    0x8f7e32ce7bea5c70, // 1e44
+    0xd5d238a4abe98068, // 1e52
+    #if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE
+    0x9f4f2726179a2245, // 1e60
+    0xed63a231d4c4fb27, // 1e68
+    0xb0de65388cc8ada8, // 1e76
+    0x83c7088e1aab65db, // 1e84
+    0xc45d1df942711d9a, // 1e92
+    0x924d692ca61be758, // 1e100
+    0xda01ee641a708dea, // 1e108
+    0xa26da3999aef774a, // 1e116
+    0xf209787bb47d6b85, // 1e124
+    0xb454e4a179dd1877, // 1e132
+    0x865b86925b9bc5c2, // 1e140
+    0xc83553c5c8965d3d, // 1e148
+    0x952ab45cfa97a0b3, // 1e156
+    0xde469fbd99a05fe3, // 1e164
+    0xa59bc234db398c25, // 1e172
+    0xf6c69a72a3989f5c, // 1e180
+    0xb7dcbf5354e9bece, // 1e188
+    0x88fcf317f22241e2, // 1e196
+    0xcc20ce9bd35c78a5, // 1e204
+    0x98165af37b2153df, // 1e212
+    0xe2a0b5dc971f303a, // 1e220
+    0xa8d9d1535ce3b396, // 1e228
+    0xfb9b7cd9a4a7443c, // 1e236
+    0xbb764c4ca7a44410, // 1e244
+    0x8bab8eefb6409c1a, // 1e252
+    0xd01fef10a657842c, // 1e260
+    0x9b10a4e5e9913129, // 1e268
+    0xe7109bfba19c0c9d, // 1e276
+    0xac2820d9623bf429, // 1e284
+    0x80444b5e7aa7cf85, // 1e292
+    0xbf21e44003acdd2d, // 1e300
+    0x8e679c2f5e44ff8f, // 1e308
+    0xd433179d9c8cb841, // 1e316
+    0x9e19db92b4e31ba9, // 1e324
+    0xeb96bf6ebadf77d9, // 1e332
+    0xaf87023b9bf0ee6b, // 1e340
+    #endif
+};
+
+// Range for the exponent of the scaled value, so that its integral part fits
+// in 32 bits and a digit can be taken from its fractional part with a multiply
+#define GRISU_MIN_TARGET_EXP (-60)
+#define GRISU_MAX_TARGET_EXP (-32)
+
+static grisu_fp_t grisu_normalize(uint64_t f, int e) {
+    int shift = mp_clzll(f);
+    grisu_fp_t r = { f << shift, e - shift };
+    return r;
+}
+
+// Returns the upper 64 bits of the product, rounded
+static grisu_fp_t grisu_multiply(grisu_fp_t x, grisu_fp_t y) {
+    uint64_t a = x.f >> 32, b = x.f & 0xffffffff;
+    uint64_t c = y.f >> 32, d = y.f & 0xffffffff;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t mid = (bd >> 32) + (ad & 0xffffffff) + (bc & 0xffffffff) + (1U << 31);
+    grisu_fp_t r = { ac + (ad >> 32) + (bc >> 32) + (mid >> 32), x.e + y.e + 64 };
+    return r;
+}
+
+// Moves the last digit of the mantissa towards w while that is safe, and returns
+// whether the result is guaranteed to be the closest shortest representation.
+// All distances are in units of the scaled exponent: distance_high_w is from the
+// upper boundary to w, rest is from the upper boundary to the current digits,
+// and unit is the uncertainty of the scaled values.
+static bool grisu_round_weed(uint64_t *mantissa, uint64_t distance_high_w, uint64_t unsafe_interval,
+    uint64_t rest, uint64_t ten_kappa, uint64_t unit) {
+    uint64_t small_distance = distance_high_w - unit;
+    uint64_t big_distance = distance_high_w + unit;
+    while (rest < small_distance
+           && unsafe_interval - rest >= ten_kappa
+           && (rest + ten_kappa < small_distance || small_distance - rest >= rest + ten_kappa - small_distance)) {
+        --*mantissa;
+        rest += ten_kappa;
+    }
+    if (rest < big_distance
+        && unsafe_interval - rest >= ten_kappa
+        && (rest + ten_kappa < big_distance || big_distance - rest > rest + ten_kappa - big_distance)) {
+        return false;
+    }
+    return 2 * unit <= rest && rest <= unsafe_interval - 4 * unit;
+}
+
+// Splits f > 0 into its integer significand and binary exponent, and returns
+// whether the gap to the float below is half the gap to the float above. This
+// is when the significand is a power of 2, except for the smallest normal
+// exponent whose lower neighbour is subnormal with the same spacing.
+static bool fp_decompose(mp_float_t f, uint64_t *frc, int *e) {
+    mp_float_union_t u = { f };
+    *frc = u.p.frc;
+    if (u.p.exp == 0) {
+        *e = 1 - MP_FLOAT_EXP_BIAS - MP_FLOAT_FRAC_BITS;
+    } else {
+        *frc |= (uint64_t)1 << MP_FLOAT_FRAC_BITS;
+        *e = (int)u.p.exp - MP_FLOAT_EXP_BIAS - MP_FLOAT_FRAC_BITS;
+    }
+    return u.p.frc == 0 && u.p.exp > 1;
+}
+
+// Finds the shortest digits for f > 0 and returns how many there are, with the
+// digits in *mantissa and the power of 10 of the last one in *exp10. Returns 0
+// if Grisu3 can't guarantee the result.
+static int grisu3(mp_float_t f, uint64_t *mantissa, int *exp10) {
+    uint64_t frc;
+    int e;
+    bool lower_closer = fp_decompose(f, &frc, &e);
+
+    // The boundaries are halfway to the neighbouring floats
+    grisu_fp_t w = grisu_normalize(frc, e);
+    grisu_fp_t plus = grisu_normalize((frc << 1) + 1, e - 1);
+    grisu_fp_t minus;
+    if (lower_closer) {
+        minus.f = (frc << 2) - 1;
+        minus.e = e - 2;
+    } else {
+        minus.f = (frc << 1) - 1;
+        minus.e = e - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    // Pick the cached power 10^k that brings the exponent into the target range,
+    // starting from an estimate that is never too high.
+    int index = ((((GRISU_MIN_TARGET_EXP - 1 - w.e) * 78913) >> 18) - GRISU_MIN_K) / 8;
+    int k;
+    for (;;) {
+        k = GRISU_MIN_K + 8 * index;
+        if (w.e + ((217706 * k) >> 16) + 1 >= GRISU_MIN_TARGET_EXP) {
+            break;
+        }
+        ++index;
+    }
+    assert(index >= 0 && index < (int)MP_ARRAY_SIZE(grisu_cached_powers));
+    grisu_fp_t c = { grisu_cached_powers[index], ((217706 * k) >> 16) - 63 };
+    w = grisu_multiply(w, c);
+    plus = grisu_multiply(plus, c);
+    minus = grisu_multiply(minus, c);
+    assert(w.e >= GRISU_MIN_TARGET_EXP && w.e <= GRISU_MAX_TARGET_EXP);
+
+    // Generate digits of the upper boundary until they are inside the unsafe
+    // interval, which is widened by the 1 unit error of each multiplication.
+    uint64_t unit = 1;
+    uint64_t too_high = plus.f + unit;
+    uint64_t unsafe_interval = too_high - (minus.f - unit);
+    int shift = -w.e;
+    uint64_t one = (uint64_t)1 << shift;
+    uint32_t integrals = (uint32_t)(too_high >> shift);
+    uint64_t fractionals = too_high & (one - 1);
+    uint32_t divisor = 1;
+    int kappa = 1;
+    while (kappa < 10 && integrals / divisor >= 10) {
+        divisor *= 10;
+        kappa++;
+    }
+    uint64_t digits = 0;
+    int num_digits = 0;
+    while (kappa > 0) {
+        digits = digits * 10 + integrals / divisor;
+        num_digits++;
+        integrals %= divisor;
+        kappa--;
+        uint64_t rest = ((uint64_t)integrals << shift) + fractionals;
+        if (rest < unsafe_interval) {
+            if (!grisu_round_weed(&digits, too_high - w.f, unsafe_interval, rest, (uint64_t)divisor << shift, unit)) {
+                return 0;
+            }
+            goto done;
+        }
+        divisor /= 10;
+    }
+    for (;;) {
+        fractionals *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+        digits = digits * 10 + (fractionals >> shift);
+        num_digits++;
+        fractionals &= one - 1;
+        kappa--;
+        if (fractionals < unsafe_interval) {
+            if (!grisu_round_weed(&digits, (too_high - w.f) * unit, unsafe_interval, fractionals, one, unit)) {
+                return 0;
+            }
+            break;
+        }
+    }
+done:
+    *mantissa = digits;
+    *exp10 = kappa - k;
+    return num_digits;
+}
+
+#if MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_MPZ && MICROPY_ENABLE_GC
+
+// Exact fallback for the values that grisu3 rejects, with the same interface and
+// results. It uses the free-format algorithm of Steele & White and Burger & Dybvig:
+// v = r / s, the boundaries are (r - m_minus) / s and (r + m_plus) / s, and digits
+// are produced until one of the boundaries is crossed. The boundaries belong to v
+// when the significand is even, because parsing rounds half to even.
+static int shortest_bignum(mp_float_t f, uint64_t *mantissa, int *exp10) {
+    uint64_t frc;
+    int e;
+    bool lower_closer = fp_decompose(f, &frc, &e);
+    bool even = (frc & 1) == 0;
+
+    mpz_t r, s, m_plus, m_minus, ten, tmp;
+    mpz_init_zero(&r);
+    mpz_set_from_ll(&r, (long long)frc, false);
+    mpz_init_from_int(&s, 1);
+    mpz_init_from_int(&m_plus, lower_closer ? 2 : 1);
+    mpz_init_from_int(&m_minus, 1);
+    mpz_init_from_int(&ten, 10);
+    mpz_init_zero(&tmp);
+    int shift = lower_closer ? 2 : 1;
+    mpz_shl_inpl(&r, &r, shift);
+    mpz_shl_inpl(&s, &s, shift);
+    if (e >= 0) {
+        mpz_shl_inpl(&r, &r, e);
+        mpz_shl_inpl(&m_plus, &m_plus, e);
+        mpz_shl_inpl(&m_minus, &m_minus, e);
+    } else {
+        mpz_shl_inpl(&s, &s, -e);
+    }
+
+    // Scale by an estimate of 10^-k that is never too small, then fix it up so
+    // the upper boundary is below 1 and the first digit is the leading one
+    int k = (((e + 63 - (int)mp_clzll(frc)) * 78913) >> 18) + 1;
+    mpz_set_from_int(&tmp, k >= 0 ? k : -k);
+    mpz_pow_inpl(&tmp, &ten, &tmp);
+    if (k >= 0) {
+        mpz_mul_inpl(&s, &s, &tmp);
+    } else {
+        mpz_mul_inpl(&r, &r, &tmp);
+        mpz_mul_inpl(&m_plus, &m_plus, &tmp);
+        mpz_mul_inpl(&m_minus, &m_minus, &tmp);
+    }
+    for (;;) {
+        mpz_add_inpl(&tmp, &r, &m_plus);
+        int c = mpz_cmp(&tmp, &s);
+        if (even ? c < 0 : c <= 0) {
+            break;
+        }
+        mpz_mul_inpl(&s, &s, &ten);
+        k++;
+    }
+
+    uint64_t digits = 0;
+    int num_digits = 0;
+    for (;;) {
+        mpz_mul_inpl(&r, &r, &ten);
+        mpz_mul_inpl(&m_plus, &m_plus, &ten);
+        mpz_mul_inpl(&m_minus, &m_minus, &ten);
+        int d = 0;
+        while (mpz_cmp(&r, &s) >= 0) {
+            mpz_sub_inpl(&r, &r, &s);
+            d++;
+        }
+        num_digits++;
+        k--;
+        int c = mpz_cmp(&r, &m_minus);
+        bool low = even ? c <= 0 : c < 0;
+        mpz_add_inpl(&tmp, &r, &m_plus);
+        c = mpz_cmp(&tmp, &s);
+        bool high = even ? c >= 0 : c > 0;
+        if (low && high) {
+            // Both digits are in range, so take the closer one, or the even one on a tie
+            mpz_shl_inpl(&tmp, &r, 1);
+            c = mpz_cmp(&tmp, &s);
+            d += c > 0 || (c == 0 && (d & 1));
+        } else if (high) {
+            d++;
+        }
+        digits = digits * 10 + d;
+        if (low || high) {
+            break;
+        }
+    }
+
+    mpz_deinit(&r);
+    mpz_deinit(&s);
+    mpz_deinit(&m_plus);
+    mpz_deinit(&m_minus);
+    mpz_deinit(&ten);
+    mpz_deinit(&tmp);
+    *mantissa = digits;
+    *exp10 = k;
+    return num_digits;
+}
+
+#endif
+
+#endif // MICROPY_FLOAT_FORMAT_SHORTEST
+
 // minimal value expected for buf_size, to avoid checking everywhere for overflow
 #define MIN_BUF_SIZE (MAX_MANTISSA_DIGITS + 10)
 
@@ -317,6 +699,25 @@ int mp_format_float(mp_float_t f_entry, char *buf_entry, size_t buf_size, char f
         fmt_flags |= FMT_MODE_E;
     }
 
+    #if MICROPY_FLOAT_FORMAT_SHORTEST
+    if (prec == MP_FLOAT_REPR_PREC && !fp_iszero(f)) {
+        uint64_t mantissa;
+        int exp10;
+        int num_digits = grisu3(f, &mantissa, &exp10);
+        #if MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_MPZ && MICROPY_ENABLE_GC
+        // The exact fallback needs the heap, so use the search below when it's locked
+        if (!num_digits && !gc_is_locked()) {
+            num_digits = shortest_bignum(f, &mantissa, &exp10);
+        }
+        #endif
+        if (num_digits) {
+            int reprlen = mp_format_mantissa((mp_large_float_uint_t)mantissa, (mp_large_float_uint_t)-1, buf, buf,
+                num_digits, 16, 0, 0, exp10 + num_digits - 1, fmt_flags);
+            return buf + reprlen - buf_entry;
+        }
+    }
+    #endif
+
     // When precision is unspecified, default to 6
     if (prec < 0) {
         prec = 6;
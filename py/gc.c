@@ -29,6 +29,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "py/allocprof.h"
 #include "py/gc.h"
 #include "py/runtime.h"
 
@@ -182,6 +183,7 @@ static void gc_setup_area(mp_state_mem_area_t *area, void *start, void *end) {
     #endif
 
     area->gc_last_free_atb_index = 0;
+    area->gc_last_free_run_atb_index = 0;
     area->gc_last_used_block = 0;
 
     #if MICROPY_GC_SPLIT_HEAP
@@ -531,6 +533,10 @@ static void gc_mark_subtree(size_t block)
 }
 
 void gc_sweep_all(void) {
+    #if MICROPY_PY_MICROPYTHON_ALLOC_PROFILE
+    // The profile is about to be freed along with everything else.
+    MP_STATE_VM(alloc_profile) = NULL;
+    #endif
     gc_collect_start_common();
     gc_collect_end();
 }
@@ -544,9 +550,14 @@ void gc_collect_end(void) {
     #endif
     for (mp_state_mem_area_t *area = &MP_STATE_MEM(area); area != NULL; area = NEXT_AREA(area)) {
         area->gc_last_free_atb_index = 0;
+        area->gc_last_free_run_atb_index = 0;
     }
     MP_STATE_THREAD(gc_lock_depth) &= ~GC_COLLECT_FLAG;
     GC_EXIT();
+
+    #if MICROPY_PY_MICROPYTHON_ALLOC_PROFILE
+    mp_alloc_profile_collect();
+    #endif
 }
 
 static void gc_deal_with_stack_overflow(void) {
@@ -815,7 +826,15 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
         // look for a run of n_blocks available blocks
         for (; area != NULL; area = NEXT_AREA(area), i = 0) {
             n_free = 0;
-            for (i = area->gc_last_free_atb_index * BLOCKS_PER_ATB; i < area->gc_alloc_table_byte_len * BLOCKS_PER_ATB; i++) {
+            // Multi-block allocations skip the single free blocks between live
+            // objects, otherwise they are rescanned every time, which is slow
+            // when lots of 2-block objects (eg complex numbers and 3-tuples on
+            // 32-bit targets) are allocated.
+            size_t start_atb = area->gc_last_free_atb_index;
+            if (n_blocks > 1 && start_atb < area->gc_last_free_run_atb_index) {
+                start_atb = area->gc_last_free_run_atb_index;
+            }
+            for (i = start_atb * BLOCKS_PER_ATB; i < area->gc_alloc_table_byte_len * BLOCKS_PER_ATB; i++) {
                 MICROPY_GC_HOOK_LOOP(i);
                 // *FORMAT-OFF*
                 if (ATB_GET_KIND(area, i) == AT_FREE) { if (++n_free >= n_blocks) { goto found; } } else { n_free = 0; }
@@ -828,6 +847,8 @@ void *gc_alloc(size_t n_bytes, unsigned int alloc_flags) {
             #if MICROPY_GC_SPLIT_HEAP
             if (n_blocks == 1) {
                 area->gc_last_free_atb_index = (i + 1) / BLOCKS_PER_ATB; // or (size_t)-1
+            } else if (n_blocks == 2) {
+                area->gc_last_free_run_atb_index = (i + 1) / BLOCKS_PER_ATB;
             }
             #endif
         }
@@ -865,6 +886,10 @@ found:
         MP_STATE_MEM(gc_last_free_area) = area;
         #endif
         area->gc_last_free_atb_index = (i + 1) / BLOCKS_PER_ATB;
+    } else if (n_blocks == 2) {
+        // Likewise, when looking for 2 blocks there are no runs of 2 free
+        // blocks before this one.
+        area->gc_last_free_run_atb_index = (i + 1) / BLOCKS_PER_ATB;
     }
 
     area->gc_last_used_block = MAX(area->gc_last_used_block, end_block);
@@ -918,6 +943,10 @@ found:
     gc_dump_alloc_table(&mp_plat_print);
     #endif
 
+    #if MICROPY_PY_MICROPYTHON_ALLOC_PROFILE
+    mp_alloc_profile_alloc(ret_ptr, n_bytes);
+    #endif
+
     return ret_ptr;
 }
 
@@ -981,6 +1010,11 @@ void gc_free(void *ptr) {
     if (block / BLOCKS_PER_ATB < area->gc_last_free_atb_index) {
         area->gc_last_free_atb_index = block / BLOCKS_PER_ATB;
     }
+    // and the last_free_run pointer to the block before, which may also be free
+    size_t run_atb = (block > 0 ? block - 1 : 0) / BLOCKS_PER_ATB;
+    if (run_atb < area->gc_last_free_run_atb_index) {
+        area->gc_last_free_run_atb_index = run_atb;
+    }
 
     // free head and all of its tail blocks
     do {
@@ -990,6 +1024,10 @@ void gc_free(void *ptr) {
 
     GC_EXIT();
 
+    #if MICROPY_PY_MICROPYTHON_ALLOC_PROFILE
+    mp_alloc_profile_free(ptr);
+    #endif
+
     #if EXTENSIVE_HEAP_PROFILING
     gc_dump_alloc_table(&mp_plat_print);
     #endif
@@ -1112,6 +1150,9 @@ void *gc_realloc(void *ptr_in, size_t n_bytes, bool allow_move) {
         if ((block + new_blocks) / BLOCKS_PER_ATB < area->gc_last_free_atb_index) {
             area->gc_last_free_atb_index = (block + new_blocks) / BLOCKS_PER_ATB;
         }
+        if ((block + new_blocks) / BLOCKS_PER_ATB < area->gc_last_free_run_atb_index) {
+            area->gc_last_free_run_atb_index = (block + new_blocks) / BLOCKS_PER_ATB;
+        }
 
         GC_EXIT();
 
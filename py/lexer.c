@@ -131,6 +131,15 @@ static bool is_tail_of_identifier(mp_lexer_t *lex) {
     return is_head_of_identifier(lex) || is_digit(lex);
 }
 
+static unichar read_byte(mp_lexer_t *lex) {
+    #if MICROPY_OPT_LEXER_MEM_READER
+    if (lex->src_end) {
+        return lex->src_cur < lex->src_end ? *lex->src_cur++ : MP_LEXER_EOF;
+    }
+    #endif
+    return lex->reader.readbyte(lex->reader.data);
+}
+
 static void next_char(mp_lexer_t *lex) {
     if (lex->chr0 == '\n') {
         // a new line
@@ -171,7 +180,7 @@ static void next_char(mp_lexer_t *lex) {
     } else
     #endif
     {
-        lex->chr2 = lex->reader.readbyte(lex->reader.data);
+        lex->chr2 = read_byte(lex);
     }
 
     if (lex->chr1 == '\r') {
@@ -179,7 +188,7 @@ static void next_char(mp_lexer_t *lex) {
         lex->chr1 = '\n';
         if (lex->chr2 == '\n') {
             // CR LF is a single new line, throw out the extra LF
-            lex->chr2 = lex->reader.readbyte(lex->reader.data);
+            lex->chr2 = read_byte(lex);
         }
     }
 
@@ -189,6 +198,37 @@ static void next_char(mp_lexer_t *lex) {
     }
 }
 
+#if MICROPY_OPT_LEXER_MEM_READER
+
+// Whether the source is in memory and the bytes following chr2 come straight from it.
+static bool is_mem_window(mp_lexer_t *lex) {
+    #if MICROPY_PY_FSTRINGS
+    if (lex->fstring_args_idx) {
+        return false;
+    }
+    #endif
+    return lex->src_end != NULL;
+}
+
+static bool is_ident_byte(unichar c) {
+    return ((c | 0x20) - 'a' < 26) || (c - '0' < 10) || c == '_' || (c >= 0x80 && c < 0x100);
+}
+
+// Skip chr0, chr1, chr2 and the n bytes following them in memory, all of which must be
+// characters worth one column on the current line.
+static void skip_mem_run(mp_lexer_t *lex, size_t n) {
+    lex->src_cur += n;
+    lex->column += n;
+    // Reload the input queue using next_char() for proper EOL/EOF handling, starting with
+    // dummy bytes that account for the three skipped characters.
+    lex->chr0 = lex->chr1 = lex->chr2 = ' ';
+    next_char(lex);
+    next_char(lex);
+    next_char(lex);
+}
+
+#endif
+
 static void indent_push(mp_lexer_t *lex, size_t indent) {
     if (lex->num_indent_level >= lex->alloc_indent_level) {
         lex->indent_level = m_renew(uint16_t, lex->indent_level, lex->alloc_indent_level, lex->alloc_indent_level + MICROPY_ALLOC_LEXEL_INDENT_INC);
@@ -540,9 +580,38 @@ static bool skip_whitespace(mp_lexer_t *lex, bool stop_at_newline) {
             }
             next_char(lex);
         } else if (is_whitespace(lex)) {
+            #if MICROPY_OPT_LEXER_MEM_READER
+            if (is_mem_window(lex) && lex->chr0 == ' ' && lex->chr1 == ' ' && lex->chr2 == ' ') {
+                // skip a run of spaces, eg indentation, in place
+                const byte *p = lex->src_cur;
+                while (p < lex->src_end && *p == ' ') {
+                    ++p;
+                }
+                skip_mem_run(lex, p - lex->src_cur);
+                continue;
+            }
+            #endif
             next_char(lex);
         } else if (is_char(lex, '#')) {
             next_char(lex);
+            #if MICROPY_OPT_LEXER_MEM_READER
+            if (is_mem_window(lex) && !is_end(lex) && !is_physical_newline(lex)
+                && lex->chr1 != MP_LEXER_EOF && lex->chr1 != '\n'
+                && lex->chr2 != MP_LEXER_EOF && lex->chr2 != '\n' && lex->chr2 != '\r') {
+                // skip the comment in place up to the end of the line; columns don't matter
+                // here because the newline resets them
+                size_t len = lex->src_end - lex->src_cur;
+                const byte *p = memchr(lex->src_cur, '\n', len);
+                if (p) {
+                    len = p - lex->src_cur;
+                }
+                p = memchr(lex->src_cur, '\r', len);
+                if (p) {
+                    len = p - lex->src_cur;
+                }
+                skip_mem_run(lex, len);
+            }
+            #endif
             while (!is_end(lex) && !is_physical_newline(lex)) {
                 next_char(lex);
             }
@@ -709,6 +778,21 @@ void mp_lexer_to_next(mp_lexer_t *lex) {
 
         // get tail chars
         while (!is_end(lex) && is_tail_of_identifier(lex)) {
+            #if MICROPY_OPT_LEXER_MEM_READER
+            if (is_mem_window(lex) && is_ident_byte(lex->chr1) && is_ident_byte(lex->chr2)) {
+                // scan the rest of the identifier in place
+                const byte *p = lex->src_cur;
+                while (p < lex->src_end && is_ident_byte(*p)) {
+                    ++p;
+                }
+                vstr_add_byte(&lex->vstr, lex->chr0);
+                vstr_add_byte(&lex->vstr, lex->chr1);
+                vstr_add_byte(&lex->vstr, lex->chr2);
+                vstr_add_strn(&lex->vstr, (const char *)lex->src_cur, p - lex->src_cur);
+                skip_mem_run(lex, p - lex->src_cur);
+                continue;
+            }
+            #endif
             vstr_add_byte(&lex->vstr, CUR_CHAR(lex));
             next_char(lex);
         }
@@ -848,6 +932,11 @@ mp_lexer_t *mp_lexer_new(qstr src_name, mp_reader_t reader) {
 
     lex->source_name = src_name;
     lex->reader = reader;
+    #if MICROPY_OPT_LEXER_MEM_READER
+    size_t src_len;
+    lex->src_cur = mp_reader_try_read_mem(&lex->reader, &src_len);
+    lex->src_end = lex->src_cur ? lex->src_cur + src_len : NULL;
+    #endif
     lex->line = 1;
     lex->column = (size_t)-2; // account for 3 dummy bytes
     lex->emit_dent = 0;
@@ -163,6 +163,10 @@ typedef struct _mp_lexer_t {
     mp_reader_t reader;         // stream source
 
     unichar chr0, chr1, chr2;   // current cached characters from source
+    #if MICROPY_OPT_LEXER_MEM_READER
+    const byte *src_cur;        // next byte from source, if it is in memory
+    const byte *src_end;        // end of source, or NULL if not in memory
+    #endif
     #if MICROPY_PY_FSTRINGS
     unichar chr0_saved, chr1_saved, chr2_saved; // current cached characters from alt source
     #endif
@@ -328,10 +328,21 @@ RE_NO_ESCAPE = re.compile(r"^[a-zA-Z0-9_]$")
 
 
 # this must match the equivalent function in qstr.c
-def compute_hash(qstr, bytes_hash):
-    hash = 5381
-    for b in qstr:
-        hash = (hash * 33) ^ b
+def compute_hash(qstr, bytes_hash, wordwise=False):
+    if wordwise:
+        # this must match qstr_compute_hash with MICROPY_QSTR_HASH_WORDWISE
+        k = 0x9E3779B97F4A7C15
+        m = (1 << 64) - 1
+        hash = len(qstr)
+        for i in range(0, len(qstr), 8):
+            hash = ((hash ^ int.from_bytes(qstr[i : i + 8], "little")) * k) & m
+            hash = ((hash << 31) | (hash >> 33)) & m
+        hash = (hash * k) & m
+        hash ^= hash >> 32
+    else:
+        hash = 5381
+        for b in qstr:
+            hash = (hash * 33) ^ b
     # Make sure that valid hash is never zero, zero means "hash not computed"
     # if bytes_hash is zero, assume a 16-bit mask (to match qstr.c)
     return (hash & ((1 << (8 * (bytes_hash or 2))) - 1)) or 1
@@ -415,10 +426,10 @@ def escape_bytes(qstr, qbytes):
         return "".join(("\\x%02x" % b) for b in qbytes)
 
 
-def make_bytes(cfg_bytes_len, cfg_bytes_hash, qstr):
+def make_bytes(cfg_bytes_len, cfg_bytes_hash, cfg_hash_wordwise, qstr):
     qbytes = bytes_cons(qstr, "utf8")
     qlen = len(qbytes)
-    qhash = compute_hash(qbytes, cfg_bytes_hash)
+    qhash = compute_hash(qbytes, cfg_bytes_hash, cfg_hash_wordwise)
     if qlen >= (1 << (8 * cfg_bytes_len)):
         print("qstr is too long:", qstr)
         assert False
@@ -430,6 +441,7 @@ def print_qstr_data(qcfgs, qstrs):
     # get config variables
     cfg_bytes_len = int(qcfgs["BYTES_IN_LEN"])
     cfg_bytes_hash = int(qcfgs["BYTES_IN_HASH"])
+    cfg_hash_wordwise = bool(int(qcfgs.get("HASH_WORDWISE", "0")))
 
     # print out the starter of the generated C header file
     print("// This file was automatically generated by makeqstrdata.py")
@@ -440,13 +452,13 @@ def print_qstr_data(qcfgs, qstrs):
 
     # add static qstrs to the first unsorted pool
     for qstr in static_qstr_list:
-        qbytes = make_bytes(cfg_bytes_len, cfg_bytes_hash, qstr)
+        qbytes = make_bytes(cfg_bytes_len, cfg_bytes_hash, cfg_hash_wordwise, qstr)
         print("QDEF0(MP_QSTR_%s, %s)" % (qstr_escape(qstr), qbytes))
 
     # add remaining qstrs to the sorted (by value) pool (unless they're in
     # unsorted_qstr_list, in which case add them to the unsorted pool)
     for ident, qstr in sorted(qstrs.values(), key=lambda x: x[1]):
-        qbytes = make_bytes(cfg_bytes_len, cfg_bytes_hash, qstr)
+        qbytes = make_bytes(cfg_bytes_len, cfg_bytes_hash, cfg_hash_wordwise, qstr)
         pool = 0 if qstr in unsorted_qstr_list else 1
         print("QDEF%d(MP_QSTR_%s, %s)" % (pool, ident, qbytes))
 
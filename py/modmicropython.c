@@ -32,6 +32,10 @@
 #include "py/runtime.h"
 #include "py/gc.h"
 #include "py/mphal.h"
+#include "py/allocprof.h"
+#include "py/profsample.h"
+#include "py/vmstats.h"
+#include "py/stream.h"
 
 #if MICROPY_FREERTOS
 #include "FreeRTOS.h"
@@ -308,6 +312,90 @@ static mp_obj_t mp_micropython_schedule(mp_obj_t function, mp_obj_t arg) {
 static MP_DEFINE_CONST_FUN_OBJ_2(mp_micropython_schedule_obj, mp_micropython_schedule);
 #endif
 
+#if MICROPY_PY_MICROPYTHON_PROFILE
+static mp_obj_t mp_micropython_profile_start(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_period, ARG_samples };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_period, MP_ARG_INT, {.u_int = 1} },
+        { MP_QSTR_samples, MP_ARG_INT, {.u_int = 128} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    if ((args[ARG_period].u_int <= 0) || (args[ARG_samples].u_int <= 0)) {
+        mp_raise_ValueError(NULL);
+    }
+    mp_profile_start(args[ARG_period].u_int, args[ARG_samples].u_int);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(mp_micropython_profile_start_obj, 0, mp_micropython_profile_start);
+
+static mp_obj_t mp_micropython_profile_stop(void) {
+    mp_profile_stop();
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(mp_micropython_profile_stop_obj, mp_micropython_profile_stop);
+
+static mp_obj_t mp_micropython_profile_dump(size_t n_args, const mp_obj_t *args) {
+    mp_print_t print = mp_plat_print;
+    if ((n_args > 0) && (args[0] != mp_const_none)) {
+        mp_get_stream_raise(args[0], MP_STREAM_OP_WRITE);
+        print.data = MP_OBJ_TO_PTR(args[0]);
+        print.print_strn = mp_stream_write_adaptor;
+    }
+    mp_profile_dump(&print);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_profile_dump_obj, 0, 1, mp_micropython_profile_dump);
+#endif
+
+#if MICROPY_PY_MICROPYTHON_ALLOC_PROFILE
+static mp_obj_t mp_micropython_alloc_profile_start(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_interval, ARG_sites, ARG_track };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_interval, MP_ARG_INT, {.u_int = 256} },
+        { MP_QSTR_sites, MP_ARG_INT, {.u_int = 32} },
+        { MP_QSTR_track, MP_ARG_INT, {.u_int = 64} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    if ((args[ARG_interval].u_int <= 0) || (args[ARG_sites].u_int <= 0) || (args[ARG_track].u_int <= 0)) {
+        mp_raise_ValueError(NULL);
+    }
+    mp_alloc_profile_start(args[ARG_interval].u_int, args[ARG_sites].u_int, args[ARG_track].u_int);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(mp_micropython_alloc_profile_start_obj, 0, mp_micropython_alloc_profile_start);
+
+static mp_obj_t mp_micropython_alloc_profile_stop(void) {
+    mp_alloc_profile_stop();
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(mp_micropython_alloc_profile_stop_obj, mp_micropython_alloc_profile_stop);
+
+static mp_obj_t mp_micropython_alloc_profile_dump(size_t n_args, const mp_obj_t *args) {
+    mp_print_t print = mp_plat_print;
+    if ((n_args > 0) && (args[0] != mp_const_none)) {
+        mp_get_stream_raise(args[0], MP_STREAM_OP_WRITE);
+        print.data = MP_OBJ_TO_PTR(args[0]);
+        print.print_strn = mp_stream_write_adaptor;
+    }
+    mp_alloc_profile_dump(&print);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_alloc_profile_dump_obj, 0, 1, mp_micropython_alloc_profile_dump);
+#endif
+
+#if MICROPY_PY_MICROPYTHON_VM_STATS
+static mp_obj_t mp_micropython_vm_stats(size_t n_args, const mp_obj_t *args) {
+    mp_obj_t stats = mp_vm_stats_get();
+    if ((n_args > 0) && mp_obj_is_true(args[0])) {
+        mp_vm_stats_reset();
+    }
+    return stats;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_vm_stats_obj, 0, 1, mp_micropython_vm_stats);
+#endif
+
 static const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_micropython) },
     { MP_ROM_QSTR(MP_QSTR_const), MP_ROM_PTR(&mp_identity_obj) },
@@ -358,6 +446,25 @@ static const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     #if MICROPY_PY_MICROPYTHON_RINGIO
     { MP_ROM_QSTR(MP_QSTR_RingIO), MP_ROM_PTR(&mp_type_ringio) },
     #endif
+    #if MICROPY_PY_MICROPYTHON_RINGBUFFER
+    { MP_ROM_QSTR(MP_QSTR_RingBuffer), MP_ROM_PTR(&mp_type_ringbuffer) },
+    #endif
+    #if MICROPY_PY_MICROPYTHON_STRINGBUILDER
+    { MP_ROM_QSTR(MP_QSTR_StringBuilder), MP_ROM_PTR(&mp_type_stringbuilder) },
+    #endif
+    #if MICROPY_PY_MICROPYTHON_PROFILE
+    { MP_ROM_QSTR(MP_QSTR_profile_start), MP_ROM_PTR(&mp_micropython_profile_start_obj) },
+    { MP_ROM_QSTR(MP_QSTR_profile_stop), MP_ROM_PTR(&mp_micropython_profile_stop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_profile_dump), MP_ROM_PTR(&mp_micropython_profile_dump_obj) },
+    #endif
+    #if MICROPY_PY_MICROPYTHON_ALLOC_PROFILE
+    { MP_ROM_QSTR(MP_QSTR_alloc_profile_start), MP_ROM_PTR(&mp_micropython_alloc_profile_start_obj) },
+    { MP_ROM_QSTR(MP_QSTR_alloc_profile_stop), MP_ROM_PTR(&mp_micropython_alloc_profile_stop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_alloc_profile_dump), MP_ROM_PTR(&mp_micropython_alloc_profile_dump_obj) },
+    #endif
+    #if MICROPY_PY_MICROPYTHON_VM_STATS
+    { MP_ROM_QSTR(MP_QSTR_vm_stats), MP_ROM_PTR(&mp_micropython_vm_stats_obj) },
+    #endif
     #if MICROPY_ENABLE_SCHEDULER
     { MP_ROM_QSTR(MP_QSTR_schedule), MP_ROM_PTR(&mp_micropython_schedule_obj) },
     #endif
@@ -257,6 +257,230 @@ static mp_obj_t struct_pack_into(size_t n_args, const mp_obj_t *args) {
 }
 MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_pack_into_obj, 3, MP_OBJ_FUN_ARGS_MAX, struct_pack_into);
 
+#if MICROPY_PY_STRUCT_STRUCT
+
+// struct.Struct parses its format once into an array of fields, each being
+// a run of values of one type (or an "s" string) at a precomputed, already
+// aligned, offset into the packed data.  Padding is not stored as a field.
+
+typedef struct _struct_field_t {
+    char type;
+    size_t count;
+    size_t offset;
+} struct_field_t;
+
+typedef struct _mp_obj_struct_t {
+    mp_obj_base_t base;
+    mp_obj_t format;
+    char fmt_type;
+    size_t size;
+    size_t num_items;
+    size_t num_fields;
+    struct_field_t fields[];
+} mp_obj_struct_t;
+
+// Parse fmt (after its byte order character) and return the number of fields,
+// storing them in `fields` if it's not NULL.
+static size_t struct_compile(const char *fmt, char fmt_type, struct_field_t *fields, size_t *total_sz, size_t *num_items) {
+    size_t num_fields = 0;
+    size_t size = 0;
+    *num_items = 0;
+    for (; *fmt; fmt++) {
+        mp_uint_t cnt = 1;
+        if (unichar_isdigit(*fmt)) {
+            cnt = get_fmt_num(&fmt);
+        }
+        if (*fmt == 'x') {
+            size += cnt;
+            continue;
+        }
+        size_t offset = size;
+        if (*fmt == 's') {
+            *num_items += 1;
+            size += cnt;
+        } else {
+            *num_items += cnt;
+            size_t align;
+            size_t sz = mp_binary_get_size(fmt_type, *fmt, &align);
+            offset = (size + align - 1) & ~(align - 1);
+            if (cnt > 0) {
+                size = offset + cnt * sz;
+            }
+        }
+        if (fields != NULL) {
+            fields[num_fields].type = *fmt;
+            fields[num_fields].count = cnt;
+            fields[num_fields].offset = offset;
+        }
+        ++num_fields;
+    }
+    *total_sz = size;
+    return num_fields;
+}
+
+static mp_obj_t struct_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 1, false);
+    const char *fmt = mp_obj_str_get_str(args[0]);
+    char fmt_type = get_fmt_type(&fmt);
+    size_t size, num_items;
+    size_t num_fields = struct_compile(fmt, fmt_type, NULL, &size, &num_items);
+    mp_obj_struct_t *self = mp_obj_malloc_var(mp_obj_struct_t, fields, struct_field_t, num_fields, type);
+    self->format = args[0];
+    self->fmt_type = fmt_type;
+    self->size = size;
+    self->num_items = num_items;
+    self->num_fields = struct_compile(fmt, fmt_type, self->fields, &size, &num_items);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+// Return a pointer to `size` bytes at `offset` into the buffer, where a
+// negative offset is relative to the end of the buffer.
+static byte *struct_get_buf(mp_obj_t buf_in, mp_int_t offset, size_t size, mp_uint_t flags) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, flags);
+    if (offset < 0) {
+        offset += bufinfo.len;
+    }
+    if (offset < 0 || (size_t)offset + size > bufinfo.len) {
+        mp_raise_ValueError(MP_ERROR_TEXT("buffer too small"));
+    }
+    return (byte *)bufinfo.buf + offset;
+}
+
+static mp_obj_t struct_obj_unpack_at(mp_obj_struct_t *self, byte *p) {
+    mp_obj_tuple_t *res = MP_OBJ_TO_PTR(mp_obj_new_tuple(self->num_items, NULL));
+    mp_obj_t *item = res->items;
+    for (size_t i = 0; i < self->num_fields; ++i) {
+        const struct_field_t *f = &self->fields[i];
+        byte *q = p + f->offset;
+        if (f->type == 's') {
+            *item++ = mp_obj_new_bytes(q, f->count);
+        } else {
+            for (size_t j = f->count; j > 0; --j) {
+                *item++ = mp_binary_get_val(self->fmt_type, f->type, p, &q);
+            }
+        }
+    }
+    return MP_OBJ_FROM_PTR(res);
+}
+
+// As with the module-level functions, missing values are left as zeros and extra ones are ignored.
+static void struct_obj_pack_at(mp_obj_struct_t *self, byte *p, size_t n_args, const mp_obj_t *args) {
+    memset(p, 0, self->size);
+    size_t i = 0;
+    for (size_t k = 0; k < self->num_fields && i < n_args; ++k) {
+        const struct_field_t *f = &self->fields[k];
+        byte *q = p + f->offset;
+        if (f->type == 's') {
+            mp_buffer_info_t bufinfo;
+            mp_get_buffer_raise(args[i++], &bufinfo, MP_BUFFER_READ);
+            memcpy(q, bufinfo.buf, MIN(bufinfo.len, f->count));
+        } else {
+            for (size_t j = f->count; j > 0 && i < n_args; --j) {
+                mp_binary_set_val(self->fmt_type, f->type, args[i++], p, &q);
+            }
+        }
+    }
+}
+
+static mp_obj_t struct_obj_pack(size_t n_args, const mp_obj_t *args) {
+    mp_obj_struct_t *self = MP_OBJ_TO_PTR(args[0]);
+    vstr_t vstr;
+    vstr_init_len(&vstr, self->size);
+    struct_obj_pack_at(self, (byte *)vstr.buf, n_args - 1, args + 1);
+    return mp_obj_new_bytes_from_vstr(&vstr);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_obj_pack_obj, 1, MP_OBJ_FUN_ARGS_MAX, struct_obj_pack);
+
+static mp_obj_t struct_obj_pack_into(size_t n_args, const mp_obj_t *args) {
+    mp_obj_struct_t *self = MP_OBJ_TO_PTR(args[0]);
+    byte *p = struct_get_buf(args[1], mp_obj_get_int(args[2]), self->size, MP_BUFFER_WRITE);
+    struct_obj_pack_at(self, p, n_args - 3, args + 3);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_obj_pack_into_obj, 3, MP_OBJ_FUN_ARGS_MAX, struct_obj_pack_into);
+
+static mp_obj_t struct_obj_unpack_from(size_t n_args, const mp_obj_t *args) {
+    // Like the module-level unpack, the buffer only needs to be big enough.
+    mp_obj_struct_t *self = MP_OBJ_TO_PTR(args[0]);
+    mp_int_t offset = n_args > 2 ? mp_obj_get_int(args[2]) : 0;
+    return struct_obj_unpack_at(self, struct_get_buf(args[1], offset, self->size, MP_BUFFER_READ));
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(struct_obj_unpack_from_obj, 2, 3, struct_obj_unpack_from);
+
+typedef struct _mp_obj_struct_it_t {
+    mp_obj_base_t base;
+    mp_fun_1_t iternext;
+    mp_obj_struct_t *st;
+    mp_obj_t buf;
+    size_t offset;
+} mp_obj_struct_it_t;
+
+static mp_obj_t struct_it_iternext(mp_obj_t self_in) {
+    mp_obj_struct_it_t *self = MP_OBJ_TO_PTR(self_in);
+    // Get the buffer each time because it may have been resized
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(self->buf, &bufinfo, MP_BUFFER_READ);
+    if (self->offset + self->st->size > bufinfo.len) {
+        return MP_OBJ_STOP_ITERATION;
+    }
+    mp_obj_t res = struct_obj_unpack_at(self->st, (byte *)bufinfo.buf + self->offset);
+    self->offset += self->st->size;
+    return res;
+}
+
+static mp_obj_t struct_obj_iter_unpack(mp_obj_t self_in, mp_obj_t buf_in) {
+    mp_obj_struct_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(buf_in, &bufinfo, MP_BUFFER_READ);
+    if (self->size == 0 || bufinfo.len % self->size != 0) {
+        mp_raise_ValueError(MP_ERROR_TEXT("buffer size must be a multiple of struct size"));
+    }
+    mp_obj_struct_it_t *it = mp_obj_malloc(mp_obj_struct_it_t, &mp_type_polymorph_iter);
+    it->iternext = struct_it_iternext;
+    it->st = self;
+    it->buf = buf_in;
+    it->offset = 0;
+    return MP_OBJ_FROM_PTR(it);
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(struct_obj_iter_unpack_obj, struct_obj_iter_unpack);
+
+static void struct_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
+    if (dest[0] != MP_OBJ_NULL) {
+        // not load attribute
+        return;
+    }
+    mp_obj_struct_t *self = MP_OBJ_TO_PTR(self_in);
+    if (attr == MP_QSTR_format) {
+        dest[0] = self->format;
+    } else if (attr == MP_QSTR_size) {
+        dest[0] = MP_OBJ_NEW_SMALL_INT(self->size);
+    } else {
+        // continue lookup in locals_dict
+        dest[1] = MP_OBJ_SENTINEL;
+    }
+}
+
+static const mp_rom_map_elem_t struct_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_pack), MP_ROM_PTR(&struct_obj_pack_obj) },
+    { MP_ROM_QSTR(MP_QSTR_pack_into), MP_ROM_PTR(&struct_obj_pack_into_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack), MP_ROM_PTR(&struct_obj_unpack_from_obj) },
+    { MP_ROM_QSTR(MP_QSTR_unpack_from), MP_ROM_PTR(&struct_obj_unpack_from_obj) },
+    { MP_ROM_QSTR(MP_QSTR_iter_unpack), MP_ROM_PTR(&struct_obj_iter_unpack_obj) },
+};
+static MP_DEFINE_CONST_DICT(struct_locals_dict, struct_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    mp_type_struct,
+    MP_QSTR_Struct,
+    MP_TYPE_FLAG_NONE,
+    make_new, struct_make_new,
+    attr, struct_attr,
+    locals_dict, &struct_locals_dict
+    );
+
+#endif // MICROPY_PY_STRUCT_STRUCT
+
 static const mp_rom_map_elem_t mp_module_struct_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_struct) },
     { MP_ROM_QSTR(MP_QSTR_calcsize), MP_ROM_PTR(&struct_calcsize_obj) },
@@ -264,6 +488,9 @@ static const mp_rom_map_elem_t mp_module_struct_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR_pack_into), MP_ROM_PTR(&struct_pack_into_obj) },
     { MP_ROM_QSTR(MP_QSTR_unpack), MP_ROM_PTR(&struct_unpack_from_obj) },
     { MP_ROM_QSTR(MP_QSTR_unpack_from), MP_ROM_PTR(&struct_unpack_from_obj) },
+    #if MICROPY_PY_STRUCT_STRUCT
+    { MP_ROM_QSTR(MP_QSTR_Struct), MP_ROM_PTR(&mp_type_struct) },
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(mp_module_struct_globals, mp_module_struct_globals_table);
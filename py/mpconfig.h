@@ -380,6 +380,13 @@ typedef uint64_t mp_uint_t;
 #endif
 #endif
 
+// Whether to hash qstrs and str/bytes objects 8 bytes at a time instead of using
+// the bytewise djb2 hash. This is much faster for long strings but needs a fast
+// 64-bit multiply, so should only be enabled on 64-bit targets.
+#ifndef MICROPY_QSTR_HASH_WORDWISE
+#define MICROPY_QSTR_HASH_WORDWISE (0)
+#endif
+
 // Avoid using C stack when making Python function calls. C stack still
 // may be used if there's no free heap.
 #ifndef MICROPY_STACKLESS
@@ -411,6 +418,24 @@ typedef uint64_t mp_uint_t;
 #define MICROPY_PERSISTENT_CODE_LOAD (0)
 #endif
 
+// Whether mp_raw_code_load_file and the bytecode cache memory-map .mpy files
+// with the POSIX mmap function, so that their bytecode and constant data is
+// used in place rather than copied to the heap. Mapped files are never
+// unmapped, even if loading fails, because interned strings may already point
+// into them. A loaded .mpy file must therefore not be modified for the rest of
+// the process: truncating or rewriting it in place (as mpy-cross does) makes
+// the next access to its code fail with SIGBUS. Replacing it with rename() or
+// deleting it is safe, and the bytecode cache is always replaced that way.
+#ifndef MICROPY_PERSISTENT_CODE_LOAD_MMAP
+#define MICROPY_PERSISTENT_CODE_LOAD_MMAP (0)
+#endif
+
+// Whether to reference the bytecode and constant data of persistent code in
+// place when it is loaded from ROM or memory-mapped data
+#ifndef MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
+#define MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE (MICROPY_VFS_ROM || MICROPY_PERSISTENT_CODE_LOAD_MMAP)
+#endif
+
 // Whether to support saving of persistent code, i.e. for mpy-cross to
 // generate .mpy files. Enabling this enables additional metadata on raw code
 // objects which is also required for sys.settrace.
@@ -566,6 +591,14 @@ typedef uint64_t mp_uint_t;
 #define MICROPY_COMP_CONST_LITERAL (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
 #endif
 
+// Whether to enable extra constant folding (when MICROPY_COMP_CONST_FOLDING and
+// MICROPY_COMP_CONST_TUPLE are also enabled): comparisons like 1 < 2, conditional
+// expressions with a constant condition, and lists of constants that are only
+// iterated over or tested for membership, which become constant tuples
+#ifndef MICROPY_COMP_CONST_FOLDING_EXTRA
+#define MICROPY_COMP_CONST_FOLDING_EXTRA (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES && MICROPY_COMP_CONST_TUPLE)
+#endif
+
 // Whether to enable lookup of constants in modules; eg module.CONST
 #ifndef MICROPY_COMP_MODULE_CONST
 #define MICROPY_COMP_MODULE_CONST (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
@@ -685,6 +718,13 @@ typedef uint64_t mp_uint_t;
 #endif
 
 
+// Whether the lexer reads sources that are in memory (eg strings and ROM files) directly,
+// rather than byte by byte through the reader, and scans runs of identifier characters,
+// spaces and comments in place.
+#ifndef MICROPY_OPT_LEXER_MEM_READER
+#define MICROPY_OPT_LEXER_MEM_READER (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 // Whether math.factorial is large, fast and recursive (1) or small and slow (0).
 #ifndef MICROPY_OPT_MATH_FACTORIAL
 #define MICROPY_OPT_MATH_FACTORIAL (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
@@ -961,6 +1001,13 @@ typedef double mp_float_t;
 #define MICROPY_PY_BUILTINS_COMPLEX (MICROPY_PY_BUILTINS_FLOAT)
 #endif
 
+// Whether viper code supports a native "float" type, held unboxed in a machine
+// register and operated on with the target's floating point instructions
+// (currently x64 SSE2 only, which requires mp_float_t to fit in a machine word)
+#ifndef MICROPY_EMIT_NATIVE_FLOAT
+#define MICROPY_EMIT_NATIVE_FLOAT (MICROPY_EMIT_X64 && MICROPY_PY_BUILTINS_FLOAT && !MICROPY_DYNAMIC_COMPILER)
+#endif
+
 // Float to string conversion implementations
 //
 // Note that the EXACT method is only available if the compiler supports
@@ -982,6 +1029,22 @@ typedef double mp_float_t;
 #endif
 #endif
 
+// Whether repr(float) finds the shortest round-trip digits with integer-only
+// Grisu3, falling back to MICROPY_FLOAT_FORMAT_IMPL for the rare values it
+// can't decide (adds a 700 byte table). Not used with REPR_C, whose floats have
+// lost their lowest bits and so may not have a short round-trip form.
+#ifndef MICROPY_FLOAT_FORMAT_SHORTEST
+#define MICROPY_FLOAT_FORMAT_SHORTEST (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES && MICROPY_OBJ_REPR != MICROPY_OBJ_REPR_C)
+#endif
+
+// Whether float parsing uses the exact fast path and the Eisel-Lemire algorithm
+// to produce correctly rounded results without floating point arithmetic, falling
+// back to the generic method for ambiguous inputs (adds a 10k byte table for
+// double precision, 1.7k for single)
+#ifndef MICROPY_FLOAT_PARSE_EISEL_LEMIRE
+#define MICROPY_FLOAT_PARSE_EISEL_LEMIRE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 // Whether to use the native _Float16 for 16-bit float support
 #ifndef MICROPY_FLOAT_USE_NATIVE_FLT16
 #ifdef __FLT16_MAX__
@@ -1093,6 +1156,13 @@ typedef time_t mp_timestamp_t;
 #define MICROPY_MODULE___FILE__ (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
 #endif
 
+// Whether to cache the compiled bytecode of imported .py files as .mpy files
+// in a __pycache__ directory next to the source, and load them instead of
+// recompiling while the source is unchanged. Requires the POSIX file API.
+#ifndef MICROPY_MODULE_BYTECODE_CACHE
+#define MICROPY_MODULE_BYTECODE_CACHE (0)
+#endif
+
 // Whether modules can use MP_REGISTER_MODULE_DELEGATION() to delegate failed
 // attribute lookups to a custom handler function.
 #ifndef MICROPY_MODULE_ATTR_DELEGATION
@@ -1555,6 +1625,52 @@ typedef time_t mp_timestamp_t;
 #define MICROPY_PY_MICROPYTHON_RINGIO (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// Support for micropython.RingBuffer(), a lock-free SPSC ring shared between threads
+#ifndef MICROPY_PY_MICROPYTHON_RINGBUFFER
+#define MICROPY_PY_MICROPYTHON_RINGBUFFER (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// Support for micropython.StringBuilder(), for building a str or bytes in one buffer
+#ifndef MICROPY_PY_MICROPYTHON_STRINGBUILDER
+#define MICROPY_PY_MICROPYTHON_STRINGBUILDER (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// Whether to provide the "micropython.profile_*" functions for statistical profiling
+// Samples are taken by a timer, so ports must either use FreeRTOS or define
+// MICROPY_PY_MICROPYTHON_PROFILE_TIMER_START(period_ms) and MICROPY_PY_MICROPYTHON_PROFILE_TIMER_STOP()
+// to periodically call mp_profile_tick(). It enables MICROPY_TRACK_CODE_STATE, which adds
+// work to every bytecode call even while no profiler is running.
+#ifndef MICROPY_PY_MICROPYTHON_PROFILE
+#define MICROPY_PY_MICROPYTHON_PROFILE (0)
+#endif
+
+// Maximum number of frames recorded for each profiler sample
+#ifndef MICROPY_PY_MICROPYTHON_PROFILE_DEPTH
+#define MICROPY_PY_MICROPYTHON_PROFILE_DEPTH (8)
+#endif
+
+// Whether the VM counts executed opcodes and the calls and time spent in each bytecode
+// function, for "micropython.vm_stats()". This slows down the VM, so is intended for
+// profiling builds only.
+#ifndef MICROPY_PY_MICROPYTHON_VM_STATS
+#define MICROPY_PY_MICROPYTHON_VM_STATS (0)
+#endif
+
+// Number of distinct bytecode functions tracked by micropython.vm_stats()
+#ifndef MICROPY_PY_MICROPYTHON_VM_STATS_FUNCS
+#define MICROPY_PY_MICROPYTHON_VM_STATS_FUNCS (64)
+#endif
+
+// Whether to provide the "micropython.alloc_profile_*" functions for sampling heap allocations
+// and attributing them to the bytecode that made them. Like MICROPY_PY_MICROPYTHON_PROFILE
+// it enables MICROPY_TRACK_CODE_STATE, so is intended for profiling builds.
+#ifndef MICROPY_PY_MICROPYTHON_ALLOC_PROFILE
+#define MICROPY_PY_MICROPYTHON_ALLOC_PROFILE (0)
+#endif
+
+// Whether the VM keeps a chain of the code states of the running bytecode functions
+#define MICROPY_TRACK_CODE_STATE (MICROPY_PY_SYS_SETTRACE || MICROPY_PY_MICROPYTHON_PROFILE || MICROPY_PY_MICROPYTHON_ALLOC_PROFILE)
+
 // Whether to provide "array" module. Note that large chunk of the
 // underlying code is shared with "bytearray" builtin type, so to
 // get real savings, it should be disabled too.
@@ -1584,6 +1700,13 @@ typedef time_t mp_timestamp_t;
 #define MICROPY_PY_COLLECTIONS_DEQUE (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// Number of items per block in "collections.deque", or 0 to store the items in
+// a single circular array. With blocks, growing a deque never copies its items
+// and large deques don't need one large contiguous allocation.
+#ifndef MICROPY_PY_COLLECTIONS_DEQUE_BLOCK_LEN
+#define MICROPY_PY_COLLECTIONS_DEQUE_BLOCK_LEN (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES ? 16 : 0)
+#endif
+
 // Whether "collections.deque" supports iteration
 #ifndef MICROPY_PY_COLLECTIONS_DEQUE_ITER
 #define MICROPY_PY_COLLECTIONS_DEQUE_ITER (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
@@ -1705,6 +1828,11 @@ typedef time_t mp_timestamp_t;
 #define MICROPY_PY_STRUCT (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_CORE_FEATURES)
 #endif
 
+// Whether to provide the "struct.Struct" class, holding a pre-parsed format
+#ifndef MICROPY_PY_STRUCT_STRUCT
+#define MICROPY_PY_STRUCT_STRUCT (MICROPY_PY_STRUCT && MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 // Whether struct module provides unsafe and non-standard typecodes O, P, S.
 // These typecodes are not in CPython and can cause crashes by accessing arbitrary
 // memory.
@@ -1959,6 +2087,16 @@ typedef time_t mp_timestamp_t;
 #define MICROPY_PY_HEAPQ (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// Whether to provide heapq.PriorityQueue, with O(log n) update and removal of entries
+#ifndef MICROPY_PY_HEAPQ_PRIORITYQUEUE
+#define MICROPY_PY_HEAPQ_PRIORITYQUEUE (MICROPY_PY_HEAPQ && MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
+// Whether to provide the "arrayops" module, with elementwise operations on numeric buffers
+#ifndef MICROPY_PY_ARRAYOPS
+#define MICROPY_PY_ARRAYOPS (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 #ifndef MICROPY_PY_HASHLIB
 #define MICROPY_PY_HASHLIB (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
@@ -111,6 +111,7 @@ typedef struct _mp_state_mem_area_t {
     byte *gc_pool_end;
 
     size_t gc_last_free_atb_index;
+    size_t gc_last_free_run_atb_index; // There's no run of 2 or more free blocks before this ATB
     size_t gc_last_used_block; // The block ID of the highest block allocated in the area
 } mp_state_mem_area_t;
 
@@ -251,6 +252,20 @@ typedef struct _mp_state_vm_t {
     uint8_t sched_idx;
     #endif
 
+    #if MICROPY_PY_MICROPYTHON_PROFILE
+    // Set by the profiler timer to ask the VM to record a sample.
+    volatile bool profile_sample_pending;
+    #endif
+
+    #if MICROPY_PY_MICROPYTHON_VM_STATS
+    // Execution counts of each opcode.
+    mp_uint_t vm_stats_opcodes[256];
+    // Calls to and ticks spent in each function in the vm_stats_fun root pointer, with
+    // one extra entry for functions that didn't fit in the table.
+    mp_uint_t vm_stats_calls[MICROPY_PY_MICROPYTHON_VM_STATS_FUNCS + 1];
+    mp_uint_t vm_stats_ticks[MICROPY_PY_MICROPYTHON_VM_STATS_FUNCS + 1];
+    #endif
+
     #if MICROPY_ENABLE_VM_ABORT
     bool vm_abort;
     nlr_buf_t *nlr_abort;
@@ -310,6 +325,9 @@ typedef struct _mp_state_thread_t {
     #if MICROPY_PY_SYS_SETTRACE
     mp_obj_t prof_trace_callback;
     bool prof_callback_is_executing;
+    #endif
+
+    #if MICROPY_TRACK_CODE_STATE
     struct _mp_code_state_t *current_code_state;
     #endif
 
@@ -61,6 +61,10 @@ int mp_native_type_from_qstr(qstr qst) {
             return MP_NATIVE_TYPE_PTR16;
         case MP_QSTR_ptr32:
             return MP_NATIVE_TYPE_PTR32;
+        #if MICROPY_EMIT_NATIVE_FLOAT
+        case MP_QSTR_float:
+            return MP_NATIVE_TYPE_FLOAT;
+        #endif
         default:
             return -1;
     }
@@ -77,6 +81,17 @@ mp_uint_t mp_native_from_obj(mp_obj_t obj, mp_uint_t type) {
         case MP_NATIVE_TYPE_INT:
         case MP_NATIVE_TYPE_UINT:
             return mp_obj_get_int_truncated(obj);
+        #if MICROPY_EMIT_NATIVE_FLOAT
+        case MP_NATIVE_TYPE_FLOAT: {
+            // native floats are passed around as the bits of an mp_float_t
+            union {
+                mp_uint_t u;
+                mp_float_t f;
+            } native = { .u = 0 };
+            native.f = mp_obj_get_float(obj);
+            return native.u;
+        }
+        #endif
         default: { // cast obj to a pointer
             mp_buffer_info_t bufinfo;
             if (mp_get_buffer(obj, &bufinfo, MP_BUFFER_READ)) {
@@ -107,6 +122,15 @@ mp_obj_t mp_native_to_obj(mp_uint_t val, mp_uint_t type) {
             return mp_obj_new_int_from_uint(val);
         case MP_NATIVE_TYPE_QSTR:
             return MP_OBJ_NEW_QSTR(val);
+        #if MICROPY_EMIT_NATIVE_FLOAT
+        case MP_NATIVE_TYPE_FLOAT: {
+            union {
+                mp_uint_t u;
+                mp_float_t f;
+            } native = { .u = val };
+            return mp_obj_new_float(native.f);
+        }
+        #endif
         default: // a pointer
             // we return just the value of the pointer as an integer
             return mp_obj_new_int_from_uint(val);
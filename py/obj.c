@@ -29,6 +29,7 @@
 #include <stdarg.h>
 #include <assert.h>
 
+#include "py/allocprof.h"
 #include "py/obj.h"
 #include "py/objtype.h"
 #include "py/objint.h"
@@ -41,6 +42,9 @@
 MP_NOINLINE void *mp_obj_malloc_helper(size_t num_bytes, const mp_obj_type_t *type) {
     mp_obj_base_t *base = (mp_obj_base_t *)m_malloc(num_bytes);
     base->type = type;
+    #if MICROPY_PY_MICROPYTHON_ALLOC_PROFILE
+    mp_alloc_profile_set_type(base, type);
+    #endif
     return base;
 }
 
@@ -49,6 +53,9 @@ MP_NOINLINE void *mp_obj_malloc_helper(size_t num_bytes, const mp_obj_type_t *ty
 MP_NOINLINE void *mp_obj_malloc_with_finaliser_helper(size_t num_bytes, const mp_obj_type_t *type) {
     mp_obj_base_t *base = (mp_obj_base_t *)m_malloc_with_finaliser(num_bytes);
     base->type = type;
+    #if MICROPY_PY_MICROPYTHON_ALLOC_PROFILE
+    mp_alloc_profile_set_type(base, type);
+    #endif
     return base;
 }
 #endif
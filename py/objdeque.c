@@ -10,13 +10,165 @@
 
 typedef struct _mp_obj_deque_t {
     mp_obj_base_t base;
+    #if MICROPY_PY_COLLECTIONS_DEQUE_BLOCK_LEN
+    // Items are stored in fixed-size blocks so that growing never moves them.
+    // Position p is at map[p / BLOCK_LEN][p % BLOCK_LEN], and only blocks
+    // overlapping positions [off, off + len) are allocated.
+    mp_obj_t **map;
+    size_t map_alloc;
+    mp_obj_t *spare;
+    #else
     size_t alloc;
     mp_obj_t *items;
+    #endif
     size_t off;
     size_t len;
     int mutation;
 } mp_obj_deque_t;
 
+#if MICROPY_PY_COLLECTIONS_DEQUE_BLOCK_LEN
+#define BLOCK_LEN ((size_t)MICROPY_PY_COLLECTIONS_DEQUE_BLOCK_LEN)
+
+static void mp_obj_deque_init(mp_obj_deque_t *self) {
+    self->map = NULL;
+    self->map_alloc = 0;
+    self->spare = NULL;
+    self->off = self->len = 0;
+}
+
+static inline mp_obj_t *mp_obj_deque_get(mp_obj_deque_t *self, size_t index) {
+    index += self->off;
+    return &self->map[index / BLOCK_LEN][index % BLOCK_LEN];
+}
+
+static size_t mp_obj_deque_num_blocks(mp_obj_deque_t *self) {
+    return self->len ? (self->off + self->len - 1) / BLOCK_LEN - self->off / BLOCK_LEN + 1 : 0;
+}
+
+static mp_obj_t *mp_obj_deque_block_alloc(mp_obj_deque_t *self) {
+    mp_obj_t *block = self->spare;
+    if (block) {
+        self->spare = NULL;
+        return block;
+    }
+    return m_new0(mp_obj_t, BLOCK_LEN);
+}
+
+// Frees an empty block, keeping one spare to avoid churn when the deque
+// shrinks and grows across a block boundary.
+static void mp_obj_deque_block_free(mp_obj_deque_t *self, size_t index) {
+    mp_obj_t *block = self->map[index];
+    self->map[index] = NULL;
+    if (!self->spare) {
+        self->spare = block;
+    } else {
+        m_del(mp_obj_t, block, BLOCK_LEN);
+    }
+}
+
+// Makes room in the map for another block at the front or back, by centring
+// the allocated blocks in the map, reallocating it if more than half full.
+// Only block pointers are moved.
+static void mp_obj_deque_reserve_map(mp_obj_deque_t *self, bool front) {
+    size_t first = self->off / BLOCK_LEN;
+    size_t num_blocks = mp_obj_deque_num_blocks(self);
+    size_t new_num_blocks = num_blocks + 1;
+    mp_obj_t **map = self->map;
+    size_t map_alloc = self->map_alloc;
+    if (map_alloc < 2 * new_num_blocks) {
+        map_alloc += MAX(map_alloc, 1) + 2;
+        map = m_new0(mp_obj_t *, map_alloc);
+    }
+    size_t new_first = (map_alloc - new_num_blocks) / 2 + (front ? 1 : 0);
+    if (num_blocks) {
+        memmove(&map[new_first], &self->map[first], sizeof(mp_obj_t *) * num_blocks);
+    }
+    if (map == self->map) {
+        memset(map, 0, sizeof(mp_obj_t *) * new_first);
+        memset(&map[new_first + num_blocks], 0, sizeof(mp_obj_t *) * (map_alloc - new_first - num_blocks));
+    } else {
+        m_del(mp_obj_t *, self->map, self->map_alloc);
+        self->map = map;
+        self->map_alloc = map_alloc;
+    }
+    self->off = new_first * BLOCK_LEN + self->off % BLOCK_LEN;
+}
+
+// Adds an uninitialised item at the back.
+static void mp_obj_deque_grow(mp_obj_deque_t *self) {
+    size_t pos = self->off + self->len;
+    if ((self->len == 0) || (pos % BLOCK_LEN == 0)) {
+        if (pos / BLOCK_LEN >= self->map_alloc) {
+            mp_obj_deque_reserve_map(self, false);
+            pos = self->off + self->len;
+        }
+        self->map[pos / BLOCK_LEN] = mp_obj_deque_block_alloc(self);
+    }
+    self->len++;
+    self->mutation++;
+}
+
+// Adds an uninitialised item at the front.
+static void mp_obj_deque_grow_left(mp_obj_deque_t *self) {
+    if (self->off == 0) {
+        mp_obj_deque_reserve_map(self, true);
+    }
+    size_t pos = self->off - 1;
+    if ((self->len == 0) || (pos % BLOCK_LEN == BLOCK_LEN - 1)) {
+        self->map[pos / BLOCK_LEN] = mp_obj_deque_block_alloc(self);
+    }
+    self->off = pos;
+    self->len++;
+    self->mutation++;
+}
+
+// Removes the item at the front.
+static void mp_obj_deque_shrink_left(mp_obj_deque_t *self) {
+    size_t pos = self->off++;
+    self->map[pos / BLOCK_LEN][pos % BLOCK_LEN] = MP_OBJ_NULL;
+    self->len--;
+    if ((self->len == 0) || (self->off % BLOCK_LEN == 0)) {
+        mp_obj_deque_block_free(self, pos / BLOCK_LEN);
+    }
+    self->mutation++;
+}
+
+// Removes the item at the back.
+static void mp_obj_deque_shrink(mp_obj_deque_t *self) {
+    size_t pos = self->off + --self->len;
+    self->map[pos / BLOCK_LEN][pos % BLOCK_LEN] = MP_OBJ_NULL;
+    if ((self->len == 0) || (pos % BLOCK_LEN == 0)) {
+        mp_obj_deque_block_free(self, pos / BLOCK_LEN);
+    }
+    self->mutation++;
+}
+
+static void mp_obj_deque_clear_items(mp_obj_deque_t *self) {
+    size_t first = self->off / BLOCK_LEN;
+    size_t num_blocks = mp_obj_deque_num_blocks(self);
+    for (size_t i = first; i < first + num_blocks; i++) {
+        memset(self->map[i], 0, sizeof(mp_obj_t) * BLOCK_LEN);
+        mp_obj_deque_block_free(self, i);
+    }
+    self->len = 0;
+    self->mutation++;
+}
+
+#if MICROPY_PY_SYS_GETSIZEOF
+static size_t mp_obj_deque_sizeof(mp_obj_deque_t *self) {
+    size_t num_blocks = mp_obj_deque_num_blocks(self) + (self->spare ? 1 : 0);
+    return sizeof(*self) + sizeof(mp_obj_t *) * self->map_alloc + sizeof(mp_obj_t) * BLOCK_LEN * num_blocks;
+}
+#endif
+
+#else
+
+static void mp_obj_deque_init(mp_obj_deque_t *self) {
+    self->alloc = 4;
+    self->items = m_new0(mp_obj_t, self->alloc);
+    self->off = self->len = 0;
+}
+
 static inline mp_obj_t *mp_obj_deque_get(mp_obj_deque_t *self, size_t index) {
     index += self->off;
     if (index >= self->alloc) {
@@ -25,10 +177,11 @@ static inline mp_obj_t *mp_obj_deque_get(mp_obj_deque_t *self, size_t index) {
     return &self->items[index];
 }
 
+// Adds an uninitialised item at the back.
 static void mp_obj_deque_grow(mp_obj_deque_t *self) {
     if (self->len + 1 > self->alloc) {
         size_t new_alloc = 3 * (self->alloc / 2);
-        self->items = m_realloc(self->items, sizeof(mp_obj_t) * new_alloc);
+        self->items = m_renew(mp_obj_t, self->items, self->alloc, new_alloc);
         if (self->off + self->len > self->alloc) {
             size_t rem = self->alloc - self->off;
             memmove(&self->items[new_alloc - rem], &self->items[self->off], sizeof(mp_obj_t) * rem);
@@ -40,6 +193,45 @@ static void mp_obj_deque_grow(mp_obj_deque_t *self) {
     self->mutation++;
 }
 
+// Adds an uninitialised item at the front.
+static void mp_obj_deque_grow_left(mp_obj_deque_t *self) {
+    mp_obj_deque_grow(self);
+    if (self->off == 0) {
+        self->off += self->alloc;
+    }
+    self->off--;
+}
+
+// Removes the item at the front.
+static void mp_obj_deque_shrink_left(mp_obj_deque_t *self) {
+    self->items[self->off++] = MP_OBJ_NULL;
+    if (self->off >= self->alloc) {
+        self->off -= self->alloc;
+    }
+    self->len--;
+    self->mutation++;
+}
+
+// Removes the item at the back.
+static void mp_obj_deque_shrink(mp_obj_deque_t *self) {
+    *mp_obj_deque_get(self, --self->len) = MP_OBJ_NULL;
+    self->mutation++;
+}
+
+static void mp_obj_deque_clear_items(mp_obj_deque_t *self) {
+    self->off = self->len = 0;
+    memset(self->items, 0, sizeof(mp_obj_t) * self->alloc);
+    self->mutation++;
+}
+
+#if MICROPY_PY_SYS_GETSIZEOF
+static size_t mp_obj_deque_sizeof(mp_obj_deque_t *self) {
+    return sizeof(*self) + sizeof(mp_obj_t) * self->alloc;
+}
+#endif
+
+#endif // MICROPY_PY_COLLECTIONS_DEQUE_BLOCK_LEN
+
 static mp_int_t mp_obj_deque_contains(mp_obj_deque_t *self, mp_obj_t value, mp_int_t start, mp_int_t stop) {
     int mut = self->mutation;
     for (size_t i = start; i < stop; i++) {
@@ -78,12 +270,7 @@ static void mp_obj_deque_remove_at(mp_obj_deque_t *self, mp_int_t index) {
     for (size_t i = index; i > 0; i--) {
         *mp_obj_deque_get(self, i) = *mp_obj_deque_get(self, i - 1);
     }
-    self->items[self->off++] = MP_OBJ_NULL;
-    if (self->off >= self->alloc) {
-        self->off -= self->alloc;
-    }
-    self->len--;
-    self->mutation++;
+    mp_obj_deque_shrink_left(self);
 }
 
 static mp_obj_t mp_obj_deque_extend(mp_obj_t self_in, mp_obj_t iterable);
@@ -92,9 +279,7 @@ static mp_obj_t mp_obj_deque_make_new(const mp_obj_type_t *type, size_t n_args,
     mp_arg_check_num(n_args, n_kw, 0, 1, false);
 
     mp_obj_deque_t *o = mp_obj_malloc(mp_obj_deque_t, type);
-    o->alloc = 4;
-    o->items = m_malloc(sizeof(mp_obj_t) * o->alloc);
-    o->off = o->len = 0;
+    mp_obj_deque_init(o);
 
     if (n_args > 0) {
         mp_obj_deque_extend(MP_OBJ_FROM_PTR(o), args[0]);
@@ -111,10 +296,8 @@ static mp_obj_t mp_obj_deque_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
             return MP_OBJ_NEW_SMALL_INT(self->len);
 
         #if MICROPY_PY_SYS_GETSIZEOF
-        case MP_UNARY_OP_SIZEOF: {
-            size_t sz = sizeof(*self) + sizeof(mp_obj_t) * self->alloc;
-            return MP_OBJ_NEW_SMALL_INT(sz);
-        }
+        case MP_UNARY_OP_SIZEOF:
+            return MP_OBJ_NEW_SMALL_INT(mp_obj_deque_sizeof(self));
         #endif
         default:
             return MP_OBJ_NULL; // op not supported
@@ -148,20 +331,15 @@ static MP_DEFINE_CONST_FUN_OBJ_2(mp_obj_deque_append_obj, mp_obj_deque_append);
 static mp_obj_t mp_obj_deque_appendleft(mp_obj_t self_in, mp_obj_t arg) {
     mp_obj_deque_t *self = MP_OBJ_TO_PTR(self_in);
 
-    mp_obj_deque_grow(self);
-    if (self->off == 0) {
-        self->off += self->alloc;
-    }
-    self->items[--self->off] = arg;
+    mp_obj_deque_grow_left(self);
+    *mp_obj_deque_get(self, 0) = arg;
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(mp_obj_deque_appendleft_obj, mp_obj_deque_appendleft);
 
 static mp_obj_t mp_obj_deque_clear(mp_obj_t self_in) {
     mp_obj_deque_t *self = MP_OBJ_TO_PTR(self_in);
-    self->off = self->len = 0;
-    memset(self->items, 0, sizeof(mp_obj_t) * self->alloc);
-    self->mutation++;
+    mp_obj_deque_clear_items(self);
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(mp_obj_deque_clear_obj, mp_obj_deque_clear);
@@ -263,10 +441,8 @@ static mp_obj_t mp_obj_deque_pop(mp_obj_t self_in) {
         mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("empty"));
     }
 
-    mp_obj_t *item = mp_obj_deque_get(self, --self->len);
-    mp_obj_t ret = *item;
-    *item = MP_OBJ_NULL;
-    self->mutation++;
+    mp_obj_t ret = *mp_obj_deque_get(self, self->len - 1);
+    mp_obj_deque_shrink(self);
     return ret;
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(mp_obj_deque_pop_obj, mp_obj_deque_pop);
@@ -277,8 +453,8 @@ static mp_obj_t mp_obj_deque_popleft(mp_obj_t self_in) {
         mp_raise_msg(&mp_type_IndexError, MP_ERROR_TEXT("empty"));
     }
 
-    mp_obj_t ret = self->items[self->off];
-    mp_obj_deque_remove_at(self, 0);
+    mp_obj_t ret = *mp_obj_deque_get(self, 0);
+    mp_obj_deque_shrink_left(self);
     return ret;
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(mp_obj_deque_popleft_obj, mp_obj_deque_popleft);
@@ -29,6 +29,7 @@
 #include <string.h>
 #include <assert.h>
 
+#include "py/allocprof.h"
 #include "py/parsenum.h"
 #include "py/runtime.h"
 
@@ -192,6 +193,9 @@ mp_obj_t mp_obj_new_float(mp_float_t value) {
     // Don't use mp_obj_malloc here to avoid extra function call overhead.
     mp_obj_float_t *o = m_new_obj(mp_obj_float_t);
     o->base.type = &mp_type_float;
+    #if MICROPY_PY_MICROPYTHON_ALLOC_PROFILE
+    mp_alloc_profile_set_type(o, &mp_type_float);
+    #endif
     o->value = value;
     return MP_OBJ_FROM_PTR(o);
 }
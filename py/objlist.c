@@ -29,7 +29,6 @@
 
 #include "py/objlist.h"
 #include "py/runtime.h"
-#include "py/cstack.h"
 
 static mp_obj_t mp_obj_new_list_iterator(mp_obj_t list, size_t cur, mp_obj_iter_buf_t *iter_buf);
 static mp_obj_list_t *list_new(size_t n);
@@ -277,51 +276,447 @@ static mp_obj_t list_pop(size_t n_args, const mp_obj_t *args) {
     return ret;
 }
 
-// "head" is actually the *exclusive lower bound* of the range to sort. That is,
-// the first element to be sorted is `head[1]`, not `head[0]`. Similarly `tail`
-// is an *inclusive upper bound* of the range to sort. That is, the final
-// element to sort is `tail[0]`, not `tail[-1]`.
-//
-// The pivot element is always chosen as `tail[0]`.
+/******************************************************************************/
+/* list sort                                                                  */
+
+// list.sort is a stable, adaptive merge sort in the style of timsort.  Natural
+// runs are found and extended to a minimum length with binary insertion sort,
+// then merged from a stack of pending runs, galloping when one run keeps winning.
 //
-// These unusual choices allows structuring the partitioning
-// process as a do/while loop, which generates smaller code than the equivalent
-// code with usual C bounds & a while or for loop.
-static void mp_quicksort(mp_obj_t *head, mp_obj_t *tail, mp_obj_t key_fn, mp_obj_t binop_less_result) {
-    mp_cstack_check();
-    while (tail - head > 1) { // So long as at least 2 elements remain
-        mp_obj_t *h = head;
-        mp_obj_t *t = tail;
-        mp_obj_t v = key_fn == MP_OBJ_NULL ? tail[0] : mp_call_function_1(key_fn, tail[0]); // get pivot using key_fn
-        for (;;) {
-            do {++h;
-            } while (h < t && mp_binary_op(MP_BINARY_OP_LESS, key_fn == MP_OBJ_NULL ? h[0] : mp_call_function_1(key_fn, h[0]), v) == binop_less_result);
-            do {--t;
-            } while (h < t && mp_binary_op(MP_BINARY_OP_LESS, v, key_fn == MP_OBJ_NULL ? t[0] : mp_call_function_1(key_fn, t[0])) == binop_less_result);
-            if (h >= t) {
-                break;
+// Elements are `w` words long and compared on their first word: w is 1 when
+// sorting the items themselves, or 2 when sorting (key, item) pairs so that a
+// key function is called only once per item.
+
+#define LIST_SORT_MIN_GALLOP (7)
+#define LIST_SORT_MAX_RUNS (40)
+
+typedef bool (*list_sort_lt_t)(mp_obj_t a, mp_obj_t b);
+
+typedef struct _list_sort_t {
+    list_sort_lt_t lt;
+    size_t w;
+    mp_obj_t *buf; // temporary storage for merges
+    size_t buf_alloc; // in elements
+    size_t n_runs;
+    struct {
+        mp_obj_t *base;
+        size_t len;
+    } runs[LIST_SORT_MAX_RUNS];
+} list_sort_t;
+
+static bool list_sort_lt_obj(mp_obj_t a, mp_obj_t b) {
+    return mp_binary_op(MP_BINARY_OP_LESS, a, b) == mp_const_true;
+}
+
+static bool list_sort_lt_small_int(mp_obj_t a, mp_obj_t b) {
+    return MP_OBJ_SMALL_INT_VALUE(a) < MP_OBJ_SMALL_INT_VALUE(b);
+}
+
+static bool list_sort_lt_str(mp_obj_t a, mp_obj_t b) {
+    size_t len_a, len_b;
+    const char *a_data = mp_obj_str_get_data(a, &len_a);
+    const char *b_data = mp_obj_str_get_data(b, &len_b);
+    return mp_seq_cmp_bytes(MP_BINARY_OP_LESS, (const byte *)a_data, len_a, (const byte *)b_data, len_b);
+}
+
+#if MICROPY_PY_BUILTINS_FLOAT
+static bool list_sort_lt_float(mp_obj_t a, mp_obj_t b) {
+    return mp_obj_float_get(a) < mp_obj_float_get(b);
+}
+#endif
+
+// If all keys are small ints, strs or floats then compare them directly,
+// otherwise go through mp_binary_op.
+static list_sort_lt_t list_sort_select_lt(const mp_obj_t *a, size_t n, size_t w) {
+    list_sort_lt_t lt;
+    if (mp_obj_is_small_int(a[0])) {
+        lt = list_sort_lt_small_int;
+    } else if (mp_obj_is_str(a[0])) {
+        lt = list_sort_lt_str;
+    #if MICROPY_PY_BUILTINS_FLOAT
+    } else if (mp_obj_is_float(a[0])) {
+        lt = list_sort_lt_float;
+    #endif
+    } else {
+        return list_sort_lt_obj;
+    }
+    for (size_t i = 1; i < n; ++i) {
+        mp_obj_t k = a[i * w];
+        bool same;
+        if (lt == list_sort_lt_small_int) {
+            same = mp_obj_is_small_int(k);
+        } else if (lt == list_sort_lt_str) {
+            same = mp_obj_is_str(k);
+        } else {
+            #if MICROPY_PY_BUILTINS_FLOAT
+            same = mp_obj_is_float(k);
+            #else
+            same = false;
+            #endif
+        }
+        if (!same) {
+            return list_sort_lt_obj;
+        }
+    }
+    return lt;
+}
+
+static inline void list_sort_copy(size_t w, mp_obj_t *dest, const mp_obj_t *src, size_t n) {
+    memmove(dest, src, n * w * sizeof(mp_obj_t));
+}
+
+static inline void list_sort_copy1(size_t w, mp_obj_t *dest, const mp_obj_t *src) {
+    dest[0] = src[0];
+    if (w == 2) {
+        dest[1] = src[1];
+    }
+}
+
+static void list_sort_reverse(size_t w, mp_obj_t *a, size_t n) {
+    mp_obj_t *lo = a;
+    mp_obj_t *hi = a + (n - 1) * w;
+    while (lo < hi) {
+        for (size_t i = 0; i < w; ++i) {
+            mp_obj_t x = lo[i];
+            lo[i] = hi[i];
+            hi[i] = x;
+        }
+        lo += w;
+        hi -= w;
+    }
+}
+
+static mp_obj_t *list_sort_get_buf(list_sort_t *s, size_t n) {
+    if (n > s->buf_alloc) {
+        if (s->buf != NULL) {
+            m_del(mp_obj_t, s->buf, s->buf_alloc * s->w);
+            s->buf = NULL;
+            s->buf_alloc = 0;
+        }
+        s->buf = m_new(mp_obj_t, n * s->w);
+        s->buf_alloc = n;
+    }
+    return s->buf;
+}
+
+// Sort a[0..n) given that a[0..start) is already sorted.
+static void list_sort_binary_insertion(list_sort_t *s, mp_obj_t *a, size_t start, size_t n) {
+    size_t w = s->w;
+    for (; start < n; ++start) {
+        mp_obj_t pivot[2];
+        list_sort_copy1(w, pivot, a + start * w);
+        // insert after any equal elements, to keep the sort stable
+        size_t lo = 0;
+        size_t hi = start;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (s->lt(pivot[0], a[mid * w])) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
             }
-            // A pair of objects must be swapped to the other side of the partition
-            mp_obj_t x = h[0];
-            h[0] = t[0];
-            t[0] = x;
-        }
-        // Place the pivot element in the proper position
-        mp_obj_t x = h[0];
-        h[0] = tail[0];
-        tail[0] = x;
-        // do the smaller recursive call first, to keep stack within O(log(N))
-        if (t - head < tail - h) {
-            mp_quicksort(head, t, key_fn, binop_less_result);
-            head = h;
+        }
+        list_sort_copy(w, a + (lo + 1) * w, a + lo * w, start - lo);
+        list_sort_copy1(w, a + lo * w, pivot);
+    }
+}
+
+// Return the length of the run at the start of a[0..n), reversing it in place
+// if it is strictly descending (strictly, so that reversing keeps it stable).
+static size_t list_sort_count_run(list_sort_t *s, mp_obj_t *a, size_t n) {
+    size_t w = s->w;
+    if (n == 1) {
+        return 1;
+    }
+    size_t i = 2;
+    if (s->lt(a[w], a[0])) {
+        while (i < n && s->lt(a[i * w], a[(i - 1) * w])) {
+            ++i;
+        }
+        list_sort_reverse(w, a, i);
+    } else {
+        while (i < n && !s->lt(a[i * w], a[(i - 1) * w])) {
+            ++i;
+        }
+    }
+    return i;
+}
+
+// Return how many elements at the start of the sorted a[0..n) are less than key,
+// or less than or equal to key if `right` is true.  The search gallops out from
+// the start of the array, or from its end if `from_end` is true.
+static size_t list_sort_gallop(list_sort_t *s, mp_obj_t key, const mp_obj_t *a, size_t n, bool right, bool from_end) {
+    size_t w = s->w;
+    #define BEFORE(i) (right ? !s->lt(key, a[(i) * w]) : s->lt(a[(i) * w], key))
+    if (n == 0) {
+        return 0;
+    }
+    size_t lo, hi;
+    if (!from_end) {
+        if (!BEFORE(0)) {
+            return 0;
+        }
+        size_t last = 0;
+        size_t ofs = 1;
+        while (ofs < n && BEFORE(ofs)) {
+            last = ofs;
+            ofs = 2 * ofs + 1;
+        }
+        lo = last + 1;
+        hi = ofs < n ? ofs : n;
+    } else {
+        if (BEFORE(n - 1)) {
+            return n;
+        }
+        size_t last = 0;
+        size_t ofs = 1;
+        while (ofs < n && !BEFORE(n - 1 - ofs)) {
+            last = ofs;
+            ofs = 2 * ofs + 1;
+        }
+        lo = ofs < n ? n - ofs : 0;
+        hi = n - 1 - last;
+    }
+    // the answer is in [lo, hi]
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (BEFORE(mid)) {
+            lo = mid + 1;
         } else {
-            mp_quicksort(h, tail, key_fn, binop_less_result);
-            tail = t;
+            hi = mid;
         }
     }
+    #undef BEFORE
+    return lo;
+}
+
+// Merge the adjacent sorted runs a[0..na) and a[na..na+nb), where na <= nb.
+static void list_sort_merge_lo(list_sort_t *s, mp_obj_t *a, size_t na, size_t nb) {
+    size_t w = s->w;
+    mp_obj_t *t = list_sort_get_buf(s, na);
+    mp_obj_t *b = a + na * w;
+    list_sort_copy(w, t, a, na);
+    // i, j index t and b, and a[i + j] is the next element to fill
+    size_t i = 0;
+    size_t j = 0;
+    size_t wins_a = 0;
+    size_t wins_b = 0;
+    while (i < na && j < nb) {
+        if (s->lt(b[j * w], t[i * w])) {
+            list_sort_copy1(w, a + (i + j) * w, b + j * w);
+            ++j;
+            wins_a = 0;
+            if (++wins_b >= LIST_SORT_MIN_GALLOP) {
+                size_t k = list_sort_gallop(s, t[i * w], b + j * w, nb - j, false, false);
+                list_sort_copy(w, a + (i + j) * w, b + j * w, k);
+                j += k;
+                wins_b = k >= LIST_SORT_MIN_GALLOP ? LIST_SORT_MIN_GALLOP - 1 : 0;
+            }
+        } else {
+            list_sort_copy1(w, a + (i + j) * w, t + i * w);
+            ++i;
+            wins_b = 0;
+            if (++wins_a >= LIST_SORT_MIN_GALLOP) {
+                size_t k = list_sort_gallop(s, b[j * w], t + i * w, na - i, true, false);
+                list_sort_copy(w, a + (i + j) * w, t + i * w, k);
+                i += k;
+                wins_a = k >= LIST_SORT_MIN_GALLOP ? LIST_SORT_MIN_GALLOP - 1 : 0;
+            }
+        }
+    }
+    // any remaining elements of b are already in place
+    list_sort_copy(w, a + (i + j) * w, t + i * w, na - i);
+}
+
+// Merge the adjacent sorted runs a[0..na) and a[na..na+nb), where na > nb.
+static void list_sort_merge_hi(list_sort_t *s, mp_obj_t *a, size_t na, size_t nb) {
+    size_t w = s->w;
+    mp_obj_t *t = list_sort_get_buf(s, nb);
+    list_sort_copy(w, t, a + na * w, nb);
+    // a[0..i) and t[0..j) remain, and a[i + j - 1] is the next element to fill
+    size_t i = na;
+    size_t j = nb;
+    size_t wins_a = 0;
+    size_t wins_b = 0;
+    while (i > 0 && j > 0) {
+        if (s->lt(t[(j - 1) * w], a[(i - 1) * w])) {
+            list_sort_copy1(w, a + (i + j - 1) * w, a + (i - 1) * w);
+            --i;
+            wins_b = 0;
+            if (++wins_a >= LIST_SORT_MIN_GALLOP) {
+                size_t k = i - list_sort_gallop(s, t[(j - 1) * w], a, i, true, true);
+                list_sort_copy(w, a + (i + j - k) * w, a + (i - k) * w, k);
+                i -= k;
+                wins_a = k >= LIST_SORT_MIN_GALLOP ? LIST_SORT_MIN_GALLOP - 1 : 0;
+            }
+        } else {
+            list_sort_copy1(w, a + (i + j - 1) * w, t + (j - 1) * w);
+            --j;
+            wins_a = 0;
+            if (++wins_b >= LIST_SORT_MIN_GALLOP) {
+                size_t k = j - list_sort_gallop(s, a[(i - 1) * w], t, j, false, true);
+                list_sort_copy(w, a + (i + j - k) * w, t + (j - k) * w, k);
+                j -= k;
+                wins_b = k >= LIST_SORT_MIN_GALLOP ? LIST_SORT_MIN_GALLOP - 1 : 0;
+            }
+        }
+    }
+    // any remaining elements of a are already in place
+    list_sort_copy(w, a, t, j);
+}
+
+// Merge runs n and n + 1 on the stack.
+static void list_sort_merge_at(list_sort_t *s, size_t n) {
+    size_t w = s->w;
+    mp_obj_t *a = s->runs[n].base;
+    size_t na = s->runs[n].len;
+    mp_obj_t *b = s->runs[n + 1].base;
+    size_t nb = s->runs[n + 1].len;
+    s->runs[n].len = na + nb;
+    if (n + 3 == s->n_runs) {
+        s->runs[n + 1] = s->runs[n + 2];
+    }
+    --s->n_runs;
+
+    // elements of a that are <= b[0] are already in place
+    size_t k = list_sort_gallop(s, b[0], a, na, true, false);
+    a += k * w;
+    na -= k;
+    if (na == 0) {
+        return;
+    }
+    // elements of b that are >= the last of a are already in place
+    nb = list_sort_gallop(s, a[(na - 1) * w], b, nb, false, true);
+    if (nb == 0) {
+        return;
+    }
+    if (na <= nb) {
+        list_sort_merge_lo(s, a, na, nb);
+    } else {
+        list_sort_merge_hi(s, a, na, nb);
+    }
+}
+
+// Merge runs until the pending run lengths decrease faster than the Fibonacci
+// numbers, which bounds the size of the stack and keeps merges balanced.
+static void list_sort_merge_collapse(list_sort_t *s) {
+    while (s->n_runs > 1) {
+        size_t n = s->n_runs - 2;
+        if ((n > 0 && s->runs[n - 1].len <= s->runs[n].len + s->runs[n + 1].len)
+            || (n > 1 && s->runs[n - 2].len <= s->runs[n - 1].len + s->runs[n].len)) {
+            if (s->runs[n - 1].len < s->runs[n + 1].len) {
+                --n;
+            }
+        } else if (s->runs[n].len > s->runs[n + 1].len) {
+            break;
+        }
+        list_sort_merge_at(s, n);
+    }
+}
+
+// Return a minimum run length in [32, 64] such that n / min_run is a power of
+// two or slightly less than one, so the final merges are balanced.
+static size_t list_sort_min_run(size_t n) {
+    size_t r = 0;
+    while (n >= 64) {
+        r |= n & 1;
+        n >>= 1;
+    }
+    return n + r;
+}
+
+static void list_sort_array(list_sort_t *s, mp_obj_t *a, size_t n) {
+    size_t w = s->w;
+    size_t min_run = list_sort_min_run(n);
+    s->n_runs = 0;
+    while (n > 0) {
+        size_t len = list_sort_count_run(s, a, n);
+        if (len < min_run) {
+            size_t force = n < min_run ? n : min_run;
+            list_sort_binary_insertion(s, a, len, force);
+            len = force;
+        }
+        assert(s->n_runs < LIST_SORT_MAX_RUNS);
+        s->runs[s->n_runs].base = a;
+        s->runs[s->n_runs].len = len;
+        ++s->n_runs;
+        list_sort_merge_collapse(s);
+        a += len * w;
+        n -= len;
+    }
+    while (s->n_runs > 1) {
+        size_t i = s->n_runs - 2;
+        if (i > 0 && s->runs[i - 1].len < s->runs[i + 1].len) {
+            --i;
+        }
+        list_sort_merge_at(s, i);
+    }
+}
+
+static void list_sort_run(list_sort_t *s, mp_obj_t *a, size_t n, bool reverse) {
+    // a reverse sort keeps equal elements in their original order
+    if (reverse) {
+        list_sort_reverse(s->w, a, n);
+    }
+    list_sort_array(s, a, n);
+    if (reverse) {
+        list_sort_reverse(s->w, a, n);
+    }
+}
+
+// Sort when the key function or comparisons run Python code, which may raise or
+// modify the list.  As in CPython, the items are detached from the list while it
+// is sorted, so the list appears empty.  If an exception is raised the list gets
+// back its items in their original order, and if the list was modified the
+// modifications are discarded and ValueError is raised.
+static void list_sort_detached(mp_obj_list_t *self, list_sort_t *s, mp_obj_t key_fn, bool reverse) {
+    size_t n = self->len;
+    size_t alloc = self->alloc;
+    mp_obj_t *items = self->items;
+    mp_obj_t *a = m_new(mp_obj_t, n * s->w);
+    mp_obj_t *empty = m_new0(mp_obj_t, LIST_MIN_ALLOC);
+    self->len = 0;
+    self->alloc = LIST_MIN_ALLOC;
+    self->items = empty;
+
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        if (s->w == 2) {
+            // compute each key once, sorting (key, item) pairs
+            for (size_t i = 0; i < n; ++i) {
+                a[2 * i + 1] = items[i];
+            }
+            for (size_t i = 0; i < n; ++i) {
+                a[2 * i] = mp_call_function_1(key_fn, a[2 * i + 1]);
+            }
+            s->lt = list_sort_select_lt(a, n, 2);
+        } else {
+            memcpy(a, items, n * sizeof(mp_obj_t));
+        }
+        list_sort_run(s, a, n, reverse);
+        nlr_pop();
+    } else {
+        m_del(mp_obj_t, self->items, self->alloc);
+        self->len = n;
+        self->alloc = alloc;
+        self->items = items;
+        nlr_jump(nlr.ret_val);
+    }
+
+    bool modified = self->len != 0 || self->alloc != LIST_MIN_ALLOC || self->items != empty;
+    m_del(mp_obj_t, self->items, self->alloc);
+    self->len = n;
+    self->alloc = alloc;
+    self->items = items;
+    for (size_t i = 0; i < n; ++i) {
+        items[i] = a[i * s->w + s->w - 1];
+    }
+    m_del(mp_obj_t, a, n * s->w);
+    if (modified) {
+        mp_raise_ValueError(MP_ERROR_TEXT("list modified during sort"));
+    }
 }
 
-// TODO Python defines sort to be stable but ours is not
 mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_key, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
@@ -338,10 +733,24 @@ mp_obj_t mp_obj_list_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_
     mp_check_self(mp_obj_is_type(pos_args[0], &mp_type_list));
     mp_obj_list_t *self = MP_OBJ_TO_PTR(pos_args[0]);
 
-    if (self->len > 1) {
-        mp_quicksort(self->items - 1, self->items + self->len - 1,
-            args.key.u_obj == mp_const_none ? MP_OBJ_NULL : args.key.u_obj,
-            args.reverse.u_bool ? mp_const_false : mp_const_true);
+    size_t n = self->len;
+    if (n > 1) {
+        list_sort_t s;
+        s.w = args.key.u_obj == mp_const_none ? 1 : 2;
+        s.buf = NULL;
+        s.buf_alloc = 0;
+        if (s.w == 1) {
+            s.lt = list_sort_select_lt(self->items, n, 1);
+        }
+        if (s.w == 1 && s.lt != list_sort_lt_obj) {
+            // no Python code runs, so sort the items in place
+            list_sort_run(&s, self->items, n, args.reverse.u_bool);
+        } else {
+            list_sort_detached(self, &s, args.key.u_obj, args.reverse.u_bool);
+        }
+        if (s.buf != NULL) {
+            m_del(mp_obj_t, s.buf, s.buf_alloc * s.w);
+        }
     }
 
     return mp_const_none;
@@ -474,7 +883,7 @@ void mp_obj_list_init(mp_obj_list_t *o, size_t n) {
 }
 
 static mp_obj_list_t *list_new(size_t n) {
-    mp_obj_list_t *o = m_new_obj(mp_obj_list_t);
+    mp_obj_list_t *o = mp_obj_malloc(mp_obj_list_t, &mp_type_list);
     mp_obj_list_init(o, n);
     return o;
 }
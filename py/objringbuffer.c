@@ -0,0 +1,334 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#include "py/mpconfig.h"
+
+#if MICROPY_PY_MICROPYTHON_RINGBUFFER
+
+#include "py/mperrno.h"
+#include "py/mphal.h"
+#include "py/objarray.h"
+#include "py/objringbuffer.h"
+#include "py/parseargs.h"
+#include "py/runtime.h"
+#include "py/stream.h"
+
+#if MICROPY_FREERTOS
+#include "extmod/modos_newlib.h"
+#endif
+
+// A stream over a lock-free SPSC ring, for passing bytes between a producer and
+// a consumer that may be on different threads or cores, or in C code running
+// without the GIL. Blocking reads and writes wait with the GIL released: using
+// the poll file on FreeRTOS, which also makes the object pollable via fileno(),
+// and otherwise by polling with mp_event_wait_ms.
+
+static uint ringbuffer_poll(mp_obj_ringbuffer_t *self) {
+    uint events = 0;
+    bool closed = atomic_load(&self->closed);
+    if (closed || ringspsc_read_count(&self->ring)) {
+        events |= MP_STREAM_POLL_RD;
+    }
+    if (closed || ringspsc_write_count(&self->ring)) {
+        events |= MP_STREAM_POLL_WR;
+    }
+    if (closed) {
+        events |= MP_STREAM_POLL_HUP;
+    }
+    return events;
+}
+
+size_t mp_ringbuffer_read(mp_obj_ringbuffer_t *self, void *buf, size_t len) {
+    size_t ret = ringspsc_read(&self->ring, buf, len);
+    #if MICROPY_FREERTOS
+    if (ret) {
+        poll_file_notify(self->poll.file, 0, POLLOUT);
+    }
+    #endif
+    return ret;
+}
+
+size_t mp_ringbuffer_write(mp_obj_ringbuffer_t *self, const void *buf, size_t len) {
+    size_t ret = ringspsc_write(&self->ring, buf, len);
+    #if MICROPY_FREERTOS
+    if (ret) {
+        poll_file_notify(self->poll.file, 0, POLLIN);
+    }
+    #endif
+    return ret;
+}
+
+void mp_ringbuffer_close(mp_obj_ringbuffer_t *self) {
+    atomic_store(&self->closed, true);
+    #if MICROPY_FREERTOS
+    poll_file_notify(self->poll.file, 0, POLLIN | POLLOUT | POLLHUP);
+    #endif
+}
+
+#if MICROPY_FREERTOS
+size_t mp_ringbuffer_read_from_isr(mp_obj_ringbuffer_t *self, void *buf, size_t len, BaseType_t *pxHigherPriorityTaskWoken) {
+    size_t ret = ringspsc_read(&self->ring, buf, len);
+    if (ret) {
+        poll_file_notify_from_isr(self->poll.file, 0, POLLOUT, pxHigherPriorityTaskWoken);
+    }
+    return ret;
+}
+
+size_t mp_ringbuffer_write_from_isr(mp_obj_ringbuffer_t *self, const void *buf, size_t len, BaseType_t *pxHigherPriorityTaskWoken) {
+    size_t ret = ringspsc_write(&self->ring, buf, len);
+    if (ret) {
+        poll_file_notify_from_isr(self->poll.file, 0, POLLIN, pxHigherPriorityTaskWoken);
+    }
+    return ret;
+}
+
+typedef TickType_t ringbuffer_timer_t;
+
+static void ringbuffer_timer_start(mp_obj_ringbuffer_t *self, ringbuffer_timer_t *timer) {
+    *timer = (self->timeout < 0) ? portMAX_DELAY : pdMS_TO_TICKS(self->timeout);
+}
+
+// Waits until the ring has any of the events, returning false on timeout.
+static bool ringbuffer_wait(mp_obj_ringbuffer_t *self, uint events, ringbuffer_timer_t *timer) {
+    // Clear the events before checking the ring, so that a notification from
+    // the other side after the check isn't lost.
+    poll_file_notify(self->poll.file, events, 0);
+    if (ringbuffer_poll(self) & events) {
+        return true;
+    }
+    return mp_poll_wait(&self->poll, events, timer);
+}
+#else
+typedef mp_uint_t ringbuffer_timer_t;
+
+static void ringbuffer_timer_start(mp_obj_ringbuffer_t *self, ringbuffer_timer_t *timer) {
+    *timer = mp_hal_ticks_ms();
+}
+
+// Waits until the ring has any of the events, returning false on timeout.
+static bool ringbuffer_wait(mp_obj_ringbuffer_t *self, uint events, ringbuffer_timer_t *timer) {
+    while (!(ringbuffer_poll(self) & events)) {
+        if ((self->timeout >= 0) && (mp_hal_ticks_ms() - *timer >= (mp_uint_t)self->timeout)) {
+            return false;
+        }
+        mp_event_wait_ms(1);
+    }
+    return true;
+}
+#endif
+
+static mp_obj_t ringbuffer_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    const qstr kws[] = { MP_QSTR_, MP_QSTR_timeout, 0 };
+    mp_obj_t buf_in;
+    mp_int_t timeout = -1;
+    parse_args_and_kw(n_args, n_kw, args, "O|$i", kws, &buf_in, &timeout);
+
+    mp_buffer_info_t bufinfo;
+    if (mp_get_buffer(buf_in, &bufinfo, MP_BUFFER_RW)) {
+        if ((bufinfo.len == 0) || (bufinfo.len & (bufinfo.len - 1)) || (bufinfo.len > 0x80000000)) {
+            mp_raise_ValueError(MP_ERROR_TEXT("size must be a power of 2"));
+        }
+    } else {
+        mp_uint_t size = mp_obj_get_int(buf_in);
+        if ((size == 0) || (size > 0x80000000)) {
+            mp_raise_ValueError(NULL);
+        }
+        bufinfo.len = 1;
+        while (bufinfo.len < size) {
+            bufinfo.len <<= 1;
+        }
+        bufinfo.buf = m_new(uint8_t, bufinfo.len);
+        buf_in = MP_OBJ_NULL;
+    }
+
+    #if MICROPY_FREERTOS
+    mp_obj_ringbuffer_t *self = mp_obj_malloc_with_finaliser(mp_obj_ringbuffer_t, type);
+    mp_poll_init(&self->poll);
+    mp_os_check_ret(mp_poll_alloc(&self->poll, POLLOUT));
+    #else
+    mp_obj_ringbuffer_t *self = mp_obj_malloc(mp_obj_ringbuffer_t, type);
+    #endif
+    ringspsc_init(&self->ring, bufinfo.buf, bufinfo.len);
+    // Keep a user-supplied buffer object alive, since the data pointer may not
+    // point to the start of a heap block.
+    self->buf_obj = buf_in;
+    self->timeout = timeout;
+    atomic_init(&self->closed, false);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+static mp_uint_t ringbuffer_read(mp_obj_t self_in, void *buf, mp_uint_t size, int *errcode) {
+    mp_obj_ringbuffer_t *self = MP_OBJ_TO_PTR(self_in);
+    ringbuffer_timer_t timer;
+    ringbuffer_timer_start(self, &timer);
+    for (;;) {
+        // Check closed before reading, so that data written before closing isn't missed.
+        bool closed = atomic_load(&self->closed);
+        size_t ret = mp_ringbuffer_read(self, buf, size);
+        if (ret || !size || closed) {
+            return ret;
+        }
+        if (!ringbuffer_wait(self, MP_STREAM_POLL_RD, &timer)) {
+            *errcode = MP_EAGAIN;
+            return MP_STREAM_ERROR;
+        }
+    }
+}
+
+static mp_uint_t ringbuffer_write(mp_obj_t self_in, const void *buf, mp_uint_t size, int *errcode) {
+    mp_obj_ringbuffer_t *self = MP_OBJ_TO_PTR(self_in);
+    ringbuffer_timer_t timer;
+    ringbuffer_timer_start(self, &timer);
+    for (;;) {
+        if (atomic_load(&self->closed)) {
+            *errcode = MP_EPIPE;
+            return MP_STREAM_ERROR;
+        }
+        size_t ret = mp_ringbuffer_write(self, buf, size);
+        if (ret || !size) {
+            return ret;
+        }
+        if (!ringbuffer_wait(self, MP_STREAM_POLL_WR, &timer)) {
+            *errcode = MP_EAGAIN;
+            return MP_STREAM_ERROR;
+        }
+    }
+}
+
+static mp_uint_t ringbuffer_ioctl(mp_obj_t self_in, mp_uint_t request, uintptr_t arg, int *errcode) {
+    mp_obj_ringbuffer_t *self = MP_OBJ_TO_PTR(self_in);
+    switch (request) {
+        case MP_STREAM_POLL:
+            return ringbuffer_poll(self) & (arg | MP_STREAM_POLL_HUP);
+        case MP_STREAM_CLOSE:
+            mp_ringbuffer_close(self);
+            return 0;
+    }
+    *errcode = MP_EINVAL;
+    return MP_STREAM_ERROR;
+}
+
+#if MICROPY_FREERTOS
+static mp_obj_t ringbuffer_del(mp_obj_t self_in) {
+    mp_obj_ringbuffer_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_poll_deinit(&self->poll);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(ringbuffer_del_obj, ringbuffer_del);
+
+static mp_obj_t ringbuffer_fileno(mp_obj_t self_in) {
+    mp_obj_ringbuffer_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_os_check_ret(mp_poll_fileno(&self->poll));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(ringbuffer_fileno_obj, ringbuffer_fileno);
+#endif
+
+static mp_obj_t ringbuffer_any(mp_obj_t self_in) {
+    mp_obj_ringbuffer_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int_from_uint(ringspsc_read_count(&self->ring));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(ringbuffer_any_obj, ringbuffer_any);
+
+static mp_obj_t ringbuffer_new_views(mp_obj_ringbuffer_t *self, uint8_t *ptr[2], uint32_t len[2], byte typecode) {
+    // The GC only traces pointers to the start of a heap block, so each view
+    // points to the start of the ring's storage and selects its data with an
+    // offset.  The views then keep the storage alive after the RingBuffer goes.
+    uint8_t *base = self->ring.buf;
+    if (self->buf_obj != MP_OBJ_NULL && mp_obj_is_type(self->buf_obj, &mp_type_memoryview)) {
+        mp_obj_array_t *buf_view = MP_OBJ_TO_PTR(self->buf_obj);
+        base = buf_view->items;
+    }
+    mp_obj_t items[2];
+    for (size_t i = 0; i < 2; ++i) {
+        mp_obj_array_t *view = m_new_obj(mp_obj_array_t);
+        mp_obj_memoryview_init(view, typecode, ptr[i] - base, len[i], base);
+        items[i] = MP_OBJ_FROM_PTR(view);
+    }
+    return mp_obj_new_tuple(2, items);
+}
+
+// Returns the readable bytes as a tuple of two memoryviews, without consuming them.
+static mp_obj_t ringbuffer_peek_views(mp_obj_t self_in) {
+    mp_obj_ringbuffer_t *self = MP_OBJ_TO_PTR(self_in);
+    uint8_t *ptr[2];
+    uint32_t len[2];
+    ringspsc_read_views(&self->ring, ptr, len);
+    return ringbuffer_new_views(self, ptr, len, 'B');
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(ringbuffer_peek_views_obj, ringbuffer_peek_views);
+
+static mp_obj_t ringbuffer_consume(mp_obj_t self_in, mp_obj_t n_in) {
+    mp_obj_ringbuffer_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_uint_t n = mp_obj_get_int(n_in);
+    if (n > ringspsc_read_count(&self->ring)) {
+        mp_raise_ValueError(NULL);
+    }
+    ringspsc_read_commit(&self->ring, n);
+    #if MICROPY_FREERTOS
+    poll_file_notify(self->poll.file, 0, POLLOUT);
+    #endif
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(ringbuffer_consume_obj, ringbuffer_consume);
+
+// Returns the free space as a tuple of two writable memoryviews.
+static mp_obj_t ringbuffer_reserve_views(mp_obj_t self_in) {
+    mp_obj_ringbuffer_t *self = MP_OBJ_TO_PTR(self_in);
+    uint8_t *ptr[2];
+    uint32_t len[2];
+    ringspsc_write_views(&self->ring, ptr, len);
+    return ringbuffer_new_views(self, ptr, len, 'B' | MP_OBJ_ARRAY_TYPECODE_FLAG_RW);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(ringbuffer_reserve_views_obj, ringbuffer_reserve_views);
+
+static mp_obj_t ringbuffer_commit(mp_obj_t self_in, mp_obj_t n_in) {
+    mp_obj_ringbuffer_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_uint_t n = mp_obj_get_int(n_in);
+    if (n > ringspsc_write_count(&self->ring)) {
+        mp_raise_ValueError(NULL);
+    }
+    ringspsc_write_commit(&self->ring, n);
+    #if MICROPY_FREERTOS
+    poll_file_notify(self->poll.file, 0, POLLIN);
+    #endif
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(ringbuffer_commit_obj, ringbuffer_commit);
+
+static const mp_rom_map_elem_t ringbuffer_locals_dict_table[] = {
+    #if MICROPY_FREERTOS
+    { MP_ROM_QSTR(MP_QSTR___del__), MP_ROM_PTR(&ringbuffer_del_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fileno), MP_ROM_PTR(&ringbuffer_fileno_obj) },
+    #endif
+    { MP_ROM_QSTR(MP_QSTR_any), MP_ROM_PTR(&ringbuffer_any_obj) },
+    { MP_ROM_QSTR(MP_QSTR_read), MP_ROM_PTR(&mp_stream_read_obj) },
+    { MP_ROM_QSTR(MP_QSTR_read1), MP_ROM_PTR(&mp_stream_read1_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto), MP_ROM_PTR(&mp_stream_readinto_obj) },
+    { MP_ROM_QSTR(MP_QSTR_readinto1), MP_ROM_PTR(&mp_stream_readinto1_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_stream_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write1), MP_ROM_PTR(&mp_stream_write1_obj) },
+    { MP_ROM_QSTR(MP_QSTR_close), MP_ROM_PTR(&mp_stream_close_obj) },
+    { MP_ROM_QSTR(MP_QSTR_peek_views), MP_ROM_PTR(&ringbuffer_peek_views_obj) },
+    { MP_ROM_QSTR(MP_QSTR_consume), MP_ROM_PTR(&ringbuffer_consume_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reserve_views), MP_ROM_PTR(&ringbuffer_reserve_views_obj) },
+    { MP_ROM_QSTR(MP_QSTR_commit), MP_ROM_PTR(&ringbuffer_commit_obj) },
+};
+static MP_DEFINE_CONST_DICT(ringbuffer_locals_dict, ringbuffer_locals_dict_table);
+
+static const mp_stream_p_t ringbuffer_stream_p = {
+    .read = ringbuffer_read,
+    .write = ringbuffer_write,
+    .ioctl = ringbuffer_ioctl,
+    .is_text = false,
+};
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    mp_type_ringbuffer,
+    MP_QSTR_RingBuffer,
+    MP_TYPE_FLAG_NONE,
+    make_new, ringbuffer_make_new,
+    protocol, &ringbuffer_stream_p,
+    locals_dict, &ringbuffer_locals_dict
+    );
+
+#endif // MICROPY_PY_MICROPYTHON_RINGBUFFER
@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdatomic.h>
+
+#include "py/obj.h"
+#include "py/ringspsc.h"
+
+#if MICROPY_FREERTOS
+#include "FreeRTOS.h"
+
+#include "extmod/io/poll.h"
+#endif
+
+
+typedef struct {
+    mp_obj_base_t base;
+    ringspsc_t ring;
+    mp_obj_t buf_obj;
+    mp_int_t timeout;
+    atomic_bool closed;
+    #if MICROPY_FREERTOS
+    mp_poll_t poll;
+    #endif
+} mp_obj_ringbuffer_t;
+
+// Functions for a producer or consumer written in C. They don't need the GIL so
+// can be called from any thread, but there must be at most one producer and one
+// consumer. A thread that isn't known to the GC should keep the object alive
+// using a gc_handle.
+size_t mp_ringbuffer_read(mp_obj_ringbuffer_t *self, void *buf, size_t len);
+
+size_t mp_ringbuffer_write(mp_obj_ringbuffer_t *self, const void *buf, size_t len);
+
+void mp_ringbuffer_close(mp_obj_ringbuffer_t *self);
+
+#if MICROPY_FREERTOS
+size_t mp_ringbuffer_read_from_isr(mp_obj_ringbuffer_t *self, void *buf, size_t len, BaseType_t *pxHigherPriorityTaskWoken);
+
+size_t mp_ringbuffer_write_from_isr(mp_obj_ringbuffer_t *self, const void *buf, size_t len, BaseType_t *pxHigherPriorityTaskWoken);
+#endif
@@ -205,9 +205,6 @@ mp_obj_t mp_obj_str_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_
             if (mp_obj_is_type(args[0], &mp_type_bytes)) {
                 GET_STR_DATA_LEN(args[0], str_data, str_len);
                 GET_STR_HASH(args[0], str_hash);
-                if (str_hash == 0) {
-                    str_hash = qstr_compute_hash(str_data, str_len);
-                }
                 #if MICROPY_PY_BUILTINS_STR_UNICODE_CHECK
                 if (!utf8_check(str_data, str_len)) {
                     mp_raise_msg(&mp_type_UnicodeError, NULL);
@@ -222,7 +219,9 @@ mp_obj_t mp_obj_str_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_
 
                 mp_obj_str_t *o = MP_OBJ_TO_PTR(mp_obj_new_str_copy(type, NULL, str_len));
                 o->data = str_data;
-                o->hash = str_hash;
+                if (str_hash != 0) {
+                    o->hash = str_hash;
+                }
                 return MP_OBJ_FROM_PTR(o);
             } else {
                 mp_buffer_info_t bufinfo;
@@ -262,12 +261,11 @@ static mp_obj_t bytes_make_new(const mp_obj_type_t *type_in, size_t n_args, size
         }
         GET_STR_DATA_LEN(args[0], str_data, str_len);
         GET_STR_HASH(args[0], str_hash);
-        if (str_hash == 0) {
-            str_hash = qstr_compute_hash(str_data, str_len);
-        }
         mp_obj_str_t *o = MP_OBJ_TO_PTR(mp_obj_new_str_copy(&mp_type_bytes, NULL, str_len));
         o->data = str_data;
-        o->hash = str_hash;
+        if (str_hash != 0) {
+            o->hash = str_hash;
+        }
         return MP_OBJ_FROM_PTR(o);
     }
 
@@ -2072,7 +2070,19 @@ mp_int_t mp_obj_str_get_buffer(mp_obj_t self_in, mp_buffer_info_t *bufinfo, mp_u
 void mp_obj_str_set_data(mp_obj_str_t *str, const byte *data, size_t len) {
     str->data = data;
     str->len = len;
-    str->hash = qstr_compute_hash(data, len);
+    str->hash = MP_OBJ_STR_HASH_LAZY;
+}
+
+// Slow path of mp_obj_str_get_hash. Strings are often created and never hashed,
+// for example when read from a stream, so the hash is only worked out when asked
+// for. Objects created in RAM can then cache it, those with a hash of 0 can't.
+size_t mp_obj_str_compute_hash(mp_obj_t self_in) {
+    mp_obj_str_t *self = MP_OBJ_TO_PTR(self_in);
+    size_t hash = qstr_compute_hash(self->data, self->len);
+    if (self->hash == MP_OBJ_STR_HASH_LAZY) {
+        self->hash = hash;
+    }
+    return hash;
 }
 
 // This locals table is used for the following types: str, bytes, bytearray, array.array.
@@ -2216,9 +2226,9 @@ const mp_obj_str_t mp_const_empty_bytes_obj = {{&mp_type_bytes}, 0, 0, (const by
 // or if the type is str and the string data is known to be not interned.
 mp_obj_t mp_obj_new_str_copy(const mp_obj_type_t *type, const byte *data, size_t len) {
     mp_obj_str_t *o = mp_obj_malloc(mp_obj_str_t, type);
+    o->hash = MP_OBJ_STR_HASH_LAZY;
     o->len = len;
     if (data) {
-        o->hash = qstr_compute_hash(data, len);
         byte *p = m_new(byte, len + 1);
         o->data = p;
         memcpy(p, data, len * sizeof(byte));
@@ -2277,7 +2287,7 @@ mp_obj_t mp_obj_new_str_type_from_vstr(const mp_obj_type_t *type, vstr_t *vstr)
     #endif
     mp_obj_str_t *o = mp_obj_malloc(mp_obj_str_t, type);
     o->len = vstr->len;
-    o->hash = qstr_compute_hash(data, vstr->len);
+    o->hash = MP_OBJ_STR_HASH_LAZY;
     o->data = data;
     return MP_OBJ_FROM_PTR(o);
 }
@@ -46,6 +46,12 @@ typedef struct _mp_obj_str_t {
 
 #define MP_DEFINE_STR_OBJ(obj_name, str) mp_obj_str_t obj_name = {{&mp_type_str}, 0, sizeof(str) - 1, (const byte *)str}
 
+// Value of the hash field of a str/bytes object in RAM whose hash hasn't been
+// computed yet. The hash is computed on first use and then cached in the object.
+// A hash field of 0 also means not computed, but for objects that may be in ROM,
+// so the hash is recomputed every time it's needed.
+#define MP_OBJ_STR_HASH_LAZY ((size_t)-1)
+
 // use this macro to extract the string hash
 // warning: the hash can be 0, meaning invalid, and must then be explicitly computed from the data
 #define GET_STR_HASH(str_obj_in, str_hash) \
@@ -54,6 +60,9 @@ typedef struct _mp_obj_str_t {
         str_hash = qstr_hash(MP_OBJ_QSTR_VALUE(str_obj_in)); \
     } else { \
         str_hash = ((mp_obj_str_t *)MP_OBJ_TO_PTR(str_obj_in))->hash; \
+        if (str_hash == MP_OBJ_STR_HASH_LAZY) { \
+            str_hash = 0; \
+        } \
     }
 
 // use this macro to extract the string length
@@ -97,6 +106,20 @@ mp_int_t mp_obj_str_get_buffer(mp_obj_t self_in, mp_buffer_info_t *bufinfo, mp_u
 
 void mp_obj_str_set_data(mp_obj_str_t *str, const byte *data, size_t len);
 
+size_t mp_obj_str_compute_hash(mp_obj_t self_in);
+
+// Returns the hash of a str/bytes object, computing it if it isn't cached yet.
+static inline size_t mp_obj_str_get_hash(mp_obj_t self_in) {
+    if (mp_obj_is_qstr(self_in)) {
+        return qstr_hash(MP_OBJ_QSTR_VALUE(self_in));
+    }
+    size_t hash = ((mp_obj_str_t *)MP_OBJ_TO_PTR(self_in))->hash;
+    if (hash == 0 || hash == MP_OBJ_STR_HASH_LAZY) {
+        hash = mp_obj_str_compute_hash(self_in);
+    }
+    return hash;
+}
+
 const byte *str_index_to_ptr(const mp_obj_type_t *type, const byte *self_data, size_t self_len,
     mp_obj_t index, bool is_slice);
 const byte *find_subbytes(const byte *haystack, size_t hlen, const byte *needle, size_t nlen, int direction);
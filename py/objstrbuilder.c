@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#include "py/mpconfig.h"
+
+#if MICROPY_PY_MICROPYTHON_STRINGBUILDER
+
+#include <string.h>
+
+#include "py/runtime.h"
+#include "py/stream.h"
+
+// Accumulates str, bytes and int pieces into one growable buffer and then hands
+// that buffer over to a new str or bytes object, so neither a list of pieces
+// nor a final copy is needed. The buffer grows geometrically (vstr on its own
+// only grows by what's asked for), which keeps appending amortised O(1) even
+// when the heap can't extend the buffer in place.
+
+typedef struct _mp_obj_strbuilder_t {
+    mp_obj_base_t base;
+    vstr_t vstr;
+} mp_obj_strbuilder_t;
+
+static char *strbuilder_add_len(mp_obj_strbuilder_t *self, size_t len) {
+    vstr_t *vstr = &self->vstr;
+    if (vstr->alloc - vstr->len < len) {
+        vstr_hint_size(vstr, MAX(len, vstr->len / 2));
+    }
+    return vstr_add_len(vstr, len);
+}
+
+static void strbuilder_print_strn(void *data, const char *str, size_t len) {
+    memcpy(strbuilder_add_len(data, len), str, len);
+}
+
+static void strbuilder_append(mp_obj_strbuilder_t *self, mp_obj_t arg) {
+    if (mp_obj_is_int(arg)) {
+        // Format straight into the buffer.
+        mp_print_t print = { self, strbuilder_print_strn };
+        mp_obj_print_helper(&print, arg, PRINT_STR);
+        return;
+    }
+    mp_buffer_info_t bufinfo;
+    if (!mp_get_buffer(arg, &bufinfo, MP_BUFFER_READ)) {
+        mp_raise_TypeError(MP_ERROR_TEXT("can't convert to str or bytes"));
+    }
+    memcpy(strbuilder_add_len(self, bufinfo.len), bufinfo.buf, bufinfo.len);
+}
+
+static mp_obj_t strbuilder_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 0, 1, false);
+    mp_int_t size_hint = n_args > 0 ? mp_obj_get_int(args[0]) : 0;
+    if (size_hint < 0) {
+        mp_raise_ValueError(NULL);
+    }
+    mp_obj_strbuilder_t *self = mp_obj_malloc(mp_obj_strbuilder_t, type);
+    // Leave room for the null byte added when the buffer becomes a str.
+    vstr_init(&self->vstr, size_hint + 1);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+static mp_obj_t strbuilder_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
+    mp_obj_strbuilder_t *self = MP_OBJ_TO_PTR(self_in);
+    switch (op) {
+        case MP_UNARY_OP_BOOL:
+            return mp_obj_new_bool(self->vstr.len != 0);
+        case MP_UNARY_OP_LEN:
+            return MP_OBJ_NEW_SMALL_INT(self->vstr.len);
+        default:
+            return MP_OBJ_NULL; // op not supported
+    }
+}
+
+static mp_obj_t strbuilder_binary_op(mp_binary_op_t op, mp_obj_t lhs_in, mp_obj_t rhs_in) {
+    if (op != MP_BINARY_OP_INPLACE_ADD) {
+        return MP_OBJ_NULL; // op not supported
+    }
+    strbuilder_append(MP_OBJ_TO_PTR(lhs_in), rhs_in);
+    return lhs_in;
+}
+
+static mp_uint_t strbuilder_write(mp_obj_t self_in, const void *buf, mp_uint_t size, int *errcode) {
+    (void)errcode;
+    memcpy(strbuilder_add_len(MP_OBJ_TO_PTR(self_in), size), buf, size);
+    return size;
+}
+
+static mp_obj_t strbuilder_append_method(size_t n_args, const mp_obj_t *args) {
+    mp_obj_strbuilder_t *self = MP_OBJ_TO_PTR(args[0]);
+    for (size_t i = 1; i < n_args; i++) {
+        strbuilder_append(self, args[i]);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR(strbuilder_append_obj, 2, strbuilder_append_method);
+
+static mp_obj_t strbuilder_build_helper(mp_obj_t self_in, const mp_obj_type_t *type) {
+    mp_obj_strbuilder_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t result;
+    if (type == &mp_type_str) {
+        // Checks the data is utf-8, leaving the builder untouched if not.
+        result = mp_obj_new_str_from_vstr(&self->vstr);
+    } else {
+        result = mp_obj_new_bytes_from_vstr(&self->vstr);
+    }
+    // The buffer now belongs to the result, so start again with an empty one.
+    self->vstr.len = 0;
+    return result;
+}
+
+static mp_obj_t strbuilder_build(mp_obj_t self_in) {
+    return strbuilder_build_helper(self_in, &mp_type_str);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(strbuilder_build_obj, strbuilder_build);
+
+static mp_obj_t strbuilder_build_bytes(mp_obj_t self_in) {
+    return strbuilder_build_helper(self_in, &mp_type_bytes);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(strbuilder_build_bytes_obj, strbuilder_build_bytes);
+
+static mp_obj_t strbuilder_clear(mp_obj_t self_in) {
+    mp_obj_strbuilder_t *self = MP_OBJ_TO_PTR(self_in);
+    self->vstr.len = 0;
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(strbuilder_clear_obj, strbuilder_clear);
+
+static const mp_rom_map_elem_t strbuilder_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_append), MP_ROM_PTR(&strbuilder_append_obj) },
+    { MP_ROM_QSTR(MP_QSTR_write), MP_ROM_PTR(&mp_stream_write_obj) },
+    { MP_ROM_QSTR(MP_QSTR_build), MP_ROM_PTR(&strbuilder_build_obj) },
+    { MP_ROM_QSTR(MP_QSTR_build_bytes), MP_ROM_PTR(&strbuilder_build_bytes_obj) },
+    { MP_ROM_QSTR(MP_QSTR_clear), MP_ROM_PTR(&strbuilder_clear_obj) },
+};
+static MP_DEFINE_CONST_DICT(strbuilder_locals_dict, strbuilder_locals_dict_table);
+
+static const mp_stream_p_t strbuilder_stream_p = {
+    .write = strbuilder_write,
+    .is_text = false,
+};
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    mp_type_stringbuilder,
+    MP_QSTR_StringBuilder,
+    MP_TYPE_FLAG_NONE,
+    make_new, strbuilder_make_new,
+    unary_op, strbuilder_unary_op,
+    binary_op, strbuilder_binary_op,
+    protocol, &strbuilder_stream_p,
+    locals_dict, &strbuilder_locals_dict
+    );
+
+#endif // MICROPY_PY_MICROPYTHON_STRINGBUILDER
@@ -92,10 +92,8 @@ static mp_uint_t stringio_write(mp_obj_t o_in, const void *buf, mp_uint_t size,
     }
     mp_uint_t org_len = o->vstr->len;
     if (new_pos > o->vstr->alloc) {
-        // Take all what's already allocated...
-        o->vstr->len = o->vstr->alloc;
-        // ... and add more
-        vstr_add_len(o->vstr, new_pos - o->vstr->alloc);
+        // Grow geometrically, so that many small writes take linear time
+        vstr_hint_size(o->vstr, MAX(new_pos, o->vstr->alloc + o->vstr->alloc / 2) - org_len);
     }
     // If there was a seek past EOF, clear the hole
     if (o->pos > org_len) {
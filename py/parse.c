@@ -214,15 +214,6 @@ typedef struct _rule_stack_t {
     size_t arg_i; // this dictates the maximum nodes in a "list" of things
 } rule_stack_t;
 
-typedef struct _mp_parse_chunk_t {
-    size_t alloc;
-    union {
-        size_t used;
-        struct _mp_parse_chunk_t *next;
-    } union_;
-    byte data[];
-} mp_parse_chunk_t;
-
 typedef struct _parser_t {
     size_t rule_stack_alloc;
     size_t rule_stack_top;
@@ -235,7 +226,6 @@ typedef struct _parser_t {
     mp_lexer_t *lexer;
 
     mp_parse_tree_t tree;
-    mp_parse_chunk_t *cur_chunk;
 
     #if MICROPY_COMP_CONST
     mp_map_t consts;
@@ -253,53 +243,14 @@ static const uint16_t *get_rule_arg(uint8_t r_id) {
 }
 
 static void *parser_alloc(parser_t *parser, size_t num_bytes) {
-    // use a custom memory allocator to store parse nodes sequentially in large chunks
-
-    mp_parse_chunk_t *chunk = parser->cur_chunk;
-
-    if (chunk != NULL && chunk->union_.used + num_bytes > chunk->alloc) {
-        // not enough room at end of previously allocated chunk so try to grow
-        mp_parse_chunk_t *new_data = (mp_parse_chunk_t *)m_renew_maybe(byte, chunk,
-            sizeof(mp_parse_chunk_t) + chunk->alloc,
-            sizeof(mp_parse_chunk_t) + chunk->alloc + num_bytes, false);
-        if (new_data == NULL) {
-            // could not grow existing memory; shrink it to fit previous
-            (void)m_renew_maybe(byte, chunk, sizeof(mp_parse_chunk_t) + chunk->alloc,
-                sizeof(mp_parse_chunk_t) + chunk->union_.used, false);
-            chunk->alloc = chunk->union_.used;
-            chunk->union_.next = parser->tree.chunk;
-            parser->tree.chunk = chunk;
-            chunk = NULL;
-        } else {
-            // could grow existing memory
-            chunk->alloc += num_bytes;
-        }
-    }
-
-    if (chunk == NULL) {
-        // no previous chunk, allocate a new chunk
-        size_t alloc = MICROPY_ALLOC_PARSE_CHUNK_INIT;
-        if (alloc < num_bytes) {
-            alloc = num_bytes;
-        }
-        chunk = (mp_parse_chunk_t *)m_new(byte, sizeof(mp_parse_chunk_t) + alloc);
-        chunk->alloc = alloc;
-        chunk->union_.used = 0;
-        parser->cur_chunk = chunk;
-    }
-
-    byte *ret = chunk->data + chunk->union_.used;
-    chunk->union_.used += num_bytes;
-    return ret;
+    // use an arena to store parse nodes sequentially in large chunks
+    return mp_arena_alloc(&parser->tree.arena, num_bytes);
 }
 
 #if MICROPY_COMP_CONST_TUPLE
 static void parser_free_parse_node_struct(parser_t *parser, mp_parse_node_struct_t *pns) {
-    mp_parse_chunk_t *chunk = parser->cur_chunk;
-    if (chunk->data <= (byte *)pns && (byte *)pns < chunk->data + chunk->union_.used) {
-        size_t num_bytes = sizeof(mp_parse_node_struct_t) + sizeof(mp_parse_node_t) * MP_PARSE_NODE_STRUCT_NUM_NODES(pns);
-        chunk->union_.used -= num_bytes;
-    }
+    size_t num_bytes = sizeof(mp_parse_node_struct_t) + sizeof(mp_parse_node_t) * MP_PARSE_NODE_STRUCT_NUM_NODES(pns);
+    mp_arena_free(&parser->tree.arena, pns, num_bytes);
 }
 #endif
 
@@ -453,6 +404,34 @@ bool mp_parse_node_is_const_true(mp_parse_node_t pn) {
     return parse_node_is_const_bool(pn, true);
 }
 
+bool mp_parse_node_affects_scope(mp_parse_node_t pn) {
+    // Whether pn contains a yield or await, which make the enclosing function a
+    // generator or coroutine, or a := which makes the name local to it.
+    if (!MP_PARSE_NODE_IS_STRUCT(pn)) {
+        return false;
+    }
+    mp_parse_node_struct_t *pns = (mp_parse_node_struct_t *)pn;
+    switch (MP_PARSE_NODE_STRUCT_KIND(pns)) {
+        case RULE_const_object:
+            return false;
+        case RULE_yield_expr:
+        #if MICROPY_PY_ASYNC_AWAIT
+        case RULE_atom_expr_await:
+        #endif
+        #if MICROPY_PY_ASSIGN_EXPR
+        case RULE_namedexpr_test:
+        #endif
+            return true;
+    }
+    size_t n = MP_PARSE_NODE_STRUCT_NUM_NODES(pns);
+    for (size_t i = 0; i < n; i++) {
+        if (mp_parse_node_affects_scope(pns->nodes[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
 size_t mp_parse_node_extract_list(mp_parse_node_t *pn, size_t pn_kind, mp_parse_node_t **nodes) {
     if (MP_PARSE_NODE_IS_NULL(*pn)) {
         *nodes = NULL;
@@ -909,6 +888,177 @@ static bool fold_constants(parser_t *parser, uint8_t rule_id, size_t num_args) {
     return true;
 }
 
+#if MICROPY_COMP_CONST_FOLDING_EXTRA
+static bool fold_comparison_operand_maybe(mp_parse_node_t pn, mp_obj_t *o) {
+    if (!mp_parse_node_is_const(pn)) {
+        return false;
+    }
+    *o = mp_parse_node_convert_to_obj(pn);
+    #if MICROPY_DYNAMIC_COMPILER && MICROPY_PY_BUILTINS_FLOAT
+    // the target may use a different float precision, so leave float comparisons to run-time
+    if (mp_obj_is_float(*o)) {
+        return false;
+    }
+    #endif
+    return true;
+}
+
+#if MICROPY_PY_STR_BYTES_CMP_WARN
+// Returns bit 0 set if o is or contains a str, and bit 1 set if it is or contains bytes.
+static unsigned int fold_comparison_str_bytes(mp_obj_t o) {
+    if (mp_obj_is_str(o)) {
+        return 1;
+    } else if (mp_obj_is_type(o, &mp_type_bytes)) {
+        return 2;
+    } else if (mp_obj_is_type(o, &mp_type_tuple)) {
+        size_t len;
+        mp_obj_t *items;
+        mp_obj_tuple_get(o, &len, &items);
+        unsigned int kinds = 0;
+        for (size_t i = 0; i < len; ++i) {
+            kinds |= fold_comparison_str_bytes(items[i]);
+        }
+        return kinds;
+    }
+    return 0;
+}
+#endif
+
+static bool fold_comparison(parser_t *parser, uint8_t rule_id, size_t num_args) {
+    // this code does folding of comparisons of constants, eg 1 < 2 or "a" in ("a", "b")
+    // identity tests are not folded because the identity of constant objects is not defined
+
+    if (rule_id != RULE_comparison) {
+        return false;
+    }
+
+    mp_obj_t lhs;
+    if (!fold_comparison_operand_maybe(peek_result(parser, num_args - 1), &lhs)) {
+        return false;
+    }
+    bool value = true;
+    for (ssize_t i = num_args - 2; i >= 1; i -= 2) {
+        mp_obj_t rhs;
+        if (!fold_comparison_operand_maybe(peek_result(parser, i - 1), &rhs)) {
+            return false;
+        }
+        #if MICROPY_PY_STR_BYTES_CMP_WARN
+        if ((fold_comparison_str_bytes(lhs) | fold_comparison_str_bytes(rhs)) == 3) {
+            // leave the BytesWarning to run-time
+            return false;
+        }
+        #endif
+        mp_parse_node_t pn_op = peek_result(parser, i);
+        mp_binary_op_t op;
+        bool invert = false;
+        if (MP_PARSE_NODE_IS_TOKEN(pn_op)) {
+            mp_token_kind_t tok = MP_PARSE_NODE_LEAF_ARG(pn_op);
+            if (tok == MP_TOKEN_KW_IN) {
+                op = MP_BINARY_OP_IN;
+            } else {
+                op = MP_BINARY_OP_LESS + (tok - MP_TOKEN_OP_LESS);
+            }
+        } else if (MP_PARSE_NODE_IS_STRUCT_KIND(pn_op, RULE_comp_op_not_in)) {
+            op = MP_BINARY_OP_IN;
+            invert = true;
+        } else {
+            return false;
+        }
+        mp_obj_t res;
+        if (!binary_op_maybe(op, lhs, rhs, &res)) {
+            return false;
+        }
+        if (mp_obj_is_true(res) == invert) {
+            value = false;
+        }
+        lhs = rhs;
+    }
+
+    // success folding this rule
+
+    for (size_t i = num_args; i > 0; i--) {
+        pop_result(parser);
+    }
+    push_result_node(parser, mp_parse_node_new_leaf(MP_PARSE_NODE_TOKEN, value ? MP_TOKEN_KW_TRUE : MP_TOKEN_KW_FALSE));
+
+    return true;
+}
+
+static bool fold_conditional(parser_t *parser, uint8_t rule_id) {
+    // folding for conditional expressions with a constant condition: a if c else b
+
+    if (rule_id != RULE_test_if_expr) {
+        return false;
+    }
+
+    mp_parse_node_struct_t *pns_test_if_else = (mp_parse_node_struct_t *)peek_result(parser, 0);
+    mp_parse_node_t pn, pn_dropped;
+    if (mp_parse_node_is_const_true(pns_test_if_else->nodes[0])) {
+        pn = peek_result(parser, 1);
+        pn_dropped = pns_test_if_else->nodes[1];
+    } else if (mp_parse_node_is_const_false(pns_test_if_else->nodes[0])) {
+        pn = pns_test_if_else->nodes[1];
+        pn_dropped = peek_result(parser, 1);
+    } else {
+        return false;
+    }
+    if (mp_parse_node_affects_scope(pn_dropped)) {
+        // the dropped branch is never run but still changes how the function is compiled
+        return false;
+    }
+    pop_result(parser);
+    pop_result(parser);
+    push_result_node(parser, pn);
+    return true;
+}
+
+static void fold_const_list(parser_t *parser, size_t n) {
+    // A list of constants that is only iterated over or tested for membership can be
+    // replaced with a constant tuple, so it is not rebuilt each time it is evaluated,
+    // eg for x in [1, 2]: or x in [1, 2].
+    mp_parse_node_t pn = peek_result(parser, n);
+    if (!MP_PARSE_NODE_IS_STRUCT_KIND(pn, RULE_atom_bracket)) {
+        return;
+    }
+    mp_parse_node_struct_t *pns = (mp_parse_node_struct_t *)pn;
+    mp_parse_node_t *items = &pns->nodes[0];
+    size_t num_items = 1;
+    if (MP_PARSE_NODE_IS_NULL(pns->nodes[0])) {
+        num_items = 0;
+    } else if (MP_PARSE_NODE_IS_STRUCT_KIND(pns->nodes[0], RULE_testlist_comp)) {
+        mp_parse_node_struct_t *pns_list = (mp_parse_node_struct_t *)pns->nodes[0];
+        items = pns_list->nodes;
+        num_items = MP_PARSE_NODE_STRUCT_NUM_NODES(pns_list);
+    }
+    for (size_t i = 0; i < num_items; i++) {
+        if (!mp_parse_node_is_const(items[i])) {
+            return;
+        }
+    }
+    mp_obj_tuple_t *tuple = MP_OBJ_TO_PTR(mp_obj_new_tuple(num_items, NULL));
+    for (size_t i = 0; i < num_items; i++) {
+        tuple->items[i] = mp_parse_node_convert_to_obj(items[i]);
+    }
+    parser->result_stack[parser->result_stack_top - 1 - n] = make_node_const_object(parser, pns->source_line, MP_OBJ_FROM_PTR(tuple));
+}
+
+static void fold_const_lists(parser_t *parser, uint8_t rule_id, size_t num_args) {
+    if (rule_id == RULE_comparison) {
+        // right-hand side of the last in or not in of a chain; earlier operands are
+        // also compared with the next one, eg x in [1, 2] == [1, 2], so stay lists
+        mp_parse_node_t pn_op = peek_result(parser, 1);
+        if (MP_PARSE_NODE_IS_TOKEN_KIND(pn_op, MP_TOKEN_KW_IN)
+            || MP_PARSE_NODE_IS_STRUCT_KIND(pn_op, RULE_comp_op_not_in)) {
+            fold_const_list(parser, 0);
+        }
+    } else if (rule_id == RULE_for_stmt || rule_id == RULE_comp_for) {
+        // the iterable, which is the 2nd of 4 arguments
+        assert(num_args == 4);
+        fold_const_list(parser, 2);
+    }
+}
+#endif // MICROPY_COMP_CONST_FOLDING_EXTRA
+
 #endif // MICROPY_COMP_CONST_FOLDING
 
 #if MICROPY_COMP_CONST_TUPLE
@@ -1010,6 +1160,14 @@ static void push_result_rule(parser_t *parser, size_t src_line, uint8_t rule_id,
     }
 
     #if MICROPY_COMP_CONST_FOLDING
+    #if MICROPY_COMP_CONST_FOLDING_EXTRA
+    fold_const_lists(parser, rule_id, num_args);
+    if (fold_comparison(parser, rule_id, num_args)
+        || fold_conditional(parser, rule_id)) {
+        // we folded this rule so return straight away
+        return;
+    }
+    #endif
     if (fold_logical_constants(parser, rule_id, &num_args)) {
         // we folded this rule so return straight away
         return;
@@ -1059,8 +1217,7 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
 
     parser.lexer = lex;
 
-    parser.tree.chunk = NULL;
-    parser.cur_chunk = NULL;
+    mp_arena_init(&parser.tree.arena, MICROPY_ALLOC_PARSE_CHUNK_INIT);
 
     #if MICROPY_COMP_CONST
     mp_map_init(&parser.consts, 0);
@@ -1342,17 +1499,6 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
     mp_map_deinit(&parser.consts);
     #endif
 
-    // truncate final chunk and link into chain of chunks
-    if (parser.cur_chunk != NULL) {
-        (void)m_renew_maybe(byte, parser.cur_chunk,
-            sizeof(mp_parse_chunk_t) + parser.cur_chunk->alloc,
-            sizeof(mp_parse_chunk_t) + parser.cur_chunk->union_.used,
-            false);
-        parser.cur_chunk->alloc = parser.cur_chunk->union_.used;
-        parser.cur_chunk->union_.next = parser.tree.chunk;
-        parser.tree.chunk = parser.cur_chunk;
-    }
-
     if (
         lex->tok_kind != MP_TOKEN_END // check we are at the end of the token stream
         || parser.result_stack_top == 0 // check that we got a node (can fail on empty input)
@@ -1395,13 +1541,7 @@ mp_parse_tree_t mp_parse(mp_lexer_t *lex, mp_parse_input_kind_t input_kind) {
 }
 
 void mp_parse_tree_clear(mp_parse_tree_t *tree) {
-    mp_parse_chunk_t *chunk = tree->chunk;
-    while (chunk != NULL) {
-        mp_parse_chunk_t *next = chunk->union_.next;
-        m_del(byte, chunk, sizeof(mp_parse_chunk_t) + chunk->alloc);
-        chunk = next;
-    }
-    tree->chunk = NULL; // Avoid dangling pointer that may live on stack
+    mp_arena_free_all(&tree->arena);
 }
 
 #endif // MICROPY_ENABLE_COMPILER
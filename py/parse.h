@@ -29,6 +29,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "py/arena.h"
 #include "py/obj.h"
 
 struct _mp_lexer_t;
@@ -93,6 +94,7 @@ static inline mp_obj_t mp_parse_node_extract_const_object(mp_parse_node_struct_t
 
 bool mp_parse_node_is_const_false(mp_parse_node_t pn);
 bool mp_parse_node_is_const_true(mp_parse_node_t pn);
+bool mp_parse_node_affects_scope(mp_parse_node_t pn);
 bool mp_parse_node_get_int_maybe(mp_parse_node_t pn, mp_obj_t *o);
 size_t mp_parse_node_extract_list(mp_parse_node_t *pn, size_t pn_kind, mp_parse_node_t **nodes);
 void mp_parse_node_print(const mp_print_t *print, mp_parse_node_t pn, size_t indent);
@@ -105,12 +107,14 @@ typedef enum {
 
 typedef struct _mp_parse_t {
     mp_parse_node_t root;
-    struct _mp_parse_chunk_t *chunk;
+    // Holds the parse nodes, and the compiler's scratch data for this tree.
+    mp_arena_t arena;
 } mp_parse_tree_t;
 
 // the parser will raise an exception if an error occurred
 // the parser will free the lexer before it returns
 mp_parse_tree_t mp_parse(struct _mp_lexer_t *lex, mp_parse_input_kind_t input_kind);
+// frees the parse nodes and everything else allocated in the tree's arena
 void mp_parse_tree_clear(mp_parse_tree_t *tree);
 
 #endif // MICROPY_INCLUDED_PY_PARSE_H
@@ -35,6 +35,13 @@
 
 #if MICROPY_PY_BUILTINS_FLOAT
 #include <math.h>
+#if MICROPY_FLOAT_PARSE_EISEL_LEMIRE
+#include "py/floatpow5.h"
+#if MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_MPZ && MICROPY_ENABLE_GC
+#include "py/gc.h"
+#include "py/mpz.h"
+#endif
+#endif
 #endif
 
 static MP_NORETURN void raise_exc(mp_obj_t exc, mp_lexer_t *lex) {
@@ -282,6 +289,215 @@ mp_large_float_t mp_decimal_exp(mp_large_float_t num, int dec_exp) {
 }
 
 
+#if MICROPY_FLOAT_PARSE_EISEL_LEMIRE
+
+// Powers of 10 that are exact in a mp_float_t, for Clinger's fast path: when the
+// decimal mantissa is exact too, one correctly rounded multiply or divide gives
+// the correctly rounded result.
+static const mp_float_t exact_powers_of_10[MAX_EXACT_POWER_OF_5 + 1] = {
+    MICROPY_FLOAT_CONST(1e0), MICROPY_FLOAT_CONST(1e1), MICROPY_FLOAT_CONST(1e2), MICROPY_FLOAT_CONST(1e3),
+    MICROPY_FLOAT_CONST(1e4), MICROPY_FLOAT_CONST(1e5), MICROPY_FLOAT_CONST(1e6), MICROPY_FLOAT_CONST(1e7),
+    MICROPY_FLOAT_CONST(1e8), MICROPY_FLOAT_CONST(1e9), MICROPY_FLOAT_CONST(1e10),
+    #if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    #endif
+};
+
+// Range of q where w * 5^q may be exactly halfway between two floats
+#if MICROPY_FLOAT_IMPL == MICROPY_FLOAT_IMPL_DOUBLE
+#define MIN_Q_ROUND_TO_EVEN (-4)
+#define MAX_Q_ROUND_TO_EVEN (23)
+#else
+#define MIN_Q_ROUND_TO_EVEN (-17)
+#define MAX_Q_ROUND_TO_EVEN (10)
+#endif
+
+#define INFINITE_POWER_2 ((1 << MP_FLOAT_EXP_BITS) - 1)
+
+// Returns the high 64 bits of a * b and stores the low 64 bits in *lo
+static uint64_t mul_64x64(uint64_t a, uint64_t b, uint64_t *lo) {
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32;
+    uint64_t b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t p0 = a_lo * b_lo, p1 = a_lo * b_hi, p2 = a_hi * b_lo;
+    uint64_t mid = (p0 >> 32) + (uint32_t)p1 + (uint32_t)p2;
+    *lo = (mid << 32) | (uint32_t)p0;
+    return a_hi * b_hi + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+}
+
+// Computes w * 10^q correctly rounded, with the Eisel-Lemire algorithm from
+// "Number Parsing at a Gigabyte per Second" (Daniel Lemire, 2021). Returns false
+// in the rare cases where a 128-bit approximation of 5^q can't decide rounding.
+static bool eisel_lemire(uint64_t w, int q, mp_float_t *res) {
+    mp_float_union_t u;
+    if (w == 0 || q < MP_FLOAT_POW5_MIN_Q) {
+        u.i = 0;
+    } else if (q > MP_FLOAT_POW5_MAX_Q) {
+        u.i = (mp_float_uint_t)INFINITE_POWER_2 << MP_FLOAT_FRAC_BITS;
+    } else {
+        // Multiply the normalised mantissa by the high half of 5^q, and only use
+        // the low half if all the bits below the result's rounding bit are set.
+        int lz = mp_clzll(w);
+        w <<= lz;
+        const uint64_t *pow5 = mp_float_pow5_128[q - MP_FLOAT_POW5_MIN_Q];
+        uint64_t lo;
+        uint64_t hi = mul_64x64(w, pow5[0], &lo);
+        uint64_t precision_mask = UINT64_MAX >> (MP_FLOAT_FRAC_BITS + 3);
+        if ((hi & precision_mask) == precision_mask) {
+            uint64_t lo2;
+            uint64_t hi2 = mul_64x64(w, pow5[1], &lo2);
+            lo += hi2;
+            if (hi2 > lo) {
+                hi++;
+            }
+        }
+        if (lo == UINT64_MAX && (q < -27 || q > 55)) {
+            return false;
+        }
+
+        // Keep the top FRAC_BITS + 2 bits, which leaves one bit for rounding
+        int upperbit = (int)(hi >> 63);
+        int shift = upperbit + 64 - MP_FLOAT_FRAC_BITS - 3;
+        uint64_t mantissa = hi >> shift;
+        int power2 = ((217706 * q) >> 16) + 63 + upperbit - lz + MP_FLOAT_EXP_BIAS;
+        if (power2 <= 0) {
+            // Subnormal, which may round up to the smallest normal
+            if (-power2 + 1 >= 64) {
+                mantissa = 0;
+            } else {
+                mantissa >>= -power2 + 1;
+                mantissa += mantissa & 1;
+                mantissa >>= 1;
+            }
+            power2 = 0;
+        } else {
+            // Round half to even, when the product is exact and exactly halfway
+            if (lo <= 1 && q >= MIN_Q_ROUND_TO_EVEN && q <= MAX_Q_ROUND_TO_EVEN
+                && (mantissa & 3) == 1 && (mantissa << shift) == hi) {
+                mantissa &= ~(uint64_t)1;
+            }
+            mantissa += mantissa & 1;
+            mantissa >>= 1;
+            if (mantissa >= (uint64_t)2 << MP_FLOAT_FRAC_BITS) {
+                mantissa >>= 1;
+                power2++;
+            }
+            mantissa &= ~((uint64_t)1 << MP_FLOAT_FRAC_BITS);
+            if (power2 >= INFINITE_POWER_2) {
+                power2 = INFINITE_POWER_2;
+                mantissa = 0;
+            }
+        }
+        // A subnormal mantissa that rounded up to 1 << FRAC_BITS becomes the smallest normal
+        u.i = (mp_float_uint_t)(mantissa + ((uint64_t)power2 << MP_FLOAT_FRAC_BITS));
+    }
+    *res = u.f;
+    return true;
+}
+
+#if MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_MPZ && MICROPY_ENABLE_GC
+
+// Compares d * 10^q with m * 2^p, where pow5 is 5^|q| and d5 is d * 5^q if q >= 0
+static int cmp_decimal_binary(const mpz_t *d5, int q, const mpz_t *pow5, uint64_t m, int p) {
+    mpz_t lhs, rhs;
+    mpz_init_zero(&lhs);
+    mpz_init_zero(&rhs);
+    mpz_set(&lhs, d5);
+    mpz_set_from_ll(&rhs, (long long)m, false);
+    if (q < 0) {
+        mpz_mul_inpl(&rhs, &rhs, pow5);
+    }
+    if (q > p) {
+        mpz_shl_inpl(&lhs, &lhs, q - p);
+    } else {
+        mpz_shl_inpl(&rhs, &rhs, p - q);
+    }
+    int c = mpz_cmp(&lhs, &rhs);
+    mpz_deinit(&lhs);
+    mpz_deinit(&rhs);
+    return c;
+}
+
+// Returns the correctly rounded value of the digits in str..top (which may also
+// contain a '.' and '_') times 10^exp, given a guess that is a few ulps out at most.
+// The exact value is compared with the midpoints between the guess and its
+// neighbours using mpz, and the guess moved until it lies between them.
+static mp_float_t parse_float_exact(const char *str, const char *top, int exp, mp_float_t guess) {
+    mpz_t d5, pow5, tmp;
+    mpz_init_zero(&d5);
+    mpz_init_zero(&pow5);
+    mpz_init_zero(&tmp);
+
+    // Read the digits 9 at a time
+    bool in_frac = false;
+    mp_int_t chunk = 0;
+    mp_int_t chunk_scale = 1;
+    for (; str <= top; str++) {
+        if (str < top && *str == '.') {
+            in_frac = true;
+        } else if (str < top && unichar_isdigit(*str)) {
+            chunk = chunk * 10 + (*str - '0');
+            chunk_scale *= 10;
+            exp -= in_frac;
+        }
+        if (chunk_scale == 1000000000 || (str == top && chunk_scale > 1)) {
+            mpz_set_from_int(&tmp, chunk_scale);
+            mpz_mul_inpl(&d5, &d5, &tmp);
+            mpz_set_from_int(&tmp, chunk);
+            mpz_add_inpl(&d5, &d5, &tmp);
+            chunk = 0;
+            chunk_scale = 1;
+        }
+    }
+    mpz_set_from_int(&pow5, 5);
+    mpz_set_from_int(&tmp, exp < 0 ? -exp : exp);
+    mpz_pow_inpl(&pow5, &pow5, &tmp);
+    if (exp >= 0) {
+        mpz_mul_inpl(&d5, &d5, &pow5);
+    }
+
+    mp_float_union_t u = { guess };
+    for (;;) {
+        uint64_t frc = u.p.frc;
+        int e = 1 - MP_FLOAT_EXP_BIAS - MP_FLOAT_FRAC_BITS;
+        if (u.p.exp != 0) {
+            frc |= (uint64_t)1 << MP_FLOAT_FRAC_BITS;
+            e += u.p.exp - 1;
+        }
+        // Ties go to the float with an even significand
+        int odd = frc & 1;
+        if (u.p.exp != INFINITE_POWER_2) {
+            int c = cmp_decimal_binary(&d5, exp, &pow5, 2 * frc + 1, e - 1);
+            if (c > 0 || (c == 0 && odd)) {
+                u.i++;
+                continue;
+            }
+        }
+        if (u.i != 0) {
+            // The float below is closer when this one has a power of 2 significand
+            int c;
+            if (u.p.frc == 0 && u.p.exp > 1) {
+                c = cmp_decimal_binary(&d5, exp, &pow5, 4 * frc - 1, e - 2);
+            } else {
+                c = cmp_decimal_binary(&d5, exp, &pow5, 2 * frc - 1, e - 1);
+            }
+            if (c < 0 || (c == 0 && odd)) {
+                u.i--;
+                continue;
+            }
+        }
+        break;
+    }
+
+    mpz_deinit(&d5);
+    mpz_deinit(&pow5);
+    mpz_deinit(&tmp);
+    return u.f;
+}
+
+#endif
+
+#endif // MICROPY_FLOAT_PARSE_EISEL_LEMIRE
+
 // Break out inner digit accumulation routine to ease trailing zero deferral.
 static mp_large_float_uint_t accept_digit(mp_large_float_uint_t p_mantissa, unsigned int dig, int *p_exp_extra, int in) {
     // Core routine to ingest an additional digit.
@@ -304,6 +520,10 @@ static mp_large_float_uint_t accept_digit(mp_large_float_uint_t p_mantissa, unsi
 // Helper to parse an unsigned decimal number into a mp_float_t
 const char *mp_parse_float_internal(const char *str, size_t len, mp_float_t *res) {
     const char *top = str + len;
+    #if MICROPY_FLOAT_PARSE_EISEL_LEMIRE && MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_MPZ && MICROPY_ENABLE_GC
+    const char *str_start = str;
+    const char *mant_top = NULL;
+    #endif
 
     parse_dec_in_t in = PARSE_DEC_IN_INTG;
     bool exp_neg = false;
@@ -311,6 +531,7 @@ const char *mp_parse_float_internal(const char *str, size_t len, mp_float_t *res
     int exp_val = 0;
     int exp_extra = 0;
     int trailing_zeros_intg = 0, trailing_zeros_frac = 0;
+    bool truncated = false; // whether nonzero digits were dropped from the mantissa
     while (str < top) {
         unsigned int dig = *str++;
         if ('0' <= dig && dig <= '9') {
@@ -326,6 +547,7 @@ const char *mp_parse_float_internal(const char *str, size_t len, mp_float_t *res
                 if (dig == 0 || mantissa >= MANTISSA_MAX) {
                     // Defer treatment of zeros in fractional part.  If nothing comes afterwards, ignore them.
                     // Also, once we reach MANTISSA_MAX, treat every additional digit as a trailing zero.
+                    truncated |= dig != 0;
                     if (in == PARSE_DEC_IN_INTG) {
                         ++trailing_zeros_intg;
                     } else {
@@ -341,6 +563,7 @@ const char *mp_parse_float_internal(const char *str, size_t len, mp_float_t *res
                         mantissa = accept_digit(mantissa, 0, &exp_extra, PARSE_DEC_IN_FRAC);
                         --trailing_zeros_frac;
                     }
+                    truncated |= mantissa >= MANTISSA_MAX;
                     mantissa = accept_digit(mantissa, dig, &exp_extra, in);
                 }
             }
@@ -348,6 +571,9 @@ const char *mp_parse_float_internal(const char *str, size_t len, mp_float_t *res
             in = PARSE_DEC_IN_FRAC;
         } else if (in != PARSE_DEC_IN_EXP && ((dig | 0x20) == 'e')) {
             in = PARSE_DEC_IN_EXP;
+            #if MICROPY_FLOAT_PARSE_EISEL_LEMIRE && MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_MPZ && MICROPY_ENABLE_GC
+            mant_top = str - 1;
+            #endif
             if (str < top) {
                 if (str[0] == '+') {
                     str++;
@@ -372,8 +598,42 @@ const char *mp_parse_float_internal(const char *str, size_t len, mp_float_t *res
     if (exp_neg) {
         exp_val = -exp_val;
     }
+    #if MICROPY_FLOAT_PARSE_EISEL_LEMIRE && MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_MPZ && MICROPY_ENABLE_GC
+    int exp_raw = exp_val;
+    #endif
     exp_val += exp_extra + trailing_zeros_intg;
 
+    #if MICROPY_FLOAT_PARSE_EISEL_LEMIRE
+    if (!truncated && mantissa <= (mp_large_float_uint_t)1 << (MP_FLOAT_FRAC_BITS + 1)
+        && exp_val >= -MAX_EXACT_POWER_OF_5 && exp_val <= MAX_EXACT_POWER_OF_5) {
+        if (exp_val < 0) {
+            *res = (mp_float_t)mantissa / exact_powers_of_10[-exp_val];
+        } else {
+            *res = (mp_float_t)mantissa * exact_powers_of_10[exp_val];
+        }
+        return str;
+    }
+    bool have_guess = eisel_lemire(mantissa, exp_val, res);
+    if (have_guess) {
+        // If digits were dropped then the value is between mantissa and mantissa + 1,
+        // and the result is only known if both ends round to the same float.
+        mp_float_t upper;
+        if (!truncated || (eisel_lemire((uint64_t)mantissa + 1, exp_val, &upper) && upper == *res)) {
+            return str;
+        }
+    }
+    #if MICROPY_LONGINT_IMPL == MICROPY_LONGINT_IMPL_MPZ && MICROPY_ENABLE_GC
+    // The exact fallback needs the heap, so use the approximation below when it's locked
+    if (!gc_is_locked()) {
+        if (!have_guess) {
+            *res = (mp_float_t)mp_decimal_exp(mantissa, exp_val);
+        }
+        *res = parse_float_exact(str_start, mant_top ? mant_top : str, exp_raw, *res);
+        return str;
+    }
+    #endif
+    #endif
+
     // At this point, we just need to multiply the mantissa by its base 10 exponent.
     *res = (mp_float_t)mp_decimal_exp(mantissa, exp_val);
 
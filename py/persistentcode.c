@@ -186,7 +186,7 @@ static qstr load_qstr(mp_reader_t *reader) {
     }
     len >>= 1;
 
-    #if MICROPY_VFS_ROM
+    #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
     // If possible, create the qstr from the memory-mapped string data.
     const uint8_t *memmap = mp_reader_try_read_rom(reader, len + 1);
     if (memmap != NULL) {
@@ -202,7 +202,7 @@ static qstr load_qstr(mp_reader_t *reader) {
     return qst;
 }
 
-#if MICROPY_VFS_ROM
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
 // Create a str/bytes object that can forever reference the given data.
 static mp_obj_t mp_obj_new_str_static(const mp_obj_type_t *type, const byte *data, size_t len) {
     if (type == &mp_type_str) {
@@ -214,7 +214,7 @@ static mp_obj_t mp_obj_new_str_static(const mp_obj_type_t *type, const byte *dat
     assert(data[len] == '\0');
     mp_obj_str_t *o = mp_obj_malloc(mp_obj_str_t, type);
     o->len = len;
-    o->hash = qstr_compute_hash(data, len);
+    o->hash = MP_OBJ_STR_HASH_LAZY;
     o->data = data;
     return MP_OBJ_FROM_PTR(o);
 }
@@ -253,7 +253,7 @@ static mp_obj_t load_obj(mp_reader_t *reader) {
         // Read in the object's data, either from ROM or into RAM.
         const uint8_t *memmap = NULL;
         vstr_t vstr;
-        #if MICROPY_VFS_ROM
+        #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
         memmap = mp_reader_try_read_rom(reader, len);
         vstr.buf = (void *)memmap;
         vstr.len = len;
@@ -267,7 +267,7 @@ static mp_obj_t load_obj(mp_reader_t *reader) {
         // Create and return the object.
         if (obj_type == MP_PERSISTENT_OBJ_STR || obj_type == MP_PERSISTENT_OBJ_BYTES) {
             read_byte(reader); // skip null terminator (it needs to be there for ROM str objects)
-            #if MICROPY_VFS_ROM
+            #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
             if (memmap != NULL) {
                 // Create a str/bytes that references the memory-mapped data.
                 const mp_obj_type_t *t = obj_type == MP_PERSISTENT_OBJ_STR ? &mp_type_str : &mp_type_bytes;
@@ -310,7 +310,7 @@ static mp_raw_code_t *load_raw_code(mp_reader_t *reader, mp_module_context_t *co
     #endif
 
     if (kind == MP_CODE_BYTECODE) {
-        #if MICROPY_VFS_ROM
+        #if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
         // Try to reference memory-mapped data for the bytecode.
         fun_data = (uint8_t *)mp_reader_try_read_rom(reader, fun_data_len);
         #endif
@@ -540,9 +540,48 @@ void mp_raw_code_load_mem(const byte *buf, size_t len, mp_compiled_module_t *con
 
 #if MICROPY_HAS_FILE_READER
 
+#if MICROPY_PERSISTENT_CODE_LOAD_MMAP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Memory-map the given file read-only, returning NULL if that's not possible.
+// The mapping is never removed, so the loaded code can reference it like ROM.
+static const byte *mmap_file(qstr filename, size_t *len) {
+    void *data = MAP_FAILED;
+    struct stat st;
+    MP_THREAD_GIL_EXIT();
+    int fd = open(qstr_str(filename), O_RDONLY);
+    if (fd >= 0) {
+        if ((fstat(fd, &st) == 0) && (st.st_size > 0)) {
+            data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+    }
+    MP_THREAD_GIL_ENTER();
+    if (data == MAP_FAILED) {
+        return NULL;
+    }
+    *len = st.st_size;
+    return data;
+}
+
+#endif
+
 void mp_raw_code_load_file(qstr filename, mp_compiled_module_t *context) {
     mp_reader_t reader;
-    mp_reader_new_file(&reader, filename);
+    #if MICROPY_PERSISTENT_CODE_LOAD_MMAP
+    size_t len;
+    const byte *data = mmap_file(filename, &len);
+    if (data != NULL) {
+        mp_reader_new_mem(&reader, data, len, MP_READER_IS_ROM);
+    } else
+    #endif
+    {
+        mp_reader_new_file(&reader, filename);
+    }
     mp_raw_code_load(&reader, context);
 }
 
@@ -733,12 +772,33 @@ void mp_raw_code_save(mp_compiled_module_t *cm, mp_print_t *print) {
 #include <sys/stat.h>
 #include <fcntl.h>
 
-static void fd_print_strn(void *env, const char *str, size_t len) {
-    int fd = (intptr_t)env;
+typedef struct _fd_print_env_t {
+    int fd;
+    int error; // errno of the first failed write, after which nothing more is written
+} fd_print_env_t;
+
+static void fd_print_strn(void *env_in, const char *str, size_t len) {
+    fd_print_env_t *env = env_in;
     MP_THREAD_GIL_EXIT();
-    ssize_t ret = write(fd, str, len);
+    while (len > 0 && env->error == 0) {
+        ssize_t ret = write(env->fd, str, len);
+        if (ret > 0) {
+            str += ret;
+            len -= ret;
+        } else if (ret == 0) {
+            env->error = ENOSPC;
+        } else if (errno != EINTR) {
+            env->error = errno;
+        }
+    }
     MP_THREAD_GIL_ENTER();
-    (void)ret;
+}
+
+int mp_raw_code_save_fd(mp_compiled_module_t *cm, int fd) {
+    fd_print_env_t env = {fd, 0};
+    mp_print_t fd_print = {&env, fd_print_strn};
+    mp_raw_code_save(cm, &fd_print);
+    return env.error;
 }
 
 void mp_raw_code_save_file(mp_compiled_module_t *cm, qstr filename) {
@@ -748,11 +808,15 @@ void mp_raw_code_save_file(mp_compiled_module_t *cm, qstr filename) {
     if (fd < 0) {
         mp_raise_OSError_with_filename(errno, MP_OBJ_NEW_QSTR(filename));
     }
-    mp_print_t fd_print = {(void *)(intptr_t)fd, fd_print_strn};
-    mp_raw_code_save(cm, &fd_print);
+    int error = mp_raw_code_save_fd(cm, fd);
     MP_THREAD_GIL_EXIT();
-    close(fd);
+    if (close(fd) != 0 && error == 0) {
+        error = errno;
+    }
     MP_THREAD_GIL_ENTER();
+    if (error != 0) {
+        mp_raise_OSError_with_filename(error, MP_OBJ_NEW_QSTR(filename));
+    }
 }
 
 #endif // MICROPY_PERSISTENT_CODE_SAVE_FILE
@@ -125,6 +125,8 @@ void mp_raw_code_load_mem(const byte *buf, size_t len, mp_compiled_module_t *ctx
 void mp_raw_code_load_file(qstr filename, mp_compiled_module_t *ctx);
 
 void mp_raw_code_save(mp_compiled_module_t *cm, mp_print_t *print);
+// Returns 0 on success, or the errno of a failed write.
+int mp_raw_code_save_fd(mp_compiled_module_t *cm, int fd);
 void mp_raw_code_save_file(mp_compiled_module_t *cm, qstr filename);
 mp_obj_t mp_raw_code_save_fun_to_bytes(const mp_module_constants_t *consts, const uint8_t *bytecode);
 
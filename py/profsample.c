@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/mperrno.h"
+#include "py/mphal.h"
+#include "py/objfun.h"
+#include "py/profsample.h"
+#include "py/runtime.h"
+
+#if MICROPY_PY_MICROPYTHON_PROFILE
+
+#if defined(MICROPY_PY_MICROPYTHON_PROFILE_TIMER_START)
+// Port provides the timer.
+#elif MICROPY_FREERTOS
+#include "FreeRTOS.h"
+#include "timers.h"
+
+static TimerHandle_t mp_profile_timer;
+
+static void mp_profile_timer_callback(TimerHandle_t xTimer) {
+    mp_profile_tick();
+}
+
+static void mp_profile_timer_start(mp_uint_t period_ms) {
+    TickType_t period = MAX(pdMS_TO_TICKS(period_ms), 1);
+    if (!mp_profile_timer) {
+        mp_profile_timer = xTimerCreate("profile", period, pdTRUE, NULL, mp_profile_timer_callback);
+        if (!mp_profile_timer) {
+            mp_raise_OSError(MP_ENOMEM);
+        }
+    } else {
+        xTimerChangePeriod(mp_profile_timer, period, portMAX_DELAY);
+    }
+    xTimerStart(mp_profile_timer, portMAX_DELAY);
+}
+
+static void mp_profile_timer_stop(void) {
+    if (mp_profile_timer) {
+        xTimerStop(mp_profile_timer, portMAX_DELAY);
+    }
+}
+
+#define MICROPY_PY_MICROPYTHON_PROFILE_TIMER_START(period_ms) mp_profile_timer_start(period_ms)
+#define MICROPY_PY_MICROPYTHON_PROFILE_TIMER_STOP() mp_profile_timer_stop()
+#else
+#error "MICROPY_PY_MICROPYTHON_PROFILE requires a timer"
+#endif
+
+typedef struct _mp_profile_frame_t {
+    // Holding the function keeps it alive until the samples are dumped.
+    const struct _mp_obj_fun_bc_t *fun_bc;
+    size_t offset;
+} mp_profile_frame_t;
+
+typedef struct _mp_profile_sample_t {
+    // Frames of the sample, starting from the innermost
+    mp_profile_frame_t frames[MICROPY_PY_MICROPYTHON_PROFILE_DEPTH];
+    size_t depth;
+} mp_profile_sample_t;
+
+typedef struct _mp_profile_t {
+    size_t n_samples;
+    // Index of the next sample to write in the ring buffer
+    size_t head;
+    // Total number of samples taken, including those that have been overwritten
+    size_t count;
+    mp_profile_sample_t samples[];
+} mp_profile_t;
+
+void mp_profile_start(mp_uint_t period_ms, size_t n_samples) {
+    mp_profile_stop();
+    if ((n_samples == 0) || (n_samples > (SIZE_MAX - sizeof(mp_profile_t)) / sizeof(mp_profile_sample_t))) {
+        mp_raise_ValueError(NULL);
+    }
+    mp_profile_t *profile = m_malloc0(sizeof(mp_profile_t) + n_samples * sizeof(mp_profile_sample_t));
+    profile->n_samples = n_samples;
+    MP_STATE_VM(profile) = profile;
+    MP_STATE_VM(profile_sample_pending) = false;
+    MICROPY_PY_MICROPYTHON_PROFILE_TIMER_START(period_ms);
+}
+
+void mp_profile_stop(void) {
+    MICROPY_PY_MICROPYTHON_PROFILE_TIMER_STOP();
+    MP_STATE_VM(profile_sample_pending) = false;
+}
+
+void mp_profile_sample(const mp_code_state_t *code_state) {
+    MP_STATE_VM(profile_sample_pending) = false;
+    mp_profile_t *profile = MP_STATE_VM(profile);
+    if (!profile) {
+        return;
+    }
+    mp_profile_sample_t *sample = &profile->samples[profile->head];
+    size_t depth = 0;
+    while (code_state && (depth < MICROPY_PY_MICROPYTHON_PROFILE_DEPTH)) {
+        sample->frames[depth].fun_bc = code_state->fun_bc;
+        sample->frames[depth].offset = code_state->ip - code_state->fun_bc->bytecode;
+        code_state = code_state->prev_state;
+        depth++;
+    }
+    sample->depth = depth;
+    profile->head = (profile->head + 1) % profile->n_samples;
+    profile->count++;
+}
+
+static void mp_profile_print_frame(const mp_print_t *print, const mp_profile_frame_t *frame) {
+    qstr block_name;
+    qstr source_file;
+    size_t source_line = mp_bytecode_get_location(frame->fun_bc, frame->fun_bc->bytecode + frame->offset, &block_name, &source_file);
+    mp_printf(print, "%q (%q:%u)", block_name, source_file, (uint)source_line);
+}
+
+static bool mp_profile_sample_equal(const mp_profile_sample_t *a, const mp_profile_sample_t *b) {
+    return (a->depth == b->depth) && (memcmp(a->frames, b->frames, a->depth * sizeof(mp_profile_frame_t)) == 0);
+}
+
+void mp_profile_dump(const mp_print_t *print) {
+    mp_profile_t *profile = MP_STATE_VM(profile);
+    if (!profile) {
+        return;
+    }
+    size_t n_samples = MIN(profile->count, profile->n_samples);
+    for (size_t i = 0; i < n_samples; i++) {
+        const mp_profile_sample_t *sample = &profile->samples[i];
+        if (sample->depth == 0) {
+            continue;
+        }
+        // Print each distinct stack once, at its first occurrence.
+        bool seen = false;
+        for (size_t j = 0; (j < i) && !seen; j++) {
+            seen = mp_profile_sample_equal(sample, &profile->samples[j]);
+        }
+        if (seen) {
+            continue;
+        }
+        size_t count = 1;
+        for (size_t j = i + 1; j < n_samples; j++) {
+            count += mp_profile_sample_equal(sample, &profile->samples[j]);
+        }
+        // Collapsed stacks go from the outermost frame to the innermost.
+        for (size_t k = sample->depth; k-- > 0;) {
+            mp_profile_print_frame(print, &sample->frames[k]);
+            mp_print_str(print, k ? ";" : " ");
+        }
+        mp_printf(print, "%u\n", (uint)count);
+    }
+}
+
+MP_REGISTER_ROOT_POINTER(struct _mp_profile_t *profile);
+
+#endif // MICROPY_PY_MICROPYTHON_PROFILE
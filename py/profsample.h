@@ -0,0 +1,28 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/bc.h"
+#include "py/mpprint.h"
+#include "py/mpstate.h"
+
+#if MICROPY_PY_MICROPYTHON_PROFILE
+
+// Starts sampling the running code every period_ms milliseconds, keeping the most recent n_samples samples.
+void mp_profile_start(mp_uint_t period_ms, size_t n_samples);
+
+void mp_profile_stop(void);
+
+// Called from the profiler timer (possibly in interrupt context) to request a sample.
+static inline void mp_profile_tick(void) {
+    MP_STATE_VM(profile_sample_pending) = true;
+}
+
+// Called by the VM to record the stack of the given code state.
+void mp_profile_sample(const mp_code_state_t *code_state);
+
+// Prints the recorded samples in collapsed stack format, one stack per line followed by its count.
+void mp_profile_dump(const mp_print_t *print);
+
+#endif
@@ -6,6 +6,8 @@ list(APPEND MICROPY_INC_CORE "${MICROPY_DIR}")
 
 # All py/ source files
 set(MICROPY_SOURCE_PY
+    ${MICROPY_PY_DIR}/allocprof.c
+    ${MICROPY_PY_DIR}/arena.c
     ${MICROPY_PY_DIR}/argcheck.c
     ${MICROPY_PY_DIR}/asmarm.c
     ${MICROPY_PY_DIR}/asmbase.c
@@ -102,11 +104,13 @@ set(MICROPY_SOURCE_PY
     ${MICROPY_PY_DIR}/objproperty.c
     ${MICROPY_PY_DIR}/objrange.c
     ${MICROPY_PY_DIR}/objreversed.c
+    ${MICROPY_PY_DIR}/objringbuffer.c
     ${MICROPY_PY_DIR}/objringio.c
     ${MICROPY_PY_DIR}/objset.c
     ${MICROPY_PY_DIR}/objsingleton.c
     ${MICROPY_PY_DIR}/objslice.c
     ${MICROPY_PY_DIR}/objstr.c
+    ${MICROPY_PY_DIR}/objstrbuilder.c
     ${MICROPY_PY_DIR}/objstringio.c
     ${MICROPY_PY_DIR}/objstrunicode.c
     ${MICROPY_PY_DIR}/objtuple.c
@@ -120,6 +124,7 @@ set(MICROPY_SOURCE_PY
     ${MICROPY_PY_DIR}/parsenumbase.c
     ${MICROPY_PY_DIR}/persistentcode.c
     ${MICROPY_PY_DIR}/profile.c
+    ${MICROPY_PY_DIR}/profsample.c
     ${MICROPY_PY_DIR}/pystack.c
     ${MICROPY_PY_DIR}/qstr.c
     ${MICROPY_PY_DIR}/reader.c
@@ -136,6 +141,7 @@ set(MICROPY_SOURCE_PY
     ${MICROPY_PY_DIR}/stream.c
     ${MICROPY_PY_DIR}/unicode.c
     ${MICROPY_PY_DIR}/vm.c
+    ${MICROPY_PY_DIR}/vmstats.c
     ${MICROPY_PY_DIR}/vstr.c
     ${MICROPY_PY_DIR}/warning.c
 )
@@ -141,6 +141,10 @@ PY_CORE_O_BASENAME = $(addprefix py/,\
 	argcheck.o \
 	warning.o \
 	profile.o \
+	profsample.o \
+	vmstats.o \
+	allocprof.o \
+	arena.o \
 	map.o \
 	obj.o \
 	objarray.o \
@@ -173,11 +177,13 @@ PY_CORE_O_BASENAME = $(addprefix py/,\
 	objnamedtuple.o \
 	objrange.o \
 	objreversed.o \
+	objringbuffer.o \
 	objringio.o \
 	objset.o \
 	objsingleton.o \
 	objslice.o \
 	objstr.o \
+	objstrbuilder.o \
 	objstrunicode.o \
 	objstringio.o \
 	objtuple.o \
@@ -62,12 +62,37 @@
 
 // this must match the equivalent function in makeqstrdata.py
 size_t qstr_compute_hash(const byte *data, size_t len) {
+    #if MICROPY_QSTR_HASH_WORDWISE
+    // Mix in 8 bytes at a time, loaded little endian, with a multiply and rotate.
+    // The final multiply and fold bring the high bits down into the masked bits.
+    const uint64_t k = 0x9e3779b97f4a7c15;
+    uint64_t h = len;
+    for (const byte *top = data + len; data < top; data += 8) {
+        uint64_t w = 0;
+        size_t n = MIN(8, (size_t)(top - data));
+        #if MP_ENDIANNESS_LITTLE
+        if (n == 8) {
+            memcpy(&w, data, 8);
+            n = 0;
+        }
+        #endif
+        while (n > 0) {
+            w = w << 8 | data[--n];
+        }
+        h = (h ^ w) * k;
+        h = h << 31 | h >> 33;
+    }
+    h *= k;
+    h ^= h >> 32;
+    size_t hash = h & Q_HASH_MASK;
+    #else
     // djb2 algorithm; see http://www.cse.yorku.ca/~oz/hash.html
     size_t hash = 5381;
     for (const byte *top = data + len; data < top; data++) {
         hash = ((hash << 5) + hash) ^ (*data); // hash * 33 ^ data
     }
     hash &= Q_HASH_MASK;
+    #endif
     // Make sure that valid hash is never zero, zero means "hash not computed"
     if (hash == 0) {
         hash++;
@@ -268,6 +293,11 @@ qstr qstr_find_strn(const char *str, size_t str_len) {
         return MP_QSTR_;
     }
 
+    if (str_len >= (1 << (8 * MICROPY_QSTR_BYTES_IN_LEN))) {
+        // Too long to be a qstr, so don't spend time hashing it.
+        return MP_QSTRnull;
+    }
+
     #if MICROPY_QSTR_BYTES_IN_HASH
     // work out hash of str
     size_t str_hash = qstr_compute_hash((const byte *)str, str_len);
@@ -386,7 +416,7 @@ qstr qstr_from_strn(const char *str, size_t len) {
     return qstr_from_strn_helper(str, len, false);
 }
 
-#if MICROPY_VFS_ROM
+#if MICROPY_PERSISTENT_CODE_LOAD_IN_PLACE
 // Create a new qstr that can forever reference the given string data.
 qstr qstr_from_strn_static(const char *str, size_t len) {
     return qstr_from_strn_helper(str, len, true);
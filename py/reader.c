@@ -80,6 +80,17 @@ const uint8_t *mp_reader_try_read_rom(mp_reader_t *reader, size_t len) {
     return data;
 }
 
+const uint8_t *mp_reader_try_read_mem(mp_reader_t *reader, size_t *len) {
+    if (reader->readbyte != mp_reader_mem_readbyte) {
+        return NULL;
+    }
+    mp_reader_mem_t *m = reader->data;
+    const uint8_t *data = m->cur;
+    *len = m->end - m->cur;
+    m->cur = m->end;
+    return data;
+}
+
 #if MICROPY_READER_POSIX
 
 #include <sys/stat.h>
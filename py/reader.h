@@ -52,4 +52,9 @@ void mp_reader_new_file_from_fd(mp_reader_t *reader, int fd, bool close_fd);
 // Returns NULL if the reader does not point to ROM.
 const uint8_t *mp_reader_try_read_rom(mp_reader_t *reader, size_t len);
 
+// Try to efficiently read all remaining bytes from a memory-based reader (in RAM or ROM).
+// Returns a pointer to the data, which remains valid until the reader is closed, and sets *len.
+// Returns NULL if the reader does not point to memory.
+const uint8_t *mp_reader_try_read_mem(mp_reader_t *reader, size_t *len);
+
 #endif // MICROPY_INCLUDED_PY_READER_H
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+
+// Lock-free single-producer single-consumer ring buffer of bytes.
+//
+// The producer and consumer may be on different threads, cores or in an ISR
+// without any locking, as long as there is at most one of each. The indices are
+// free-running 32-bit counters, so the number of bytes in the ring is always
+// write_index - read_index, and the size must be a power of 2 no more than 2^31.
+// Each index is only stored by its owner, using plain atomic loads and stores
+// which are lock-free even on cores without atomic read-modify-write
+// instructions, such as the Cortex-M0+.
+typedef struct {
+    uint8_t *buf;
+    uint32_t size;
+    atomic_uint_least32_t read_index;
+    atomic_uint_least32_t write_index;
+} ringspsc_t;
+
+static inline void ringspsc_init(ringspsc_t *r, void *buf, uint32_t size) {
+    r->buf = buf;
+    r->size = size;
+    atomic_init(&r->read_index, 0);
+    atomic_init(&r->write_index, 0);
+}
+
+// Returns the number of bytes that can be read. May be called from any thread.
+static inline uint32_t ringspsc_read_count(ringspsc_t *r) {
+    uint32_t read_index = atomic_load_explicit(&r->read_index, memory_order_acquire);
+    return atomic_load_explicit(&r->write_index, memory_order_acquire) - read_index;
+}
+
+// Returns the number of bytes that can be written. May be called from any thread.
+static inline uint32_t ringspsc_write_count(ringspsc_t *r) {
+    uint32_t write_index = atomic_load_explicit(&r->write_index, memory_order_acquire);
+    return r->size - (write_index - atomic_load_explicit(&r->read_index, memory_order_acquire));
+}
+
+static inline uint32_t ringspsc_views(const ringspsc_t *r, uint32_t index, uint32_t count, uint8_t *ptr[2], uint32_t len[2]) {
+    uint32_t offset = index & (r->size - 1);
+    uint32_t first = r->size - offset;
+    first = (count < first) ? count : first;
+    ptr[0] = r->buf + offset;
+    len[0] = first;
+    ptr[1] = r->buf;
+    len[1] = count - first;
+    return count;
+}
+
+// Gets the readable bytes as up to two contiguous segments and returns their total length.
+// Consumer only.
+static inline uint32_t ringspsc_read_views(ringspsc_t *r, uint8_t *ptr[2], uint32_t len[2]) {
+    uint32_t read_index = atomic_load_explicit(&r->read_index, memory_order_relaxed);
+    uint32_t count = atomic_load_explicit(&r->write_index, memory_order_acquire) - read_index;
+    return ringspsc_views(r, read_index, count, ptr, len);
+}
+
+// Gets the writable space as up to two contiguous segments and returns their total length.
+// Producer only.
+static inline uint32_t ringspsc_write_views(ringspsc_t *r, uint8_t *ptr[2], uint32_t len[2]) {
+    uint32_t write_index = atomic_load_explicit(&r->write_index, memory_order_relaxed);
+    uint32_t count = r->size - (write_index - atomic_load_explicit(&r->read_index, memory_order_acquire));
+    return ringspsc_views(r, write_index, count, ptr, len);
+}
+
+// Releases n bytes obtained from ringspsc_read_views back to the producer. Consumer only.
+static inline void ringspsc_read_commit(ringspsc_t *r, uint32_t n) {
+    uint32_t read_index = atomic_load_explicit(&r->read_index, memory_order_relaxed);
+    atomic_store_explicit(&r->read_index, read_index + n, memory_order_release);
+}
+
+// Publishes n bytes written into ringspsc_write_views to the consumer. Producer only.
+static inline void ringspsc_write_commit(ringspsc_t *r, uint32_t n) {
+    uint32_t write_index = atomic_load_explicit(&r->write_index, memory_order_relaxed);
+    atomic_store_explicit(&r->write_index, write_index + n, memory_order_release);
+}
+
+// Copies up to len bytes out of the ring and returns the number of bytes copied. Consumer only.
+static inline size_t ringspsc_read(ringspsc_t *r, void *data, size_t len) {
+    uint8_t *ptr[2];
+    uint32_t seg[2];
+    uint32_t count = ringspsc_read_views(r, ptr, seg);
+    if (len < count) {
+        count = len;
+    }
+    uint32_t first = (count < seg[0]) ? count : seg[0];
+    memcpy(data, ptr[0], first);
+    memcpy((uint8_t *)data + first, ptr[1], count - first);
+    ringspsc_read_commit(r, count);
+    return count;
+}
+
+// Copies up to len bytes into the ring and returns the number of bytes copied. Producer only.
+static inline size_t ringspsc_write(ringspsc_t *r, const void *data, size_t len) {
+    uint8_t *ptr[2];
+    uint32_t seg[2];
+    uint32_t count = ringspsc_write_views(r, ptr, seg);
+    if (len < count) {
+        count = len;
+    }
+    uint32_t first = (count < seg[0]) ? count : seg[0];
+    memcpy(ptr[0], data, first);
+    memcpy(ptr[1], (const uint8_t *)data + first, count - first);
+    ringspsc_write_commit(r, count);
+    return count;
+}
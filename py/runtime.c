@@ -45,6 +45,7 @@
 #include "py/builtin.h"
 #include "py/cstack.h"
 #include "py/gc.h"
+#include "py/vmstats.h"
 
 #if MICROPY_VFS_ROM && MICROPY_VFS_ROM_IOCTL
 #include "extmod/vfs.h"
@@ -118,6 +119,14 @@ void mp_init(void) {
     mp_locals_set(&MP_STATE_VM(dict_main));
     mp_globals_set(&MP_STATE_VM(dict_main));
 
+    #if MICROPY_PY_MICROPYTHON_VM_STATS
+    mp_vm_stats_reset();
+    #endif
+
+    #if MICROPY_PY_MICROPYTHON_ALLOC_PROFILE
+    MP_STATE_VM(alloc_profile) = NULL;
+    #endif
+
     #if MICROPY_CAN_OVERRIDE_BUILTINS
     // start with no extensions to builtins
     MP_STATE_VM(mp_module_builtins_override_dict) = NULL;
@@ -164,6 +173,8 @@ void mp_init(void) {
     #if MICROPY_PY_SYS_SETTRACE
     MP_STATE_THREAD(prof_trace_callback) = MP_OBJ_NULL;
     MP_STATE_THREAD(prof_callback_is_executing) = false;
+    #endif
+    #if MICROPY_TRACK_CODE_STATE
     MP_STATE_THREAD(current_code_state) = NULL;
     #endif
 
@@ -329,12 +340,7 @@ mp_obj_t mp_unary_op(mp_unary_op_t op, mp_obj_t arg) {
         }
     } else if (op == MP_UNARY_OP_HASH && mp_obj_is_str_or_bytes(arg)) {
         // fast path for hashing str/bytes
-        GET_STR_HASH(arg, h);
-        if (h == 0) {
-            GET_STR_DATA_LEN(arg, data, len);
-            h = qstr_compute_hash(data, len);
-        }
-        return MP_OBJ_NEW_SMALL_INT(h);
+        return MP_OBJ_NEW_SMALL_INT(mp_obj_str_get_hash(arg));
     } else {
         const mp_obj_type_t *type = mp_obj_get_type(arg);
         if (MP_OBJ_TYPE_HAS_SLOT(type, unary_op)) {
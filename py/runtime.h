@@ -180,6 +180,8 @@ static inline void mp_thread_init_state(mp_state_thread_t *ts, size_t stack_size
     #if MICROPY_PY_SYS_SETTRACE
     ts->prof_trace_callback = MP_OBJ_NULL;
     ts->prof_callback_is_executing = false;
+    #endif
+    #if MICROPY_TRACK_CODE_STATE
     ts->current_code_state = NULL;
     #endif
 
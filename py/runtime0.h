@@ -38,7 +38,7 @@
 #define MP_SCOPE_FLAG_DEFKWARGS    (0x08)
 #define MP_SCOPE_FLAG_REFGLOBALS   (0x10) // used only if native emitter enabled
 #define MP_SCOPE_FLAG_HASCONSTS    (0x20) // used only if native emitter enabled
-#define MP_SCOPE_FLAG_VIPERRET_POS    (6) // 3 bits used for viper return type, to pass from compiler to native emitter
+#define MP_SCOPE_FLAG_VIPERRET_POS    (6) // 4 bits used for viper return type, to pass from compiler to native emitter
 #define MP_SCOPE_FLAG_VIPERRELOC   (0x10) // used only when loading viper from .mpy
 #define MP_SCOPE_FLAG_VIPERRODATA  (0x20) // used only when loading viper from .mpy
 #define MP_SCOPE_FLAG_VIPERBSS     (0x40) // used only when loading viper from .mpy
@@ -56,6 +56,9 @@
 // Not use for viper, but for dynamic native modules
 #define MP_NATIVE_TYPE_QSTR (0x08)
 
+// Only used for viper when MICROPY_EMIT_NATIVE_FLOAT is enabled
+#define MP_NATIVE_TYPE_FLOAT (0x09)
+
 // Bytecode and runtime boundaries for unary ops
 #define MP_UNARY_OP_NUM_BYTECODE    (MP_UNARY_OP_NOT + 1)
 #define MP_UNARY_OP_NUM_RUNTIME     (MP_UNARY_OP_SIZEOF + 1)
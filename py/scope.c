@@ -42,7 +42,7 @@ static const uint8_t scope_simple_name_table[] = {
     [SCOPE_GEN_EXPR] = MP_QSTR__lt_genexpr_gt_,
 };
 
-scope_t *scope_new(scope_kind_t kind, mp_parse_node_t pn, mp_uint_t emit_options) {
+scope_t *scope_new(mp_arena_t *arena, scope_kind_t kind, mp_parse_node_t pn, mp_uint_t emit_options) {
     // Make sure those qstrs indeed fit in an uint8_t.
     MP_STATIC_ASSERT(MP_QSTR__lt_module_gt_ <= UINT8_MAX);
     MP_STATIC_ASSERT(MP_QSTR__lt_lambda_gt_ <= UINT8_MAX);
@@ -51,7 +51,8 @@ scope_t *scope_new(scope_kind_t kind, mp_parse_node_t pn, mp_uint_t emit_options
     MP_STATIC_ASSERT(MP_QSTR__lt_setcomp_gt_ <= UINT8_MAX);
     MP_STATIC_ASSERT(MP_QSTR__lt_genexpr_gt_ <= UINT8_MAX);
 
-    scope_t *scope = m_new0(scope_t, 1);
+    scope_t *scope = mp_arena_new0(arena, scope_t, 1);
+    scope->arena = arena;
     scope->kind = kind;
     scope->pn = pn;
     if (kind == SCOPE_FUNCTION || kind == SCOPE_CLASS) {
@@ -63,16 +64,11 @@ scope_t *scope_new(scope_kind_t kind, mp_parse_node_t pn, mp_uint_t emit_options
     scope->raw_code = mp_emit_glue_new_raw_code();
     scope->emit_options = emit_options;
     scope->id_info_alloc = MICROPY_ALLOC_SCOPE_ID_INIT;
-    scope->id_info = m_new(id_info_t, scope->id_info_alloc);
+    scope->id_info = mp_arena_new(arena, id_info_t, scope->id_info_alloc);
 
     return scope;
 }
 
-void scope_free(scope_t *scope) {
-    m_del(id_info_t, scope->id_info, scope->id_info_alloc);
-    m_del(scope_t, scope, 1);
-}
-
 id_info_t *scope_find_or_add_id(scope_t *scope, qstr qst, id_info_kind_t kind) {
     id_info_t *id_info = scope_find(scope, qst);
     if (id_info != NULL) {
@@ -81,8 +77,10 @@ id_info_t *scope_find_or_add_id(scope_t *scope, qstr qst, id_info_kind_t kind) {
 
     // make sure we have enough memory
     if (scope->id_info_len >= scope->id_info_alloc) {
-        scope->id_info = m_renew(id_info_t, scope->id_info, scope->id_info_alloc, scope->id_info_alloc + MICROPY_ALLOC_SCOPE_ID_INC);
-        scope->id_info_alloc += MICROPY_ALLOC_SCOPE_ID_INC;
+        // grow geometrically, because the old array is only reclaimed with the arena
+        size_t new_alloc = scope->id_info_alloc + MAX(MICROPY_ALLOC_SCOPE_ID_INC, scope->id_info_alloc / 2);
+        scope->id_info = mp_arena_renew(scope->arena, id_info_t, scope->id_info, scope->id_info_alloc, new_alloc);
+        scope->id_info_alloc = new_alloc;
     }
 
     // add new id to end of array of all ids; this seems to match CPython
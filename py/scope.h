@@ -71,6 +71,8 @@ typedef enum {
 } scope_kind_t;
 
 typedef struct _scope_t {
+    // arena that holds this scope and its id_info, which frees them with the parse tree
+    mp_arena_t *arena;
     scope_kind_t kind;
     struct _scope_t *parent;
     struct _scope_t *next;
@@ -93,8 +95,7 @@ typedef struct _scope_t {
     id_info_t *id_info;
 } scope_t;
 
-scope_t *scope_new(scope_kind_t kind, mp_parse_node_t pn, mp_uint_t emit_options);
-void scope_free(scope_t *scope);
+scope_t *scope_new(mp_arena_t *arena, scope_kind_t kind, mp_parse_node_t pn, mp_uint_t emit_options);
 id_info_t *scope_find_or_add_id(scope_t *scope, qstr qstr, id_info_kind_t kind);
 id_info_t *scope_find(scope_t *scope, qstr qstr);
 id_info_t *scope_find_global(scope_t *scope, qstr qstr);
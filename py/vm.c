@@ -35,6 +35,8 @@
 #include "py/runtime.h"
 #include "py/bc0.h"
 #include "py/profile.h"
+#include "py/profsample.h"
+#include "py/vmstats.h"
 
 // *FORMAT-OFF*
 
@@ -187,6 +189,23 @@
     } \
 } while(0)
 
+#elif MICROPY_TRACK_CODE_STATE
+
+#define FRAME_SETUP() do { \
+    MP_STATE_THREAD(current_code_state) = code_state; \
+} while(0)
+
+#define FRAME_ENTER() do { \
+    code_state->prev_state = MP_STATE_THREAD(current_code_state); \
+} while(0)
+
+#define FRAME_LEAVE() do { \
+    MP_STATE_THREAD(current_code_state) = code_state->prev_state; \
+} while(0)
+
+#define FRAME_UPDATE()
+#define TRACE_TICK(current_ip, current_sp, is_exception)
+
 #else // MICROPY_PY_SYS_SETTRACE
 #define FRAME_SETUP()
 #define FRAME_ENTER()
@@ -195,6 +214,26 @@
 #define TRACE_TICK(current_ip, current_sp, is_exception)
 #endif // MICROPY_PY_SYS_SETTRACE
 
+#if MICROPY_PY_MICROPYTHON_VM_STATS
+
+#if MICROPY_STACKLESS
+#error "MICROPY_PY_MICROPYTHON_VM_STATS requires !MICROPY_STACKLESS"
+#endif
+
+#define VM_STATS_ENTER() \
+    size_t vm_stats_index = mp_vm_stats_enter(code_state); \
+    mp_uint_t vm_stats_start = mp_hal_ticks_cpu()
+
+#define VM_STATS_LEAVE() mp_vm_stats_leave(vm_stats_index, vm_stats_start)
+
+#define VM_STATS_OPCODE(op) (MP_STATE_VM(vm_stats_opcodes)[op]++)
+
+#else // MICROPY_PY_MICROPYTHON_VM_STATS
+#define VM_STATS_ENTER()
+#define VM_STATS_LEAVE()
+#define VM_STATS_OPCODE(op)
+#endif // MICROPY_PY_MICROPYTHON_VM_STATS
+
 #if MICROPY_PY_BUILTINS_SLICE
 // This function is marked "no inline" so it doesn't increase the C stack usage of the main VM function.
 MP_NOINLINE static mp_obj_t *build_slice_stack_allocated(byte op, mp_obj_t *sp, mp_obj_t step) {
@@ -248,6 +287,7 @@ mp_vm_return_kind_t MICROPY_WRAP_MP_EXECUTE_BYTECODE(mp_execute_bytecode)(mp_cod
         TRACE(ip); \
         MARK_EXC_IP_GLOBAL(); \
         TRACE_TICK(ip, sp, false); \
+        VM_STATS_OPCODE(*ip); \
         goto *entry_table[*ip++]; \
     } while (0)
     #define DISPATCH_WITH_PEND_EXC_CHECK() goto pending_exception_check
@@ -270,6 +310,7 @@ mp_vm_return_kind_t MICROPY_WRAP_MP_EXECUTE_BYTECODE(mp_execute_bytecode)(mp_cod
 run_code_state: ;
 #endif
 FRAME_ENTER();
+VM_STATS_ENTER();
 
 #if MICROPY_STACKLESS
 run_code_state_from_return: ;
@@ -329,6 +370,7 @@ dispatch_loop:
                 TRACE(ip);
                 MARK_EXC_IP_GLOBAL();
                 TRACE_TICK(ip, sp, false);
+                VM_STATS_OPCODE(*ip);
                 switch (*ip++) {
                 #endif
 
@@ -1172,6 +1214,7 @@ unwind_return:
                     }
                     #endif
                     FRAME_LEAVE();
+                    VM_STATS_LEAVE();
                     return MP_VM_RETURN_NORMAL;
 
                 ENTRY(MP_BC_RAISE_LAST): {
@@ -1213,6 +1256,7 @@ yield:
                     code_state->sp = sp;
                     code_state->exc_sp_idx = MP_CODE_STATE_EXC_SP_IDX_FROM_PTR(exc_stack, exc_sp);
                     FRAME_LEAVE();
+                    VM_STATS_LEAVE();
                     return MP_VM_RETURN_YIELD;
 
                 ENTRY(MP_BC_YIELD_FROM): {
@@ -1331,6 +1375,7 @@ yield:
                     nlr_pop();
                     code_state->state[0] = obj;
                     FRAME_LEAVE();
+                    VM_STATS_LEAVE();
                     return MP_VM_RETURN_EXCEPTION;
                 }
 
@@ -1371,6 +1416,13 @@ pending_exception_check:
                     mp_handle_pending(true);
                 }
 
+                #if MICROPY_PY_MICROPYTHON_PROFILE
+                if (MP_STATE_VM(profile_sample_pending)) {
+                    MARK_EXC_IP_SELECTIVE();
+                    mp_profile_sample(code_state);
+                }
+                #endif
+
                 #if MICROPY_PY_THREAD_GIL
                 #if MICROPY_PY_THREAD_GIL_VM_DIVISOR
                 // Don't bounce the GIL too frequently (default every 32 branches).
@@ -1509,6 +1561,7 @@ unwind_loop:
                 // Note: ip and sp don't have usable values at this point
                 code_state->state[0] = MP_OBJ_FROM_PTR(nlr.ret_val); // put exception here because sp is invalid
                 FRAME_LEAVE();
+                VM_STATS_LEAVE();
                 return MP_VM_RETURN_EXCEPTION;
             }
         }
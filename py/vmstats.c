@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/objfun.h"
+#include "py/runtime.h"
+#include "py/vmstats.h"
+
+#if MICROPY_PY_MICROPYTHON_VM_STATS
+
+#define MP_VM_STATS_OTHER (MICROPY_PY_MICROPYTHON_VM_STATS_FUNCS)
+
+void mp_vm_stats_reset(void) {
+    memset(MP_STATE_VM(vm_stats_opcodes), 0, sizeof(MP_STATE_VM(vm_stats_opcodes)));
+    memset(MP_STATE_VM(vm_stats_fun), 0, sizeof(MP_STATE_VM(vm_stats_fun)));
+    memset(MP_STATE_VM(vm_stats_calls), 0, sizeof(MP_STATE_VM(vm_stats_calls)));
+    memset(MP_STATE_VM(vm_stats_ticks), 0, sizeof(MP_STATE_VM(vm_stats_ticks)));
+}
+
+size_t mp_vm_stats_enter(const mp_code_state_t *code_state) {
+    // Functions are identified by their bytecode, which is shared by all closures of a definition.
+    const mp_obj_fun_bc_t *fun_bc = code_state->fun_bc;
+    size_t start = ((uintptr_t)fun_bc->bytecode >> 2) % MICROPY_PY_MICROPYTHON_VM_STATS_FUNCS;
+    size_t index = start;
+    for (;;) {
+        const mp_obj_fun_bc_t *entry = MP_STATE_VM(vm_stats_fun)[index];
+        if (!entry) {
+            // Holding the function keeps its bytecode alive until the stats are reset.
+            MP_STATE_VM(vm_stats_fun)[index] = fun_bc;
+            break;
+        }
+        if (entry->bytecode == fun_bc->bytecode) {
+            break;
+        }
+        index = (index + 1) % MICROPY_PY_MICROPYTHON_VM_STATS_FUNCS;
+        if (index == start) {
+            // Table is full.
+            index = MP_VM_STATS_OTHER;
+            break;
+        }
+    }
+    MP_STATE_VM(vm_stats_calls)[index]++;
+    return index;
+}
+
+static mp_obj_t mp_vm_stats_fun_info(const mp_obj_fun_bc_t *fun_bc, mp_uint_t calls, mp_uint_t ticks) {
+    mp_obj_t items[5] = {
+        mp_const_none,
+        mp_const_none,
+        MP_OBJ_NEW_SMALL_INT(0),
+        mp_obj_new_int_from_uint(calls),
+        mp_obj_new_int_from_uint(ticks),
+    };
+    if (fun_bc) {
+        qstr block_name;
+        qstr source_file;
+        items[2] = MP_OBJ_NEW_SMALL_INT(mp_bytecode_get_location(fun_bc, NULL, &block_name, &source_file));
+        items[0] = MP_OBJ_NEW_QSTR(block_name);
+        items[1] = MP_OBJ_NEW_QSTR(source_file);
+    }
+    return mp_obj_new_tuple(MP_ARRAY_SIZE(items), items);
+}
+
+mp_obj_t mp_vm_stats_get(void) {
+    mp_obj_t opcodes = mp_obj_new_dict(0);
+    for (size_t op = 0; op < MP_ARRAY_SIZE(MP_STATE_VM(vm_stats_opcodes)); op++) {
+        mp_uint_t count = MP_STATE_VM(vm_stats_opcodes)[op];
+        if (count) {
+            mp_obj_dict_store(opcodes, MP_OBJ_NEW_SMALL_INT(op), mp_obj_new_int_from_uint(count));
+        }
+    }
+
+    mp_obj_t funs = mp_obj_new_list(0, NULL);
+    for (size_t index = 0; index <= MP_VM_STATS_OTHER; index++) {
+        const mp_obj_fun_bc_t *fun_bc = (index < MP_VM_STATS_OTHER) ? MP_STATE_VM(vm_stats_fun)[index] : NULL;
+        mp_uint_t calls = MP_STATE_VM(vm_stats_calls)[index];
+        if (fun_bc || calls) {
+            mp_obj_list_append(funs, mp_vm_stats_fun_info(fun_bc, calls, MP_STATE_VM(vm_stats_ticks)[index]));
+        }
+    }
+
+    mp_obj_t items[2] = { opcodes, funs };
+    return mp_obj_new_tuple(2, items);
+}
+
+MP_REGISTER_ROOT_POINTER(const struct _mp_obj_fun_bc_t *vm_stats_fun[MICROPY_PY_MICROPYTHON_VM_STATS_FUNCS]);
+
+#endif // MICROPY_PY_MICROPYTHON_VM_STATS
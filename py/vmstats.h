@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2025 Gregory Neverov
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/bc.h"
+#include "py/mphal.h"
+#include "py/mpstate.h"
+
+#if MICROPY_PY_MICROPYTHON_VM_STATS
+
+void mp_vm_stats_reset(void);
+
+// Called by the VM on entry to a bytecode function, returns the index to pass to mp_vm_stats_leave().
+size_t mp_vm_stats_enter(const mp_code_state_t *code_state);
+
+static inline void mp_vm_stats_leave(size_t index, mp_uint_t start) {
+    MP_STATE_VM(vm_stats_ticks)[index] += mp_hal_ticks_cpu() - start;
+}
+
+// Returns a tuple of a dict of opcode counts and a list of (name, file, line, calls, ticks) per function.
+mp_obj_t mp_vm_stats_get(void);
+
+#endif
@@ -0,0 +1,109 @@
+# tests folding of comparisons, conditional expressions and constant lists in parser
+
+
+def f(x):
+    print("f", x)
+    return x
+
+
+# comparisons of constants
+print(1 < 2, 2 < 1, 1 == 1, 1 != 1, 2 >= 2, 2 <= 1)
+print(1 < 2 < 3, 1 < 3 < 2, 3 > 2 > 1 > 0)
+print("a" == "a", "a" < "b", b"x" != b"y", None == None)
+print(1 == 1.0, 0.5 < 1)
+print(1 in (1, 2), 3 in (1, 2), 3 not in (1, 2), "b" in "abc")
+print(() == (), (1, "a") == (1, "a"), (1, 2) < (1, 3))
+
+# comparisons that raise are left to run-time
+try:
+    1 < "a"
+except TypeError:
+    print("TypeError")
+try:
+    1 in 2
+except TypeError:
+    print("TypeError")
+
+# a false link short-circuits the rest of the chain
+print(2 < 1 < "a")
+
+# comparisons with non-constants
+x = 2
+print(1 < x < 3, x == 2 == 2, 1 < 2 < x)
+
+# conditional expressions with a constant condition
+print(f(1) if True else foo)
+print(foo if False else f(2))
+print(f(3) if 1 < 2 else foo)
+print(foo if 0 else f(4) if "" else f(5))
+
+# constant lists that are only iterated over or tested for membership
+print(x in [1, 2, 3], x not in [1, 2, 3], x in [], x in [x])
+for i in [1, "a", (2, 3), None]:
+    print(i)
+for i in []:
+    print(i)
+print([i * 2 for i in [1, 2, 3]])
+print([i for i in [[1], [2]]])
+
+# in a chain only the last operand is only tested for membership
+x = 1
+print(x in [1, 2] == [1, 2], x in [1, 2] < [1, 3], x not in [3] != [3], 1 < x + 1 in [2])
+
+
+# in a function, and with an else clause
+def g():
+    for i in [4, 5]:
+        if i in [5]:
+            print("found", i)
+            break
+    else:
+        print("not found")
+
+
+g()
+g()
+
+
+# a dropped branch that makes a function a generator, or binds a local, is kept
+def h1():
+    return (yield) if False else 1
+
+
+def h2():
+    return 1 if True else (yield from ())
+
+
+print(type(h1()).__name__, type(h2()).__name__)
+
+
+def h3():
+    print(2 if True else (y := 1))
+    try:
+        y
+    except NameError:
+        print("NameError")
+
+
+h3()
+
+
+# a constant if or while condition doesn't drop a body that affects the scope
+def h4():
+    if 1 > 2:
+        yield 1
+
+
+def h5():
+    while 1 in ():
+        yield 1
+
+
+def h6():
+    if 1 < 2:
+        return
+    else:
+        yield 1
+
+
+print(type(h4()).__name__, type(h5()).__name__, type(h6()).__name__)
@@ -0,0 +1,75 @@
+# Test deque operations against a list, with enough items to span many blocks
+# when the deque is stored in blocks.
+
+try:
+    from collections import deque
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+seed = 1
+
+
+def rand(n):
+    global seed
+    seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+    return (seed >> 8) % n
+
+
+d = deque()
+l = []
+ok = True
+for step in range(20000):
+    op = rand(16)
+    if op < 4:
+        d.append(step)
+        l.append(step)
+    elif op < 7:
+        d.appendleft(step)
+        l.insert(0, step)
+    elif op == 7 and l:
+        ok = ok and d.pop() == l.pop()
+    elif op == 8 and l:
+        ok = ok and d.popleft() == l.pop(0)
+    elif op == 9 and l:
+        i = rand(len(l))
+        d[i] = -step
+        l[i] = -step
+        ok = ok and d[i] == l[i] and d[-1 - i] == l[-1 - i]
+    elif op == 10 and l:
+        i = rand(len(l))
+        del d[i]
+        del l[i]
+    elif op == 11:
+        i = rand(len(l) + 1)
+        d.insert(i, step)
+        l.insert(i, step)
+    elif op == 12 and rand(50) == 0:
+        d.clear()
+        l.clear()
+    elif op == 13:
+        n = rand(40)
+        d.extend(range(n))
+        l.extend(range(n))
+    elif op == 14 and l:
+        n = rand(len(l)) - len(l) // 2
+        d.rotate(n)
+        if n:
+            l[:] = l[-n:] + l[:-n]
+    elif op == 15 and rand(10) == 0:
+        # drain from one end
+        while len(l) > 10:
+            ok = ok and d.popleft() == l.pop(0)
+    if step % 1000 == 0:
+        ok = ok and list(d) == l and len(d) == len(l)
+print(ok, list(d) == l)
+
+# Grow a large deque at both ends, then drain it from each end.
+d = deque()
+for i in range(5000):
+    d.append(i)
+    d.appendleft(-i)
+print(len(d), d[0], d[-1], d[5000], d[4999])
+print(sum(d.popleft() for _ in range(5000)), sum(d.pop() for _ in range(5000)), len(d))
+d.append(1)
+print(d)
@@ -0,0 +1,40 @@
+# check that str and bytes keys hash the same however they were created
+
+# strings of every length around the 8-byte word size
+words = ["abcdefghijklmnopq"[:n] for n in range(18)]
+
+d = {}
+for w in words:
+    d[w] = len(w)
+
+# lookup with strings built at runtime, which may or may not be interned
+for w in words:
+    k = "".join(list(w))
+    print(k in d, d.get(k + "", -1), d.get(w[:-1] + w[-1:], -1))
+
+# strings from split, slicing and decoding
+text = "the quick brown fox jumps over the lazy dog the end"
+counts = {}
+for w in text.split():
+    counts[w] = counts.get(w, 0) + 1
+print(sorted(counts.items()))
+print(counts[text[:3]], counts[str(b"the", "ascii")], counts[b"lazy".decode()])
+
+# hash of a string is the same before and after it's used as a key
+s = "x" * 100 + "y"
+h = hash(s)
+print({s: 1}[("x" * 100 + "y")], hash(s) == h, hash("x" * 100 + "y") == h)
+
+# bytes keys, including ones converted to and from str
+b = {}
+for w in words:
+    b[w.encode()] = w
+for w in words:
+    print(b[bytes(w, "ascii")] == w, b[bytes(bytearray(w, "ascii"))] == w)
+print(str(bytes(words[10], "ascii"), "ascii") in d)
+
+# sets use the same hash
+s = set(words)
+print(all(w[:] in s for w in words), all("".join(list(w)) in s for w in words))
+s = set(w.encode() for w in words)
+print(all(bytes(w, "ascii") in s for w in words))
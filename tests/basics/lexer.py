@@ -91,3 +91,14 @@ try:
     eval("01")
 except SyntaxError:
     print("SyntaxError")
+
+# identifiers, indentation and comments in in-memory sources
+exec("long_identifier_name = 1\r\nif long_identifier_name:\r\n        print(long_identifier_name)  # comment\r\n")
+exec("if 1:\r        print('cr')\r# comment\r")
+exec("abc = 2 # comment without newline")
+print(abc)
+exec("abcdefghijklmnop = 3")
+print(abcdefghijklmnop)
+exec("a = 4\n        ")
+print(a)
+exec("if 1:\n\t    print('tab')  # \ttab\n")
@@ -0,0 +1,124 @@
+# test that list.sort and sorted are stable, and handle runs in the data
+
+
+# generate pseudo-random data that's the same on all implementations
+def lcg(n, m, seed=1):
+    l = []
+    for _ in range(n):
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+        l.append(seed % m)
+    return l
+
+
+def check(l, key=None, reverse=False):
+    # sort (value, index) pairs on value only, ties must keep index order
+    p = [(x, i) for i, x in enumerate(l)]
+    k = (lambda t: t[0]) if key is None else (lambda t: key(t[0]))
+    p.sort(key=k, reverse=reverse)
+    ok = True
+    for i in range(1, len(p)):
+        a, b = k(p[i - 1]), k(p[i])
+        if (b > a) if reverse else (b < a):
+            ok = False
+        if a == b and p[i - 1][1] > p[i][1]:
+            ok = False
+    print(len(l), ok, sorted(l, key=key, reverse=reverse) == [t[0] for t in p])
+
+
+for n in (2, 10, 64, 65, 300, 2000):
+    check(lcg(n, 5))
+    check(lcg(n, 5), reverse=True)
+    check(lcg(n, 1000), key=lambda x: x % 7)
+    check(list(range(n)) + list(range(n)))
+    check(list(range(n, 0, -1)), reverse=True)
+    check([x // 3 for x in range(n, 0, -1)])
+
+# nearly sorted data
+l = list(range(1000))
+for i, j in zip(lcg(20, 1000, 2), lcg(20, 1000, 3)):
+    l[i], l[j] = l[j], l[i]
+check(l)
+l.sort()
+print(l == list(range(1000)))
+
+# strings, floats and mixed int/float keys
+check([str(x) for x in lcg(200, 50)])
+check([x / 4 for x in lcg(200, 50)])
+check([x if x % 2 else x + 0.0 for x in lcg(200, 50)])
+check([x << 70 for x in lcg(200, 50)])
+
+# each key is computed only once per item
+calls = 0
+
+
+def key(x):
+    global calls
+    calls += 1
+    return -x
+
+
+l = lcg(500, 100)
+l.sort(key=key)
+print(calls, l == sorted(l, key=lambda x: -x))
+
+
+# an exception from a comparison propagates and the list keeps all its items
+class A:
+    def __init__(self, x):
+        self.x = x
+
+    def __lt__(self, other):
+        if self.x == 13 or other.x == 13:
+            raise ValueError
+        return self.x < other.x
+
+
+l = [A(x) for x in lcg(100, 50)] + [A(13)]
+try:
+    l.sort()
+except ValueError:
+    print("ValueError")
+print(len(l), sorted(a.x for a in l) == sorted(lcg(100, 50) + [13]))
+
+# modifying the list while it's being sorted raises ValueError
+l = [3, 1, 2]
+try:
+    l.sort(key=lambda x: l.append(x) or x)
+except ValueError:
+    print("ValueError")
+print(l)
+
+# the list appears empty while it's being sorted
+l = [3, 1, 2]
+l.sort(key=lambda x: len(l) or x)
+print(l)
+
+# replacing an item is detected too, and an error leaves the list unchanged
+def set_first(x):
+    l[0] = x
+    return x
+
+
+l = [3, 1, 2]
+try:
+    l.sort(key=set_first)
+except IndexError:
+    print("IndexError")
+print(l)
+
+
+class B:
+    def __init__(self, x):
+        self.x = x
+
+    def __lt__(self, other):
+        l.append(self)
+        return self.x < other.x
+
+
+l = [B(x) for x in (3, 1, 2)]
+try:
+    l.sort()
+except ValueError:
+    print("ValueError")
+print([b.x for b in l])
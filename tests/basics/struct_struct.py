@@ -0,0 +1,58 @@
+# test struct.Struct
+try:
+    import struct
+
+    struct.Struct
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+s = struct.Struct("<bHi2sx")
+print(s.format, s.size)
+b = s.pack(-1, 300, 70000, b"ab")
+print(b)
+print(s.unpack(b))
+print(s.unpack_from(b"\x00" + b, 1))
+print(s.unpack_from(b"\x00" + b, -s.size))
+
+buf = bytearray(s.size + 2)
+s.pack_into(buf, 1, 1, 2, 3, b"xyz")
+print(buf)
+s.pack_into(buf, -s.size, 4, 5, 6, b"")
+print(buf)
+
+# native alignment gives the same size as calcsize
+for fmt in ("bi", "@bi", "hxq", "3b2h", "2x", "d", "i0sb"):
+    print(fmt, struct.Struct(fmt).size == struct.calcsize(fmt))
+s = struct.Struct("bhiq")
+print(s.unpack(s.pack(1, 2, 3, 4)))
+
+# repeat counts
+s = struct.Struct(">3H2s")
+print(s.unpack(s.pack(1, 2, 3, b"zz")))
+
+# iter_unpack
+s = struct.Struct("<hB")
+data = bytes(range(12))
+print(list(s.iter_unpack(data)))
+print(list(s.iter_unpack(b"")))
+it = s.iter_unpack(bytearray(b"\x01\x00\x02"))
+print(next(it))
+try:
+    next(it)
+except StopIteration:
+    print("StopIteration")
+
+# errors
+try:
+    s.unpack(b"12")
+except Exception:
+    print("Exception")
+try:
+    s.pack_into(bytearray(2), 0, 1, 2)
+except Exception:
+    print("Exception")
+try:
+    s.iter_unpack(b"1234")
+except Exception:
+    print("Exception")
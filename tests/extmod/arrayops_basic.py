@@ -0,0 +1,171 @@
+# test arrayops module
+try:
+    import arrayops
+    from array import array
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+# lengths not a multiple of any vector width
+N = 37
+
+
+def ref_wrap(tc, x):
+    # wrap an integer to the range of typecode tc
+    bits = len(bytes(array(tc, [0]))) * 8
+    x &= (1 << bits) - 1
+    if tc in "bhilq" and x >= 1 << (bits - 1):
+        x -= 1 << bits
+    return x
+
+
+def check_binop(tc, name, op):
+    a = array(tc, [(i * 37 + 11) % 100 for i in range(N)])
+    b = array(tc, [(i * 13 + 5) % 50 for i in range(N)])
+    d = array(tc, [0] * N)
+    getattr(arrayops, name)(d, a, b)
+    r1 = list(d) == [ref_wrap(tc, op(x, y)) for x, y in zip(a, b)]
+    getattr(arrayops, name)(d, a, 3)
+    r2 = list(d) == [ref_wrap(tc, op(x, 3)) for x in a]
+    print(tc, name, r1, r2)
+
+
+for tc in "bBhHiIlLqQ":
+    check_binop(tc, "add", lambda x, y: x + y)
+    check_binop(tc, "sub", lambda x, y: x - y)
+    check_binop(tc, "mul", lambda x, y: x * y)
+
+# float arrays
+for tc in "fd":
+    a = array(tc, [i / 4 for i in range(N)])
+    b = array(tc, [i / 2 for i in range(N)])
+    d = array(tc, [0] * N)
+    arrayops.add(d, a, b)
+    print(tc, list(d) == [x + y for x, y in zip(a, b)])
+    arrayops.mul(d, a, 0.5)
+    print(tc, list(d) == [x * 0.5 for x in a])
+    arrayops.sub(d, a, 1)
+    print(tc, list(d) == [x - 1 for x in a])
+
+# in place, and mixing typecodes
+a = array("h", [100, -200, 300])
+arrayops.mul(a, a, 2)
+print(a)
+d = array("f", [0] * 3)
+arrayops.add(d, a, array("b", [1, 2, 3]))
+print(d)
+d = array("B", [0] * 3)
+arrayops.mul(d, array("f", [1.5, 2.7, -1.2]), 2)
+print(d)
+
+# bytearray and memoryview
+ba = bytearray(b"\x01\x02\xff")
+arrayops.add(ba, ba, 1)
+print(ba)
+m = memoryview(array("i", [1, 2, 3, 4]))[1:3]
+arrayops.mul(m, m, 10)
+print(list(m))
+
+# reductions
+for tc in "bBhHiIqQfd":
+    a = array(tc, [(i * 37 + 11) % 100 for i in range(N)])
+    print(tc, arrayops.sum(a), arrayops.min(a), arrayops.max(a), arrayops.dot(a, a))
+a = array("H", [65535] * 1000)
+print(arrayops.sum(a) == 65535 * 1000)
+a = array("h", [-32768] * 1000)
+print(arrayops.sum(a) == -32768 * 1000)
+print(arrayops.sum(bytes(range(256)) * 3))
+print(arrayops.max(array("Q", [1, 2**64 - 1, 3])))
+print(arrayops.min(array("q", [1, -(2**63), 3])))
+
+# clip
+for tc in "hBf":
+    a = array(tc, [(i * 37 + 11) % 100 for i in range(N)])
+    d = array(tc, [0] * N)
+    arrayops.clip(d, a, 20, 60)
+    print(tc, list(d) == [min(max(x, 20), 60) for x in a])
+d = array("i", [0] * 4)
+arrayops.clip(d, array("i", [-5, 0, 5, 10]), 0, 7)
+print(d)
+
+# convert
+d = array("b", [0] * 4)
+arrayops.convert(d, array("i", [1, -1, 127, 300]))
+print(d)
+d = array("f", [0] * 3)
+arrayops.convert(d, array("h", [1, -2, 3]))
+print(d)
+d = array("h", [0] * 3)
+arrayops.convert(d, array("d", [1.9, -2.9, 1e30]))
+print(d)
+
+# byteswap
+for tc in "hiq":
+    a = array(tc, range(1, N + 1))
+    b = array(tc, a)
+    arrayops.byteswap(a)
+    arrayops.byteswap(a)
+    print(tc, a == b)
+a = array("H", [0x1234, 0xABCD])
+arrayops.byteswap(a)
+print([hex(x) for x in a])
+a = array("I", [0x12345678] * 5)
+arrayops.byteswap(a)
+print([hex(x) for x in a])
+
+# 64-bit boundaries: sums are exact and unsigned values compare as unsigned
+print(arrayops.sum(array("Q", [2**63, 1])), arrayops.sum(array("Q", [2**64 - 1] * 3)))
+print(arrayops.sum(array("q", [2**62, 2**62])), arrayops.sum(array("q", [-(2**63), -1])))
+print(arrayops.dot(array("q", [2**62, 3]), array("q", [4, 5])))
+print(arrayops.dot(array("Q", [2**63]), array("b", [-2])))
+print(arrayops.min(array("Q", [2**63 + 5, 7])), arrayops.max(array("Q", [2**63 + 5, 7])))
+d = array("Q", [0] * 3)
+arrayops.clip(d, array("Q", [2**63 + 5, 5, 2**64 - 1]), 0, 10)
+print(d)
+arrayops.clip(d, array("Q", [2**63 + 5, 5, 2**64 - 1]), 2**63, 2**64 - 2)
+print(d)
+arrayops.clip(d, array("Q", [2**63 + 5, 5, 2**64 - 1]), -(2**70), 2**70)
+print(d)
+d = array("q", [0] * 3)
+arrayops.clip(d, array("q", [-(2**63), 0, 2**63 - 1]), -1, 2**64 - 1)
+print(d)
+
+# dest partially overlapping a source, which is read as it was before the call
+for tc in "bhiqfd":
+    m = memoryview(array(tc, range(N)))
+    arrayops.add(m[1:], m[:-1], 0)
+    r1 = list(m) == [0] + list(range(N - 1))
+    m = memoryview(array(tc, range(N)))
+    arrayops.sub(m[1:], m[1:], m[:-1])
+    r2 = list(m) == [0] + [1] * (N - 1)
+    m = memoryview(array(tc, range(N)))
+    arrayops.mul(m[:-1], m[1:], m[:-1])
+    ref = [i * (i + 1) for i in range(N - 1)]
+    if tc == "b":
+        ref = [ref_wrap(tc, x) for x in ref]
+    r3 = list(m) == ref + [N - 1]
+    print(tc, r1, r2, r3)
+m = memoryview(array("i", range(N)))
+arrayops.clip(m[2:], m[:-2], 5, 30)
+print(list(m) == [0, 1] + [min(max(i, 5), 30) for i in range(N - 2)])
+m = memoryview(array("h", range(N)))
+arrayops.convert(m[3:], m[:-3])
+print(list(m) == [0, 1, 2] + list(range(N - 3)))
+
+# errors
+try:
+    arrayops.add(array("i", [0] * 2), array("i", [1, 2, 3]), 1)
+except ValueError:
+    print("ValueError")
+try:
+    arrayops.min(array("i"))
+except ValueError:
+    print("ValueError")
+try:
+    arrayops.sum([1, 2])
+except TypeError:
+    print("TypeError")
+try:
+    arrayops.add(bytes(3), bytes(3), 1)
+except TypeError:
+    print("TypeError")
@@ -0,0 +1,48 @@
+# Test asyncio.Stream.write queueing when the underlying stream accepts data slowly.
+
+try:
+    import asyncio, io
+
+    asyncio.StreamWriter.cork
+    io.IOBase
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+class SlowStream(io.IOBase):
+    def __init__(self, n):
+        self.n = n
+        self.data = bytearray()
+
+    def write(self, buf):
+        n = min(len(buf), self.n)
+        self.data += buf[:n]
+        return n
+
+    def ioctl(self, req, arg):
+        # always ready when polled (req 3 is MP_STREAM_POLL)
+        return arg if req == 3 else 0
+
+
+async def main():
+    s = SlowStream(7)
+    w = asyncio.StreamWriter(s)
+    w.set_write_buffer_limits(64)
+    expected = bytearray()
+    for i in range(500):
+        buf = b"%d," % i
+        w.write(buf if i % 2 else bytearray(buf))
+        expected += buf
+    print(w.get_write_buffer_size() == len(expected) - len(s.data), len(s.data) > 0)
+
+    # corked writes are gathered into one buffer on drain
+    w.cork()
+    w.write(b"a" * 100)
+    w.write(b"b")
+    expected += b"a" * 100 + b"b"
+    await w.drain()
+    print(w.get_write_buffer_size(), s.data == expected)
+
+
+asyncio.run(main())
@@ -0,0 +1,145 @@
+# Test heapq.PriorityQueue.
+
+try:
+    from heapq import PriorityQueue
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+pq = PriorityQueue()
+print(len(pq), bool(pq))
+a = pq.push(3, "a")
+b = pq.push(1, "b")
+c = pq.push(2, "c")
+print(len(pq), bool(pq), a.priority, a.item)
+print(pq.peek().item, len(pq))
+
+# Equal priorities come out in the order they were pushed.
+d = pq.push(2, "d")
+e = pq.push(2, "e")
+print([pq.pop().item for _ in range(len(pq))])
+print(a in pq, len(pq))
+
+# Updating a priority, in either direction, and removing entries.
+entries = [pq.push(p, i) for i, p in enumerate((5, 8, 1, 9, 4, 7))]
+pq.update(entries[1], 0)
+pq.update(entries[2], 6)
+pq.remove(entries[4])
+print(entries[4] in pq, entries[0] in pq, 4 in pq)
+out = []
+while pq:
+    x = pq.pop()
+    out.append((x.priority, x.item))
+print(out)
+
+# Float and mixed priorities, and generic comparable objects.
+pq.push(1.5, "x")
+pq.push(1, "y")
+pq.push(-2.5, "z")
+pq.push(True, "t")
+print([pq.pop().item for _ in range(len(pq))])
+pq.push((1, "b"), 1)
+pq.push((1, "a"), 2)
+pq.push((0, "z"), 3)
+print([pq.pop().item for _ in range(len(pq))])
+
+# Errors.
+try:
+    pq.pop()
+except IndexError:
+    print("IndexError")
+try:
+    pq.peek()
+except IndexError:
+    print("IndexError")
+for x in (a, None, 1):
+    try:
+        pq.remove(x)
+    except ValueError:
+        print("ValueError")
+    try:
+        pq.update(x, 1)
+    except ValueError:
+        print("ValueError")
+
+# An entry of another queue can't be used.
+pq2 = PriorityQueue()
+f = pq2.push(1, "f")
+pq.push(1, "g")
+print(f in pq, f in pq2)
+try:
+    pq.remove(f)
+except ValueError:
+    print("ValueError")
+
+# Priorities that can't be compared raise TypeError.
+pq = PriorityQueue()
+pq.push(1, 1)
+try:
+    pq.push("x", 2)
+except TypeError:
+    print("TypeError")
+print(len(pq))
+
+# A comparison that changes the queue raises RuntimeError, and the queue
+# still holds valid entries afterwards.
+class P:
+    def __init__(self, x, action=None):
+        self.x = x
+        self.action = action
+
+    def __lt__(self, other):
+        action = self.action or other.action
+        if action:
+            self.action = other.action = None
+            action()
+        return self.x < other.x
+
+
+for action in (lambda: pq.pop(), lambda: pq.push(P(0), "z")):
+    pq = PriorityQueue()
+    for i in range(8):
+        pq.push(P(i), i)
+    try:
+        pq.push(P(-1, action), "y")
+    except RuntimeError:
+        print("RuntimeError")
+    print(len(pq), len([pq.pop() for _ in range(len(pq))]))
+
+pq = PriorityQueue()
+for i in range(8):
+    pq.push(P(i), i)
+x = pq.push(P(9), 9)
+try:
+    pq.update(x, P(-1, lambda: pq.remove(pq.peek())))
+except RuntimeError:
+    print("RuntimeError")
+print(len(pq), len([pq.pop() for _ in range(len(pq))]))
+
+# Random pushes, updates and removals, checked against sorting.
+seed = 1
+
+
+def rand(n):
+    global seed
+    seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+    return (seed >> 16) % n
+
+
+pq = PriorityQueue()
+live = []
+for i in range(600):
+    op = rand(4)
+    if op <= 1 or not live:
+        live.append(pq.push(rand(100), i))
+    elif op == 2:
+        x = live[rand(len(live))]
+        pq.update(x, rand(100))
+    else:
+        pq.remove(live.pop(rand(len(live))))
+expected = sorted((x.priority, x.item) for x in live)
+got = []
+while pq:
+    x = pq.pop()
+    got.append((x.priority, x.item))
+print(len(got), [p for p, _ in got] == [p for p, _ in expected], sorted(got) == expected)
@@ -0,0 +1,22 @@
+# Test the ssl.SSLContext.maximum_fragment_length attribute.
+
+try:
+    import ssl
+
+    ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT).maximum_fragment_length
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+print(ctx.maximum_fragment_length)
+for length in (512, 1024, 2048, 4096, None):
+    ctx.maximum_fragment_length = length
+    print(ctx.maximum_fragment_length)
+
+# Only the lengths defined by RFC 6066 are allowed.
+for length in (0, 256, 511, 8192, 16384, -1):
+    try:
+        ctx.maximum_fragment_length = length
+    except ValueError:
+        print("ValueError", length, ctx.maximum_fragment_length)
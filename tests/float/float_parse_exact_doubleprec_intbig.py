@@ -0,0 +1,70 @@
+# test that parsing rounds correctly, including long inputs that are exactly
+# halfway between two doubles or differ from halfway only in a distant digit
+
+try:
+    import struct
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def from_bits(b):
+    return struct.unpack("<d", struct.pack("<Q", b))[0]
+
+
+# digits and exponent of the exact midpoint between a double and the next one up
+def halfway(b):
+    exp = (b >> 52) & 0x7FF
+    frc = b & ((1 << 52) - 1)
+    if exp:
+        frc |= 1 << 52
+        e = exp - 1076
+    else:
+        e = -1075
+    n = 2 * frc + 1
+    if e >= 0:
+        return str(n << e), 0
+    return str(n * 5**-e), e
+
+
+def test(b):
+    d, e = halfway(b)
+    below = str(int(d) - 1) + "9" * 30
+    above = d + "0" * 29 + "1"
+    print(repr(float(d + "e" + str(e))), repr(float(below + "e" + str(e - 30))), repr(float(above + "e" + str(e - 30))))
+
+
+# well known hard cases
+for s in (
+    "2.2250738585072011e-308",
+    "2.2250738585072012e-308",
+    "9007199254740993",
+    "9007199254740995",
+    "9007199254740993.0000000000000000000000001",
+    "1e23",
+    "8.98846567431158e307",
+    "1.7976931348623157e308",
+    "1.7976931348623158e308",
+    "4.9406564584124654e-324",
+    "2.4703282292062328e-324",
+    "2.4703282292062327e-324",
+    "0.1000000000000000055511151231257827",
+    "0.1000000000000000055511151231257828",
+    "7.3177701707893310e+15",
+    "1.00000000000000011102230246251565404236316680908203125",
+    "1.00000000000000011102230246251565404236316680908203124",
+):
+    print(s, repr(float(s)))
+
+# midpoints with even and odd lower neighbours, subnormals, and the overflow threshold
+for b in (0, 1, 2, 0x000FFFFFFFFFFFFF, 0x0010000000000000, 0x3FF0000000000000, 0x3FF0000000000001, 0x4340000000000000):
+    test(b)
+test(0x7FEFFFFFFFFFFFFF)
+
+# pseudo-random doubles
+seed = 1
+for i in range(40):
+    seed = (seed * 6364136223846793005 + 1442695040888963407) & 0xFFFFFFFFFFFFFFFF
+    b = seed >> 1
+    if b >> 52 != 0x7FF:
+        test(b & 0x800FFFFFFFFFFFFF if i % 4 == 0 else b)
@@ -0,0 +1,50 @@
+# test that repr gives the shortest string that parses back to the same double,
+# and the closest one to the exact value when there are several
+
+try:
+    import struct
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def from_bits(b):
+    return struct.unpack("<d", struct.pack("<Q", b))[0]
+
+
+# boundaries of the representation
+print(repr(from_bits(1)))  # smallest subnormal
+print(repr(from_bits(0x000FFFFFFFFFFFFF)))  # largest subnormal
+print(repr(from_bits(0x0010000000000000)))  # smallest normal
+print(repr(from_bits(0x7FEFFFFFFFFFFFFF)))  # largest normal
+print(repr(-from_bits(0x0010000000000001)))
+
+# powers of 2, whose lower neighbour is closer than the upper one
+for e in (-1074, -1022, -1021, -100, -1, 0, 1, 52, 53, 54, 100, 1023):
+    print(repr(2.0**e))
+
+# switching between fixed and exponent notation
+for x in (1e15, 1e16, 1e17, 1.5e16, 123456789012345678.0, 1e-4, 1e-5, 0.000123, 0.0000123):
+    print(repr(x))
+
+# sums that don't have a short exact decimal
+print(repr(0.1 + 0.2), repr(1 / 3), repr(2 / 3), repr(100 / 7))
+
+# values with 17 digits, and ones close to halfway between two 17 digit strings
+for b in (0x3FF0000000000001, 0x4340000000000001, 0x44B52D02C7E14AF6, 0x7E37E43C8800759C, 0x0C98DF6C1B94E7EB):
+    print(repr(from_bits(b)))
+
+# values where the fast algorithm can't decide and an exact method is needed
+for b in (0x43800000000074DD, 0x0080000000001585, 0x50890C1E1E94C7D0, 0x72B66699F552E58C, 0x42311031A4014FC6):
+    print(repr(from_bits(b)))
+
+# pseudo-random bit patterns across all exponents
+seed = 1
+for i in range(500):
+    seed = (seed * 6364136223846793005 + 1442695040888963407) & 0xFFFFFFFFFFFFFFFF
+    b = seed >> 1
+    if b >> 52 == 0x7FF:
+        continue
+    f = from_bits(b)
+    s = repr(f)
+    print(s, float(s) == f)
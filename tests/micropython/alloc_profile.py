@@ -0,0 +1,61 @@
+# test micropython.alloc_profile_start/stop/dump
+
+try:
+    import gc, io, sys
+    import micropython
+
+    micropython.alloc_profile_start
+except (AttributeError, ImportError):
+    print("SKIP")
+    raise SystemExit
+
+
+def make_lists(n):
+    lists = []
+    for i in range(n):
+        lists.append([i])
+    return lists
+
+
+def make_garbage(n):
+    for i in range(n):
+        [i]
+
+
+micropython.alloc_profile_start(interval=1, sites=32, track=256)
+keep = make_lists(20)
+make_garbage(20)
+micropython.alloc_profile_stop()
+gc.collect()
+
+out = io.StringIO()
+micropython.alloc_profile_dump(out)
+lines = out.getvalue().splitlines()
+print(lines[0].startswith("# interval=1 "))
+
+sites = {}
+for line in lines:
+    if line.startswith("#"):
+        continue
+    nbytes, count, live, typ, location = line.split(" ", 4)
+    name = location.split(" ")[0]
+    # keep the site with the most bytes in each function
+    if typ == "list" and name in ("make_lists", "make_garbage") and name not in sites:
+        sites[name] = (int(count), int(live))
+print(sites["make_lists"])
+print(sites["make_garbage"][0], sites["make_garbage"][1] < 20)
+
+# sites are sorted by bytes
+nbytes = [int(line.split(" ")[0]) for line in lines if not line.startswith("#")]
+print(nbytes == sorted(nbytes, reverse=True))
+
+# invalid arguments
+try:
+    micropython.alloc_profile_start(interval=0)
+except ValueError:
+    print("ValueError")
+for kw in ({"sites": sys.maxsize}, {"track": sys.maxsize}):
+    try:
+        micropython.alloc_profile_start(interval=1, **kw)
+    except ValueError:
+        print("ValueError")
@@ -0,0 +1,92 @@
+# Test that imported .py files are cached as bytecode in __pycache__, and that
+# the cache is rebuilt when the source changes.
+
+try:
+    import os, sys
+
+    os.mkdir
+    sys.path
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+MODULE = "bytecode_cache_mod"
+CACHE_DIR = "__pycache__"
+CACHE_FILE = CACHE_DIR + "/" + MODULE + ".mpy"
+
+
+def write_module(source):
+    with open(MODULE + ".py", "w") as f:
+        f.write(source)
+
+
+def import_module():
+    sys.modules.pop(MODULE, None)
+    return __import__(MODULE)
+
+
+def cleanup():
+    for name in (MODULE + ".py", CACHE_FILE):
+        try:
+            os.remove(name)
+        except OSError:
+            pass
+    try:
+        os.rmdir(CACHE_DIR)
+    except OSError:
+        pass
+
+
+cleanup()
+sys.path.insert(0, "")
+try:
+    write_module("def f():\n    return 1\n")
+    mod = import_module()
+    try:
+        os.stat(CACHE_FILE)
+    except OSError:
+        print("SKIP")
+        raise SystemExit
+    print(mod.f(), mod.__file__)
+
+    # Imported from the cache.
+    mod = import_module()
+    print(mod.f(), mod.__file__)
+
+    # Check the cache really is used by changing a string in it (it keeps the
+    # header that matches the source).
+    write_module("def f():\n    return 'abcd'\n")
+    import_module()
+    with open(CACHE_FILE, "rb") as f:
+        data = f.read()
+    with open(CACHE_FILE, "wb") as f:
+        f.write(data.replace(b"abcd", b"wxyz"))
+    print(import_module().f())
+
+    # Source changed, so the cache is rebuilt.
+    write_module("def f():\n    return 1234\n")
+    mod = import_module()
+    print(mod.f())
+    mod = import_module()
+    print(mod.f())
+
+    # A cache file whose .mpy data can't be loaded falls back to the source,
+    # and is rewritten.  The .mpy data follows a 24-byte header.
+    with open(CACHE_FILE, "r+b") as f:
+        f.seek(24)
+        print(f.read(1))
+        f.seek(24)
+        f.write(b"X")
+    mod = import_module()
+    print(mod.f())
+    with open(CACHE_FILE, "rb") as f:
+        f.seek(24)
+        print(f.read(1))
+
+    # The cache is written to a temporary file that is renamed into place, so
+    # no other files are left behind.
+    print(os.listdir(CACHE_DIR))
+finally:
+    sys.path.pop(0)
+    sys.modules.pop(MODULE, None)
+    cleanup()
@@ -0,0 +1,47 @@
+# Test importing a bytecode .mpy file from the filesystem, which may reference
+# the file's data in place if the port memory-maps .mpy files.
+
+try:
+    import gc, os, sys
+
+    if sys.implementation._mpy & 0xFF != 6:
+        raise AttributeError
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+# Generated by mpy-cross from:
+#   S = "in-place str"
+#   B = b"in-place bytes"
+#
+#   def f(x):
+#       return (x, "const", b"\x00\x01", 1.5, 12345678901234567890)
+#
+#   class C:
+#       def m(self):
+#           return S
+MPY = (
+    b"M\x06\x00\x1f\r\x05\x08m.py\x00\x0f\x02C\x00\x02f\x00\x81\x11\x02m\x00\x02S\x00\x02B\x00\x02x\x00/-5\x82\x13\x05\x0cin-place"
+    b" str\x00\x06\x0ein-place bytes\x00\x06\x02\x00\x01\x00\x08\x031.5\x07\x1412345678901234"
+    b"567890\x81t\x10\n\x01$dd #\x00\x16\x06#\x01\x16\x072\x00\x16\x03T2\x01\x10\x024\x02\x16\x02Qc\x02\x81\x10)\x08\x03\x08`@\xb0"
+    b"\x10\x04#\x02#\x03#\x04*\x05c\x81\x1c\x00\x06\x02\x88\t\x11\t\x16\n\x10\x02\x16\x0b2\x00\x16\x05Qc\x01H\t\x08\x05\x0c\x80\n\x12\x06c"
+)
+
+MODULE = "import_mpy_file_mod"
+
+with open(MODULE + ".mpy", "wb") as f:
+    f.write(MPY)
+sys.path.insert(0, "")
+try:
+    mod = __import__(MODULE)
+finally:
+    sys.path.pop(0)
+    os.remove(MODULE + ".mpy")
+
+# Use the module's constants after the file is gone and after a collection.
+gc.collect()
+print(mod.S, mod.B)
+print(mod.f(1))
+print(mod.C().m())
+print(mod.S == "in-place str", hash(mod.S) == hash("in-place str"))
+print(mod.f.__name__, mod.C.__name__)
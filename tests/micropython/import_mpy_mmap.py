@@ -0,0 +1,86 @@
+# Test that a module loaded from a memory-mapped .mpy file keeps working while
+# the file is replaced, both for the bytecode cache and for a plain .mpy file.
+
+try:
+    import gc, os, sys
+
+    os.rename
+    sys.path
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+MODULE = "import_mpy_mmap_mod"
+MPY_MODULE = "import_mpy_mmap_mpy"
+CACHE_DIR = "__pycache__"
+CACHE_FILE = CACHE_DIR + "/" + MODULE + ".mpy"
+
+SOURCE = """
+NAME = "import_mpy_mmap_name_%d"
+def f(x):
+    return (NAME, "import_mpy_mmap_const_%d", x * %d)
+"""
+
+
+def write_file(name, data):
+    with open(name, "wb") as f:
+        f.write(data)
+
+
+def write_module(n):
+    write_file(MODULE + ".py", bytes(SOURCE % (n, n, n), "ascii"))
+
+
+def import_module(name):
+    sys.modules.pop(name, None)
+    return __import__(name)
+
+
+def cleanup():
+    for name in (MODULE + ".py", MPY_MODULE + ".mpy", MPY_MODULE + ".tmp", CACHE_FILE):
+        try:
+            os.remove(name)
+        except OSError:
+            pass
+    try:
+        os.rmdir(CACHE_DIR)
+    except OSError:
+        pass
+
+
+cleanup()
+sys.path.insert(0, "")
+try:
+    write_module(1)
+    import_module(MODULE)
+    try:
+        with open(CACHE_FILE, "rb") as f:
+            mpy = f.read()[24:]
+    except OSError:
+        print("SKIP")
+        raise SystemExit
+
+    # Load from the cache, then rewrite the cache while the module is loaded.
+    mod = import_module(MODULE)
+    print(mod.f(2))
+    write_module(1000)
+    print(import_module(MODULE).f(2))
+    gc.collect()
+    print(mod.f(3))
+
+    # Load a .mpy file, then replace it with different data and remove it.
+    write_file(MPY_MODULE + ".mpy", mpy)
+    mod = import_module(MPY_MODULE)
+    print(mod.f(4))
+    write_file(MPY_MODULE + ".tmp", b"M" + bytes(len(mpy) * 2))
+    os.rename(MPY_MODULE + ".tmp", MPY_MODULE + ".mpy")
+    gc.collect()
+    print(mod.f(5))
+    os.remove(MPY_MODULE + ".mpy")
+    gc.collect()
+    print(mod.f(6), mod.NAME)
+finally:
+    sys.path.pop(0)
+    sys.modules.pop(MODULE, None)
+    sys.modules.pop(MPY_MODULE, None)
+    cleanup()
@@ -0,0 +1,126 @@
+# test native generators whose locals live in registers across yield
+
+
+# locals updated between yields
+@micropython.native
+def gen_acc(n):
+    total = 0
+    i = 0
+    while i < n:
+        total += i
+        i += 1
+        yield total
+    return total
+
+
+print(list(gen_acc(6)))
+
+
+# values sent into the generator stored in locals
+@micropython.native
+def gen_send():
+    a = 0
+    b = 1
+    while True:
+        x = yield a + b
+        if x is None:
+            return a
+        a, b = b, a + x
+
+
+g = gen_send()
+print(next(g))
+print(g.send(2))
+print(g.send(3))
+print(g.send(4))
+try:
+    g.send(None)
+except StopIteration as e:
+    print("stop", e.args[0])
+
+
+# locals preserved across yield from
+@micropython.native
+def gen_from(n):
+    a = n
+    b = n * 2
+    yield from range(a)
+    yield a + b
+    yield from gen_acc(b)
+    yield a - b
+
+
+print(list(gen_from(2)))
+
+
+# closed-over local in a native generator
+@micropython.native
+def gen_closure(n):
+    k = n
+    f = lambda x: x * k
+    for i in range(3):
+        yield f(i)
+        k += 1
+
+
+print(list(gen_closure(2)))
+
+
+# generator consumed by another native function, each with register locals
+@micropython.native
+def consume(g):
+    s = 0
+    for x in g:
+        s += x
+    return s
+
+
+print(consume(gen_acc(10)))
+
+
+# exception propagating out of a generator with register locals
+@micropython.native
+def gen_raise():
+    a = 1
+    yield a
+    a = a + 1
+    raise ValueError(a)
+
+
+g = gen_raise()
+print(next(g))
+try:
+    next(g)
+except ValueError as er:
+    print("ValueError", er.args[0])
+
+
+# native coroutine with register locals across await
+@micropython.native
+async def coro(n):
+    s = 0
+    i = 0
+    while i < n:
+        s += await gen_await(i)
+        i += 1
+    return s
+
+
+class gen_await:
+    def __init__(self, x):
+        self.x = x
+
+    def __await__(self):
+        y = yield self.x
+        return y * 10
+
+    __iter__ = __await__
+
+
+c = coro(3)
+x = c.send(None)
+try:
+    while True:
+        x = c.send(x + 1)
+except StopIteration as e:
+    print("coro", e.args[0])
@@ -0,0 +1,50 @@
+# test micropython.profile_start/stop/dump
+
+try:
+    import io, sys, time
+    import micropython
+
+    micropython.profile_start
+except (AttributeError, ImportError):
+    print("SKIP")
+    raise SystemExit
+
+
+def inner(n):
+    x = 0
+    for i in range(n):
+        x += i
+    return x
+
+
+def outer(ms):
+    t0 = time.ticks_ms()
+    while time.ticks_diff(time.ticks_ms(), t0) < ms:
+        inner(100)
+
+
+micropython.profile_start(period=1, samples=64)
+outer(200)
+micropython.profile_stop()
+
+out = io.StringIO()
+micropython.profile_dump(out)
+
+lines = out.getvalue().splitlines()
+total = 0
+for line in lines:
+    stack, count = line.rsplit(" ", 1)
+    total += int(count)
+print(0 < total <= 64)
+print(any("outer" in line for line in lines))
+print(any(line.split(" ")[0] == "<module>" for line in lines))
+
+# invalid arguments
+try:
+    micropython.profile_start(samples=0)
+except ValueError:
+    print("ValueError")
+try:
+    micropython.profile_start(samples=sys.maxsize)
+except ValueError:
+    print("ValueError")
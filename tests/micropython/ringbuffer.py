@@ -0,0 +1,102 @@
+# Check that micropython.RingBuffer works correctly.
+
+try:
+    import micropython
+
+    micropython.RingBuffer
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+import errno
+import gc
+
+# The size is rounded up to a power of 2.
+rb = micropython.RingBuffer(12, timeout=0)
+print(rb.write(b"0123456789abcdefXYZ"))
+print(rb.any())
+print(rb.write(b"!"))
+print(rb.read(4))
+print(rb.any())
+
+# Writes and reads wrap around the end of the buffer.
+print(rb.write(b"ghij"))
+print(rb.read())
+print(rb.read())
+print(rb.read(1))
+
+buf = bytearray(8)
+print(rb.readinto(buf))
+rb.write(b"klmnopqrstuv")
+print(rb.readinto(buf), buf)
+print(rb.readinto1(buf), buf)
+
+# Zero-copy views over the readable data and the free space.
+rb.write(b"0123456789")
+print([bytes(v) for v in rb.peek_views()])
+rb.consume(7)
+print([bytes(v) for v in rb.peek_views()])
+a, b = rb.reserve_views()
+print(len(a), len(b))
+a[:] = b"A" * len(a)
+b[:2] = b"BC"
+rb.commit(len(a) + 2)
+print(rb.read())
+try:
+    rb.consume(1)
+except ValueError:
+    print("ValueError")
+try:
+    rb.commit(17)
+except ValueError:
+    print("ValueError")
+
+# A user-supplied buffer must have a power-of-2 size.
+ba = bytearray(8)
+rb = micropython.RingBuffer(ba, timeout=0)
+rb.write(b"abc")
+print(ba[:3])
+for arg in (bytearray(6), 0, -1):
+    try:
+        micropython.RingBuffer(arg)
+    except ValueError:
+        print("ValueError")
+
+# The views keep the ring's storage alive after the RingBuffer is gone.
+def views():
+    rb = micropython.RingBuffer(64)
+    rb.write(b"x" * 40)
+    rb.consume(30)
+    rb.write(b"y" * 40)
+    return rb.peek_views()[0], rb.reserve_views()[0]
+
+
+def clobber_stack(n):
+    if n:
+        clobber_stack(n - 1)
+
+
+a, b = views()
+clobber_stack(50)
+gc.collect()
+junk = [bytearray(b"z" * 64) for _ in range(200)]
+b[:] = b"w" * len(b)
+print(bytes(a), len(b), all(j == b"z" * 64 for j in junk))
+
+# On timeout, as when non-blocking, the bytes done so far or None are returned.
+rb = micropython.RingBuffer(4, timeout=1)
+print(rb.write(b"abcdef"))
+print(rb.write(b"e"))
+print(rb.read(8))
+print(rb.read1(1))
+
+# Closing signals the end of the stream to the reader.
+rb = micropython.RingBuffer(16)
+rb.write(b"end")
+rb.close()
+print(rb.read(8))
+print(rb.read(8))
+try:
+    rb.write(b"x")
+except OSError as e:
+    print(e.errno == errno.EPIPE)
@@ -0,0 +1,66 @@
+# Check that micropython.StringBuilder works correctly.
+
+try:
+    import micropython
+
+    micropython.StringBuilder
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+# Appending str, bytes-like objects and ints.
+sb = micropython.StringBuilder()
+print(len(sb), bool(sb))
+sb.append("abc")
+sb.append(b"def", bytearray(b"g"), memoryview(b"xhx")[1:2])
+sb.append(123, -45, 0)
+sb.append(1 << 70)
+print(len(sb), bool(sb))
+print(sb.build())
+
+# Building empties the builder so it can be reused.
+print(len(sb), repr(sb.build()))
+sb += "x"
+sb += 1
+sb += b"y"
+print(sb.build_bytes())
+
+# Stream writes, including from print.
+sb = micropython.StringBuilder(4)
+print(sb.write(b"hello "))
+print("world", 1, 2.5, sep=",", end="!", file=sb)
+print(sb.build())
+
+# Strings of many pieces grow the buffer as needed.
+sb = micropython.StringBuilder()
+for i in range(1000):
+    sb.append(i, " ")
+s = sb.build()
+print(len(s), s[:20], s[-20:])
+print(s == " ".join(str(i) for i in range(1000)) + " ")
+
+# Non-ASCII text, and invalid utf-8 for a str.
+sb.append("αβγ", b"\xce\xb4")
+print(sb.build())
+sb.append(b"\xff")
+try:
+    sb.build()
+except UnicodeError:
+    print("UnicodeError")
+print(sb.build_bytes())
+
+# clear() discards the contents.
+sb.append("abc")
+sb.clear()
+print(len(sb), sb.build())
+
+# Unsupported values and arguments.
+for arg in (1.5, None, [1]):
+    try:
+        sb.append(arg)
+    except TypeError:
+        print("TypeError")
+try:
+    micropython.StringBuilder(-1)
+except ValueError:
+    print("ValueError")
@@ -0,0 +1,109 @@
+# test the native float type in viper code
+
+try:
+    exec("@micropython.viper\ndef f(x: float) -> float: return x")
+except ViperTypeError:
+    # no native float support on this target
+    print("SKIP")
+    raise SystemExit
+
+
+# arithmetic, with a float constant cast to native and int operands converted to float
+@micropython.viper
+def arith(a: float, b: float) -> float:
+    c = a * b + float(1.5)
+    c -= a / b
+    return -c + 2 * a - b
+
+
+print(arith(2.0, 4.0), arith(3, 7), arith(-1.5, 0.25))
+
+
+# comparisons, including NaN
+@micropython.viper
+def compare(a: float, b: float):
+    print(a < b, a > b, a == b, a <= b, a >= b, a != b)
+
+
+compare(1.0, 2.0)
+compare(2.0, 1.0)
+compare(-0.0, 0.0)
+compare(float("nan"), 1.0)
+
+
+# casts between int and float, int() truncates towards zero
+@micropython.viper
+def casts(x: float, i: int):
+    print(int(x), float(i), float(True), float(x) == x)
+
+
+casts(3.7, 2)
+casts(-3.7, -2)
+
+
+# Python objects are converted on the way in and out
+@micropython.viper
+def objects(x: float, o):
+    y = float(o)
+    return x + o, o * x, y / 4.0, [x, -x]
+
+
+print(objects(1.5, 2))
+print(objects(0.5, 2.5))
+
+
+# a loop accumulating into a native local
+@micropython.viper
+def accumulate(n: int) -> float:
+    half = float(0.5)
+    s = float(0)
+    i = 0
+    while i < n:
+        s += float(i) * half
+        i += 1
+    return s
+
+
+print(accumulate(0), accumulate(10))
+
+
+# float literals are Python objects unless cast, so they mix with other objects
+@micropython.viper
+def literals(a, x: int):
+    s = 0.0
+    for v in a:
+        s += v
+    return s, float(x) * 0.5
+
+
+print(literals([1, 2.5, 0.5], 0), literals((), 1))
+
+
+# more live floats than there are registers for locals
+@micropython.viper
+def many(a: float, b: float, c: float, d: float, e: float) -> float:
+    x = a + b
+    y = c * d
+    z = x - y / e
+    return z + float(a)
+
+
+print(many(1.0, 2.0, 3.0, 4.0, 5.0))
+
+
+# unsupported operations
+def test(code):
+    try:
+        exec(code)
+    except ViperTypeError as e:
+        print(repr(e))
+
+
+test("@micropython.viper\ndef f(x: float): x // x")
+test("@micropython.viper\ndef f(x: float): x % x")
+test("@micropython.viper\ndef f(x: float): ~x")
+test("@micropython.viper\ndef f(x: float):\n if x: pass")
+test("@micropython.viper\ndef f(x: float): bool(x)")
+test("@micropython.viper\ndef f(x: float) -> int: return x")
+test("@micropython.viper\ndef f(x: float):\n y = 1\n y = x")
+test("@micropython.viper\ndef f(x):\n t = 0.5\n if x: t = None")
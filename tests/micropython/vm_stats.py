@@ -0,0 +1,47 @@
+# test micropython.vm_stats
+
+try:
+    import micropython
+
+    micropython.vm_stats
+except (AttributeError, ImportError):
+    print("SKIP")
+    raise SystemExit
+
+
+def f(n):
+    x = 0
+    for i in range(n):
+        x += i
+    return x
+
+
+def gen():
+    yield 1
+    yield 2
+
+
+micropython.vm_stats(True)
+for _ in range(10):
+    f(20)
+for _ in gen():
+    pass
+opcodes, functions = micropython.vm_stats(True)
+
+print(type(opcodes), type(functions))
+print(all(isinstance(op, int) and 0 <= op < 256 and n > 0 for op, n in opcodes.items()))
+print(sum(opcodes.values()) > 10 * 20)
+
+stats = {}
+for name, file, line, calls, ticks in functions:
+    stats[name] = (line > 0, calls, ticks >= 0)
+print(stats["f"])
+# generator is entered once per resumption: two yields and the final return
+print(stats["gen"])
+
+# stats were reset, so only the calls made since then are counted
+for _ in range(3):
+    f(20)
+opcodes, functions = micropython.vm_stats()
+calls = {name: calls for name, _, _, calls, _ in functions}
+print(calls.get("f"), "gen" in calls)
@@ -0,0 +1,87 @@
+# Test an asyncio TLS server handshaking with many clients at once using Stream.do_handshake.
+# The server records the largest number of handshakes it had in progress at the same time.
+
+try:
+    import asyncio
+    import ssl
+
+    asyncio.StreamReader.do_handshake
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+PORT = 8000
+NUM_CLIENTS = 4
+
+# These are test certificates. See tests/README.md for details.
+cert = cafile = "ec_cert.der"
+key = "ec_key.der"
+
+in_progress = 0
+max_in_progress = 0
+done = 0
+
+
+async def handle_connection(reader, writer):
+    global in_progress, max_in_progress, done
+    in_progress += 1
+    max_in_progress = max(max_in_progress, in_progress)
+    await reader.do_handshake()
+    in_progress -= 1
+    data = await reader.read(100)
+    writer.write(data)
+    await writer.drain()
+    writer.close()
+    await writer.wait_closed()
+    done += 1
+    if done == NUM_CLIENTS:
+        ev.set()
+
+
+async def tcp_server():
+    global ev
+
+    server_ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    server_ctx.load_cert_chain(cert, key)
+    ev = asyncio.Event()
+    server = await asyncio.start_server(
+        handle_connection, "0.0.0.0", PORT, backlog=NUM_CLIENTS, ssl=server_ctx
+    )
+    print("server running")
+    multitest.next()
+    async with server:
+        await asyncio.wait_for(ev.wait(), 30)
+    print("connections", done)
+    print("concurrent", max_in_progress > 1)
+
+
+async def tcp_client(client_ctx, i):
+    reader, writer = await asyncio.open_connection(
+        IP, PORT, ssl=client_ctx, server_hostname="micropython.local"
+    )
+    await reader.do_handshake()
+    message = b"client %d" % i
+    writer.write(message)
+    await writer.drain()
+    data = await reader.read(100)
+    writer.close()
+    await writer.wait_closed()
+    return data == message
+
+
+async def tcp_clients():
+    client_ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+    client_ctx.verify_mode = ssl.CERT_REQUIRED
+    client_ctx.load_verify_locations(cafile=cafile)
+    results = await asyncio.gather(*(tcp_client(client_ctx, i) for i in range(NUM_CLIENTS)))
+    print("results", results)
+
+
+def instance0():
+    multitest.globals(IP=multitest.get_network_ip())
+    asyncio.run(tcp_server())
+
+
+def instance1():
+    multitest.next()
+    asyncio.run(tcp_clients())
@@ -0,0 +1,99 @@
+# Test a TLS echo server when the client sends many small messages, either with a write per
+# message or with sendmsg coalescing them into full records.  The time taken by each is output
+# as a metric, not compared.
+
+try:
+    import socket
+    import ssl
+    import time
+
+    ssl.SSLSocket.sendmsg
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+PORT = 8000
+COUNT = 128
+MESSAGE = b"0123456789abcdef" * 2
+
+# These are test certificates. See tests/README.md for details.
+certfile = "ec_cert.der"
+keyfile = "ec_key.der"
+
+with open(certfile, "rb") as cf:
+    cert = cadata = cf.read()
+with open(keyfile, "rb") as kf:
+    key = kf.read()
+
+
+def echo(s, size):
+    buf = bytearray(1024)
+    mv = memoryview(buf)
+    n = 0
+    while n < size:
+        ret = s.readinto(mv[: min(len(buf), size - n)])
+        if not ret:
+            break
+        s.write(mv[:ret])
+        n += ret
+    return n
+
+
+def read_exactly(s, size):
+    buf = bytearray(size)
+    mv = memoryview(buf)
+    n = 0
+    while n < size:
+        ret = s.readinto(mv[n:])
+        if not ret:
+            break
+        n += ret
+    return buf[:n]
+
+
+# Server
+def instance0():
+    multitest.globals(IP=multitest.get_network_ip())
+    s = socket.socket()
+    s.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    s.bind(socket.getaddrinfo("0.0.0.0", PORT)[0][-1])
+    s.listen(1)
+    server_ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    server_ctx.load_cert_chain(cert, key)
+    multitest.next()
+    s2, _ = s.accept()
+    s2 = server_ctx.wrap_socket(s2, server_side=True)
+    for _ in range(2):
+        print(echo(s2, COUNT * len(MESSAGE)))
+    s2.close()
+    s.close()
+
+
+# Client
+def instance1():
+    client_ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+    client_ctx.verify_mode = ssl.CERT_REQUIRED
+    client_ctx.load_verify_locations(cadata=cadata)
+    if hasattr(client_ctx, "maximum_fragment_length"):
+        client_ctx.maximum_fragment_length = 1024
+    multitest.next()
+    s = socket.socket()
+    s.connect(socket.getaddrinfo(IP, PORT)[0][-1])
+    s = client_ctx.wrap_socket(s, server_hostname="micropython.local")
+    size = COUNT * len(MESSAGE)
+
+    t0 = time.ticks_us()
+    for _ in range(COUNT):
+        s.write(MESSAGE)
+    data = read_exactly(s, size)
+    t_write = time.ticks_diff(time.ticks_us(), t0)
+    print("write", data == MESSAGE * COUNT)
+
+    t0 = time.ticks_us()
+    print("sendmsg", s.sendmsg([MESSAGE] * COUNT))
+    data = read_exactly(s, size)
+    t_sendmsg = time.ticks_diff(time.ticks_us(), t0)
+    print("sendmsg", data == MESSAGE * COUNT)
+
+    multitest.output_metric("write {} us, sendmsg {} us".format(t_write, t_sendmsg))
+    s.close()
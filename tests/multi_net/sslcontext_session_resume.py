@@ -0,0 +1,83 @@
+# Test TLS session resumption using the session cache and session tickets.  The time taken by
+# a full handshake and by an abbreviated one is output as a metric, not compared.
+
+try:
+    import socket
+    import ssl
+    import time
+
+    ssl.SSLSession
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+PORT = 8000
+
+# These are test certificates. See tests/README.md for details.
+certfile = "ec_cert.der"
+keyfile = "ec_key.der"
+
+with open(certfile, "rb") as cf:
+    cert = cadata = cf.read()
+with open(keyfile, "rb") as kf:
+    key = kf.read()
+
+
+# Server
+def instance0():
+    multitest.globals(IP=multitest.get_network_ip())
+    s = socket.socket()
+    s.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    s.bind(socket.getaddrinfo("0.0.0.0", PORT)[0][-1])
+    s.listen(1)
+    server_ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    server_ctx.load_cert_chain(cert, key)
+    server_ctx.session_cache_size = 4
+    multitest.next()
+    for tickets in (True, True, False, False):
+        server_ctx.session_tickets = tickets
+        s2, _ = s.accept()
+        s2 = server_ctx.wrap_socket(s2, server_side=True)
+        print(s2.read(16))
+        s2.write(b"server to client")
+        s2.close()
+    s.close()
+
+
+def connect(client_ctx, **kwargs):
+    s = socket.socket()
+    s.connect(socket.getaddrinfo(IP, PORT)[0][-1])
+    t0 = time.ticks_us()
+    s = client_ctx.wrap_socket(s, server_hostname="micropython.local", **kwargs)
+    dt = time.ticks_diff(time.ticks_us(), t0)
+    s.write(b"client to server")
+    s.read(16)
+    reused = s.session_reused
+    session = s.session
+    s.close()
+    return dt, reused, session
+
+
+# Client
+def instance1():
+    client_ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_CLIENT)
+    client_ctx.verify_mode = ssl.CERT_REQUIRED
+    client_ctx.load_verify_locations(cadata=cadata)
+    client_ctx.session_cache_size = 4
+    multitest.next()
+
+    # Session tickets, with the session looked up in the context's cache.
+    full, reused, session = connect(client_ctx)
+    print("full", reused, session.has_ticket)
+    resumed, reused, _ = connect(client_ctx)
+    print("ticket", reused)
+    multitest.output_metric("ticket: full handshake {} us, resumed {} us".format(full, resumed))
+
+    # Server-side session cache, with the session passed explicitly.
+    client_ctx.session_tickets = False
+    client_ctx.session_cache_size = 0
+    full, reused, session = connect(client_ctx)
+    print("full", reused, session.has_ticket)
+    resumed, reused, _ = connect(client_ctx, session=session)
+    print("cache", reused)
+    multitest.output_metric("cache: full handshake {} us, resumed {} us".format(full, resumed))
@@ -0,0 +1,62 @@
+# Test performance of native generators and coroutines driven by asyncio, where each
+# task pulls values from a native generator and yields to the scheduler regularly.
+
+try:
+    import asyncio
+
+    @micropython.native
+    def _check():
+        yield
+except (ImportError, NameError, SyntaxError, ValueError):
+    print("SKIP")
+    raise SystemExit
+
+
+@micropython.native
+def produce(n):
+    i = 0
+    while i < n:
+        yield i * 3 + 1
+        i += 1
+
+
+@micropython.native
+async def worker(wid, n, out):
+    total = 0
+    for x in produce(n):
+        total += x & 0xFF
+        if x & 7 == 0:
+            await asyncio.sleep(0)
+    out[wid] = total
+
+
+async def main(ntask, n):
+    out = [0] * ntask
+    await asyncio.gather(*(worker(i, n, out) for i in range(ntask)))
+    return sum(out)
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 10): (4, 500),
+    (100, 10): (4, 1000),
+    (1000, 10): (10, 4000),
+    (5000, 10): (20, 10000),
+}
+
+
+def bm_setup(params):
+    ntask, n = params
+    expected = ntask * sum((i * 3 + 1) & 0xFF for i in range(n))
+    state = None
+
+    def run():
+        nonlocal state
+        state = asyncio.run(main(ntask, n))
+
+    def result():
+        return ntask * n // 100, state == expected
+
+    return run, result
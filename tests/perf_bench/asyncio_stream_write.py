@@ -0,0 +1,75 @@
+# Test performance of writing HTTP-style responses (many small writes) to an asyncio Stream.
+# The underlying stream counts the number of writes it receives, which corking should keep
+# to one per response.
+
+try:
+    import asyncio, io
+
+    asyncio.StreamWriter.cork
+    io.IOBase
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+class CountingStream(io.IOBase):
+    def __init__(self):
+        self.writes = 0
+        self.nbytes = 0
+
+    def write(self, buf):
+        self.writes += 1
+        self.nbytes += len(buf)
+        return len(buf)
+
+    def ioctl(self, req, arg):
+        # always ready when polled (req 3 is MP_STREAM_POLL)
+        return arg if req == 3 else 0
+
+
+BODY = b"x" * 200
+
+
+async def respond(w, i):
+    w.cork()
+    w.write(b"HTTP/1.0 200 OK\r\n")
+    w.write(b"Content-Type: text/html\r\n")
+    w.write(b"Content-Length: %d\r\n" % len(BODY))
+    w.write(b"X-Request: %d\r\n" % i)
+    w.write(b"\r\n")
+    w.write(BODY)
+    await w.drain()
+
+
+async def test(niter):
+    s = CountingStream()
+    w = asyncio.StreamWriter(s)
+    for i in range(niter):
+        await respond(w, i)
+    return s.writes, s.nbytes
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (20,),
+    (50, 10): (50,),
+    (100, 10): (100,),
+    (1000, 10): (1000,),
+    (5000, 10): (5000,),
+}
+
+
+def bm_setup(params):
+    (niter,) = params
+    state = None
+
+    def run():
+        nonlocal state
+        state = asyncio.run(test(niter))
+
+    def result():
+        return niter, state[0] == niter
+
+    return run, result
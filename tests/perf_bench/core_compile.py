@@ -0,0 +1,129 @@
+# Test the speed of compiling source code held in memory, which is dominated by the lexer
+# and parser.  The source is modelled on library code: long names, indentation and comments.
+#
+# Run directly, rather than through run-perfbench.py, this prints the time and the peak
+# heap use of a single compile of small and large sources (up to about 50KB), e.g.:
+#   micropython tests/perf_bench/core_compile.py
+
+try:
+    compile
+except NameError:
+    print("SKIP")
+    raise SystemExit
+
+SOURCE = """
+# Simple record store, in the style of a library module.
+
+
+class RecordStore:
+    # Records are kept in insertion order, indexed by key.
+
+    def __init__(self, default_capacity=16):
+        self._records_by_key = {}
+        self._insertion_order = []
+        self._default_capacity = default_capacity
+
+    def add_record(self, record_key, record_value):
+        # Replace any existing record with the same key.
+        if record_key not in self._records_by_key:
+            self._insertion_order.append(record_key)
+        self._records_by_key[record_key] = record_value
+
+    def remove_record(self, record_key):
+        if record_key in self._records_by_key:
+            del self._records_by_key[record_key]
+            self._insertion_order.remove(record_key)
+            return True
+        return False
+
+    def iterate_records(self):
+        for record_key in self._insertion_order:
+            yield record_key, self._records_by_key[record_key]
+
+
+def summarise_records(record_store, maximum_length=None):
+    total_length = 0
+    for record_key, record_value in record_store.iterate_records():
+        # Only count records that fit within the limit.
+        if maximum_length is None or len(record_value) <= maximum_length:
+            total_length += len(record_value)
+    return total_length
+"""
+
+
+def test(niter, source):
+    for _ in range(niter):
+        compile(source, "<bench>", "exec")
+    return len(source)
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (2, 1),
+    (50, 10): (5, 1),
+    (100, 10): (10, 2),
+    (1000, 10): (20, 8),
+    (5000, 10): (40, 16),
+    (5000, 200): (4, 40),
+}
+
+
+def bm_setup(params):
+    niter, nrepeat = params
+    source = SOURCE * nrepeat
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(niter, source)
+
+    def result():
+        return niter * nrepeat, state
+
+    return run, result
+
+
+###########################################################################
+# Standalone report of compile time and peak heap
+
+
+def compile_stats(source):
+    # Garbage isn't reclaimed while the GC is disabled, so the peak of the bytes allocated
+    # and not explicitly freed is the peak heap use of the compile.
+    import gc, micropython, time
+
+    gc.collect()
+    gc.disable()
+    try:
+        peak0 = micropython.mem_peak()
+        current0 = micropython.mem_current()
+        t0 = time.ticks_us()
+        compile(source, "<bench>", "exec")
+        t1 = time.ticks_us()
+        peak1 = micropython.mem_peak()
+    finally:
+        gc.enable()
+    return time.ticks_diff(t1, t0), peak1 - current0 if peak1 > peak0 else None
+
+
+def report():
+    try:
+        import micropython
+
+        micropython.mem_peak
+    except (ImportError, AttributeError):
+        print("SKIP: needs micropython.mem_peak (MICROPY_MEM_STATS)")
+        return
+    for nrepeat in (1, 8, 40):
+        source = SOURCE * nrepeat
+        # Compile once first so that all the qstrs exist.
+        compile(source, "<bench>", "exec")
+        t, peak = compile_stats(source)
+        print("{:6} bytes: {:6} us, peak heap {} bytes".format(len(source), t, peak))
+
+
+# run-perfbench.py passes the benchmark on stdin
+if globals().get("__file__", "<stdin>") != "<stdin>":
+    report()
@@ -0,0 +1,42 @@
+# Test performance of collections.deque used as a FIFO: filling a large queue,
+# then appending and popping from opposite ends at a steady length.
+
+from collections import deque
+
+
+def test(size, niter):
+    q = deque()
+    for i in range(size):
+        q.append(i)
+    total = 0
+    for i in range(niter):
+        q.append(i)
+        total += q.popleft()
+    while q:
+        total += q.popleft()
+    return total
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 10): (100, 1000),
+    (100, 100): (1000, 10000),
+    (1000, 1000): (10000, 100000),
+    (5000, 10000): (100000, 1000000),
+}
+
+
+def bm_setup(params):
+    size, niter = params
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(size, niter)
+
+    def result():
+        return niter, state
+
+    return run, result
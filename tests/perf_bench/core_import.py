@@ -0,0 +1,122 @@
+# Test performance of importing modules from .py source files, as done at startup.
+# On ports with a bytecode cache the first import of each module compiles and caches
+# it, and the timed imports load the cached bytecode.
+
+try:
+    import os, sys
+
+    os.mkdir
+    sys.path
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+DIRNAME = "core_import_tmp"
+
+SOURCE = """
+CONSTANT = {n}
+
+
+class Point{n}:
+    def __init__(self, x, y):
+        self.x = x
+        self.y = y
+
+    def __add__(self, other):
+        return Point{n}(self.x + other.x, self.y + other.y)
+
+    def __repr__(self):
+        return "Point{n}(%r, %r)" % (self.x, self.y)
+
+
+def parse(line):
+    fields = {{}}
+    for item in line.split(";"):
+        key, _, value = item.partition("=")
+        key = key.strip()
+        if not key:
+            continue
+        try:
+            fields[key] = int(value)
+        except ValueError:
+            fields[key] = value.strip()
+    return fields
+
+
+def checksum(data, seed=CONSTANT):
+    h = seed
+    for b in data:
+        h = (h * 31 + b) & 0xFFFFFFFF
+    return h
+
+
+def run():
+    p = Point{n}(1, 2) + Point{n}(3, 4)
+    return p.x + p.y + len(parse("a=1; b=2; c=x")) + checksum(b"abc")
+"""
+
+
+def module_name(i):
+    return "core_import_mod%d" % i
+
+
+def test(nmod):
+    total = 0
+    for i in range(nmod):
+        name = module_name(i)
+        sys.modules.pop(name, None)
+        total += __import__(name).run()
+    return total
+
+
+def cleanup(nmod):
+    for name in [module_name(i) + ".py" for i in range(nmod)]:
+        try:
+            os.remove(DIRNAME + "/" + name)
+        except OSError:
+            pass
+    try:
+        for name in os.listdir(DIRNAME + "/__pycache__"):
+            os.remove(DIRNAME + "/__pycache__/" + name)
+        os.rmdir(DIRNAME + "/__pycache__")
+    except OSError:
+        pass
+    try:
+        os.rmdir(DIRNAME)
+    except OSError:
+        pass
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (2,),
+    (50, 10): (5,),
+    (100, 10): (10,),
+    (1000, 10): (20,),
+    (5000, 10): (40,),
+}
+
+
+def bm_setup(params):
+    (nmod,) = params
+    cleanup(nmod)
+    os.mkdir(DIRNAME)
+    for i in range(nmod):
+        with open(DIRNAME + "/" + module_name(i) + ".py", "w") as f:
+            f.write(SOURCE.format(n=i))
+    sys.path.insert(0, DIRNAME)
+    expected = test(nmod)
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(nmod)
+
+    def result():
+        sys.path.remove(DIRNAME)
+        cleanup(nmod)
+        return nmod, state == expected
+
+    return run, result
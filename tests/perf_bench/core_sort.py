@@ -0,0 +1,52 @@
+# Test performance of list.sort on random, sorted, reversed and nearly-sorted data,
+# and sorted() with a key function.
+
+
+def make_data(n):
+    seed = 1
+    rand = []
+    for _ in range(n):
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+        rand.append(seed >> 8)
+    nearly = list(range(n))
+    for i in range(0, n, 97):
+        j = rand[i] % n
+        nearly[i], nearly[j] = nearly[j], nearly[i]
+    return [rand, list(range(n)), list(range(n, 0, -1)), nearly]
+
+
+def test(data):
+    check = 0
+    for l in data:
+        l = list(l)
+        l.sort()
+        check += l[len(l) // 3]
+    l = sorted(data[0], key=lambda x: x & 0xFFF)
+    check += l[len(l) // 3]
+    return check
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 100): (500,),
+    (100, 100): (1000,),
+    (1000, 1000): (10000,),
+    (5000, 10000): (100000,),
+}
+
+
+def bm_setup(params):
+    (n,) = params
+    data = make_data(n)
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(data)
+
+    def result():
+        return n // 100, state
+
+    return run, result
@@ -0,0 +1,52 @@
+# Test performance of decoding and encoding fixed-size binary records with the
+# module-level struct functions, which parse the format on every call.
+# See core_struct_obj.py for the same work done with a struct.Struct object.
+
+import struct
+
+FMT = "<HBbIhf"
+
+
+def make_data(n):
+    return b"".join(struct.pack(FMT, i, i & 0xFF, -(i & 0x7F), i * 7, -i, i / 4) for i in range(n))
+
+
+def test(data, n):
+    size = struct.calcsize(FMT)
+    out = bytearray(size)
+    total = 0
+    for i in range(n):
+        rec = struct.unpack_from(FMT, data, i * size)
+        total += rec[0] + rec[3] - rec[4]
+        struct.pack_into(FMT, out, 0, *rec)
+    return total, bytes(out)
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 10): (500,),
+    (100, 10): (1000,),
+    (1000, 100): (5000,),
+    (5000, 1000): (20000,),
+}
+
+
+def bm_setup(params):
+    (n,) = params
+    data = make_data(256)
+    state = None
+
+    def run():
+        nonlocal state
+        total = 0
+        for i in range(0, n, 256):
+            t, out = test(data, 256)
+            total += t
+        state = total, out
+
+    def result():
+        return n // 100, state
+
+    return run, result
@@ -0,0 +1,74 @@
+# Test performance of the arrayops module on sample buffers: mixing and scaling
+# 16-bit audio, clipping, summing, and a float dot product.
+
+try:
+    import arrayops
+    from array import array
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def repeat(typecode, pattern, n):
+    b = bytes(array(typecode, pattern))
+    return array(typecode, (b * (n // len(pattern) + 1))[: len(b) // len(pattern) * n])
+
+
+def test(n, niter):
+    a = repeat("h", range(-1000, 1000, 3), n)
+    b = repeat("h", range(500, -500, -7), n)
+    mix = array("h", bytes(2 * n))
+    f = array("f", bytes(4 * n))
+    check = 0
+    for _ in range(niter):
+        arrayops.add(mix, a, b)
+        arrayops.mul(mix, mix, 3)
+        arrayops.clip(mix, mix, -2048, 2047)
+        check += arrayops.sum(mix) + arrayops.max(mix) - arrayops.min(mix)
+        arrayops.convert(f, mix)
+        arrayops.mul(f, f, 0.25)
+        check += int(arrayops.dot(f, f))
+        arrayops.byteswap(mix)
+    return check
+
+
+def reference(n, niter):
+    # One iteration of test() using Python loops; each iteration is identical.
+    a = repeat("h", range(-1000, 1000, 3), n)
+    b = repeat("h", range(500, -500, -7), n)
+    total = 0
+    hi = -2048
+    lo = 2047
+    fdot = 0.0
+    for x, y in zip(a, b):
+        x = min(max(3 * (x + y), -2048), 2047)
+        total += x
+        hi = max(hi, x)
+        lo = min(lo, x)
+        fdot += (x * 0.25) * (x * 0.25)
+    return niter * (total + hi - lo + int(fdot))
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 100): (1000, 10),
+    (100, 100): (2000, 10),
+    (1000, 1000): (100000, 10),
+    (5000, 20000): (1000000, 10),
+}
+
+
+def bm_setup(params):
+    n, niter = params
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(n, niter)
+
+    def result():
+        return n * niter // 1000, state == reference(n, niter)
+
+    return run, result
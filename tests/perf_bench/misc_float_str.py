@@ -0,0 +1,44 @@
+# Test performance of converting floats to and from strings: repr() of values
+# that need up to 17 significant digits, and float() of the resulting strings.
+
+
+def test(niter, values):
+    total_len = 0
+    same = 0
+    for i in range(niter):
+        for x in values:
+            s = repr(x)
+            total_len += len(s)
+            same += float(s) == x
+    return total_len, same
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 10): (2, 20),
+    (100, 100): (10, 50),
+    (1000, 1000): (50, 200),
+    (5000, 10000): (200, 500),
+}
+
+
+def bm_setup(params):
+    niter, nvalues = params
+    # Values across many magnitudes, from a fixed LCG so every run uses the same set
+    values = []
+    seed = 1
+    for i in range(nvalues):
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+        values.append(seed / 7 * float("1e%d" % (seed % 60 - 30)))
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(niter, values)
+
+    def result():
+        return niter * nvalues, state
+
+    return run, result
@@ -0,0 +1,74 @@
+# Test performance of a timer scheduler on a list with heapq: timers fire in
+# deadline order and are rescheduled, and some are cancelled or moved earlier,
+# which heapq can only do by marking entries dead and pushing new ones.
+# See misc_pqueue_native.py for the same workload on heapq.PriorityQueue.
+
+try:
+    import heapq
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def test(ntimers, nsteps):
+    heap = []
+    timers = []
+    seq = 0
+    for i in range(ntimers):
+        t = [i * 7 % ntimers, seq, i, True]
+        seq += 1
+        heapq.heappush(heap, t)
+        timers.append(t)
+    seed = 1
+    check = 0
+    for step in range(nsteps):
+        e = heapq.heappop(heap)
+        while not e[3]:
+            e = heapq.heappop(heap)
+        now = e[0]
+        i = e[2]
+        e[3] = False
+        check = (check * 31 + now + i) & 0xFFFFFF
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+        t = [now + 1 + (seed >> 16) % 100, seq, i, True]
+        seq += 1
+        heapq.heappush(heap, t)
+        timers[i] = t
+        j = (seed >> 8) % ntimers
+        t = timers[j]
+        if t[3]:
+            t[3] = False
+            if step & 1:
+                t = [now + (seed >> 4) % 50, seq, j, True]
+            else:
+                t = [now + 200, seq, j, True]
+            seq += 1
+            heapq.heappush(heap, t)
+            timers[j] = t
+    return check
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 10): (20, 400),
+    (100, 10): (100, 1000),
+    (1000, 10): (100, 10000),
+    (1000, 100): (1000, 10000),
+    (5000, 100): (1000, 50000),
+}
+
+
+def bm_setup(params):
+    ntimers, nsteps = params
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(ntimers, nsteps)
+
+    def result():
+        return ntimers * nsteps, state
+
+    return run, result
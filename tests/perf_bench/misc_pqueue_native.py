@@ -0,0 +1,60 @@
+# Test performance of a timer scheduler on heapq.PriorityQueue: timers fire in
+# deadline order and are rescheduled, and some are cancelled or moved earlier.
+# See misc_pqueue_heapq.py for the same workload on a list with heapq.
+
+try:
+    from heapq import PriorityQueue
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+def test(ntimers, nsteps):
+    pq = PriorityQueue()
+    timers = [pq.push(i * 7 % ntimers, i) for i in range(ntimers)]
+    seed = 1
+    ok = True
+    now = 0
+    for step in range(nsteps):
+        e = pq.pop()
+        # Timers must fire in deadline order.
+        ok = ok and e.priority >= now
+        now = e.priority
+        i = e.item
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+        timers[i] = pq.push(now + 1 + (seed >> 16) % 100, i)
+        j = (seed >> 8) % ntimers
+        t = timers[j]
+        if t in pq:
+            if step & 1:
+                pq.update(t, now + (seed >> 4) % 50)
+            else:
+                pq.remove(t)
+                timers[j] = pq.push(now + 200, j)
+    return ok and len(pq) == ntimers
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 10): (20, 400),
+    (100, 10): (100, 1000),
+    (1000, 10): (100, 10000),
+    (1000, 100): (1000, 10000),
+    (5000, 100): (1000, 50000),
+}
+
+
+def bm_setup(params):
+    ntimers, nsteps = params
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(ntimers, nsteps)
+
+    def result():
+        return ntimers * nsteps, state
+
+    return run, result
@@ -0,0 +1,59 @@
+# Test throughput of micropython.RingBuffer between a producer thread writing
+# fixed-size chunks and the main thread reading them.
+
+try:
+    import _thread
+    import micropython
+
+    micropython.RingBuffer
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+def producer(rb, chunk, n):
+    for _ in range(n):
+        rb.write(chunk)
+    rb.close()
+
+
+def test(chunk_size, n):
+    rb = micropython.RingBuffer(16 * chunk_size)
+    chunk = bytes(range(256)) * (chunk_size // 256)
+    buf = bytearray(chunk_size)
+    _thread.start_new_thread(producer, (rb, chunk, n))
+    total = 0
+    ok = True
+    while True:
+        # Blocks until buf is full or the producer closes the ring.
+        size = rb.readinto(buf)
+        if not size:
+            break
+        total += size
+        ok = ok and buf == chunk
+    return ok and total == chunk_size * n
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 25): (256, 100),
+    (100, 100): (1024, 100),
+    (1000, 1000): (4096, 2000),
+    (5000, 1000): (4096, 20000),
+}
+
+
+def bm_setup(params):
+    chunk_size, n = params
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(chunk_size, n)
+
+    def result():
+        return chunk_size * n // 1000, state
+
+    return run, result
@@ -0,0 +1,53 @@
+# Test throughput of copying a file to another file descriptor with os.sendfile.
+# The score (norm / time) gives the throughput in KiB per second.
+
+import os
+
+if not hasattr(os, "sendfile") or not hasattr(os, "devnull"):
+    print("SKIP")
+    raise SystemExit
+
+FILENAME = "sendfile.tmp"
+
+
+def test(size):
+    with open(FILENAME, "rb") as f, open(os.devnull, "wb") as out:
+        n = 0
+        while n < size:
+            ret = os.sendfile(out.fileno(), f.fileno(), n, size - n)
+            if not ret:
+                break
+            n += ret
+    return n
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (32, 10): (16,),
+    (50, 10): (64,),
+    (100, 10): (256,),
+    (1000, 10): (1024,),
+    (5000, 10): (4096,),
+}
+
+
+def bm_setup(params):
+    (nkib,) = params
+    size = nkib * 1024
+    with open(FILENAME, "wb") as f:
+        chunk = bytes(range(256)) * 4
+        for _ in range(nkib):
+            f.write(chunk)
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(size)
+
+    def result():
+        os.remove(FILENAME)
+        return nkib, state == size
+
+    return run, result
@@ -0,0 +1,49 @@
+# Test performance of building a large text output from many small str and int
+# pieces with micropython.StringBuilder, finishing with a single str.
+
+try:
+    import micropython
+
+    micropython.StringBuilder
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+NAMES = ("alpha", "beta", "gamma", "delta", "epsilon", "zeta", "eta", "theta")
+
+
+def test(size):
+    sb = micropython.StringBuilder()
+    i = 0
+    while len(sb) < size:
+        sb.append(i, ",", NAMES[i & 7], ",", i * 7919 % 100003, "\n")
+        i += 1
+    s = sb.build()
+    return len(s) >= size and s.count("\n") == i and s.endswith(",%d\n" % ((i - 1) * 7919 % 100003))
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 25): (4_000,),
+    (100, 100): (16_000,),
+    (1000, 1000): (200_000,),
+    (1000, 4000): (1_000_000,),
+    (5000, 4000): (1_000_000,),
+}
+
+
+def bm_setup(params):
+    (size,) = params
+    state = None
+
+    def run():
+        nonlocal state
+        state = test(size)
+
+    def result():
+        return size // 1000, state
+
+    return run, result
@@ -0,0 +1,47 @@
+# Run a biquad low-pass filter over a generated signal with viper native floats
+
+try:
+    exec("@micropython.viper\ndef f(x: float) -> float: return x")
+except ViperTypeError:
+    print("SKIP")
+    raise SystemExit
+
+
+@micropython.viper
+def biquad(n: int) -> float:
+    # coefficients for a low-pass filter at a tenth of the sample rate
+    b0 = float(0.0674553)
+    b1 = float(0.1349106)
+    b2 = float(0.0674553)
+    a1 = float(-1.1429805)
+    a2 = float(0.4128016)
+    one = float(1)
+    x1 = float(0)
+    x2 = float(0)
+    y1 = float(0)
+    y2 = float(0)
+    energy = float(0)
+    i = 0
+    while i < n:
+        # square wave with a period of 16 samples
+        x = one if i & 8 else -one
+        y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2
+        x2 = x1
+        x1 = x
+        y2 = y1
+        y1 = y
+        energy += y * y
+        i += 1
+    return energy
+
+
+bm_params = {
+    (50, 10): (10000,),
+    (100, 10): (20000,),
+    (1000, 10): (200000,),
+    (5000, 10): (1000000,),
+}
+
+
+def bm_setup(params):
+    return lambda: biquad(params[0]), lambda: (params[0] // 1000, None)
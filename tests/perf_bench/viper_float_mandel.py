@@ -0,0 +1,52 @@
+# Compute the Mandelbrot set with viper native floats, to test unboxed float arithmetic
+
+try:
+    exec("@micropython.viper\ndef f(x: float) -> float: return x")
+except ViperTypeError:
+    print("SKIP")
+    raise SystemExit
+
+
+@micropython.viper
+def in_set(cr: float, ci: float) -> int:
+    zr = float(0)
+    zi = float(0)
+    four = float(4)
+    i = 0
+    while i < 32:
+        zr2 = zr * zr
+        zi2 = zi * zi
+        if zr2 + zi2 > four:
+            return i
+        zi = 2 * zr * zi + ci
+        zr = zr2 - zi2 + cr
+        i += 1
+    return 0
+
+
+@micropython.viper
+def mandelbrot(w: int, h: int) -> int:
+    total = 0
+    xscale = float(3.2) / float(w)
+    yscale = float(2.4) / float(h)
+    x0 = float(2.3)
+    y0 = float(1.2)
+    v = 0
+    while v < h:
+        u = 0
+        while u < w:
+            total += int(in_set(float(u) * xscale - x0, float(v) * yscale - y0))
+            u += 1
+        v += 1
+    return total
+
+
+bm_params = {
+    (100, 100): (20, 20),
+    (1000, 1000): (80, 80),
+    (5000, 1000): (150, 150),
+}
+
+
+def bm_setup(ps):
+    return lambda: mandelbrot(ps[0], ps[1]), lambda: (ps[0] * ps[1], None)
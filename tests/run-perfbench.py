@@ -8,6 +8,7 @@ import os
 import subprocess
 import sys
 import argparse
+import ast
 from glob import glob
 
 run_tests_module = __import__("run-tests")
@@ -88,6 +89,30 @@ def run_benchmark_on_target(target, script):
         return -1, -1, "CRASH: %r" % err
 
 
+def run_vm_stats_on_target(target, script):
+    output, err = run_script_on_target(target, script)
+    if err is not None:
+        return None
+    try:
+        return ast.literal_eval(output.splitlines()[-1])
+    except (IndexError, SyntaxError, ValueError):
+        return None
+
+
+def print_vm_stats(stats, top):
+    if stats is None:
+        print("  vm_stats: unavailable")
+        return
+    opcodes, functions = stats
+    total = sum(opcodes.values()) or 1
+    print("  opcodes: {}".format(sum(opcodes.values())))
+    for op, count in sorted(opcodes.items(), key=lambda x: -x[1])[:top]:
+        print("    0x{:02x} {:10} {:5.1f}%".format(op, count, 100 * count / total))
+    print("  functions:")
+    for name, file, line, calls, ticks in sorted(functions, key=lambda x: -x[4])[:top]:
+        print("    {:>10} {:12} {} ({}:{})".format(calls, ticks, name, file, line))
+
+
 def run_benchmarks(args, target, param_n, param_m, n_average, test_list):
     test_results = []
     skip_complex = run_feature_test(target, "complex") != "complex"
@@ -114,7 +139,16 @@ def run_benchmarks(args, target, param_n, param_m, n_average, test_list):
             test_script += f.read()
         with open(BENCH_SCRIPT_DIR + "benchrun.py", "rb") as f:
             test_script += f.read()
-        test_script += b"bm_run(%u, %u)\n" % (param_n, param_m)
+        bm_run_script = b"bm_run(%u, %u)\n" % (param_n, param_m)
+        if args.vm_stats:
+            # Collect VM statistics from a separate run, so counting doesn't affect the timings
+            vm_stats_script = (
+                test_script
+                + b"import micropython\nmicropython.vm_stats(True)\n"
+                + bm_run_script
+                + b"print(micropython.vm_stats())\n"
+            )
+        test_script += bm_run_script
 
         # Write full test script if needed
         if 0:
@@ -128,6 +162,12 @@ def run_benchmarks(args, target, param_n, param_m, n_average, test_list):
                 test_results.append((test_file, "fail", "preparation"))
                 print("CRASH:", test_script_target)
                 continue
+            if args.vm_stats:
+                crash, vm_stats_script = prepare_script_for_target(
+                    args, script_text=vm_stats_script
+                )
+                if crash:
+                    vm_stats_script = None
         else:
             test_script_target = test_script
 
@@ -180,6 +220,11 @@ def run_benchmarks(args, target, param_n, param_m, n_average, test_list):
             if 0:
                 print("  times: ", times)
                 print("  scores:", scores)
+            if args.vm_stats:
+                stats = None
+                if vm_stats_script is not None:
+                    stats = run_vm_stats_on_target(target, vm_stats_script)
+                print_vm_stats(stats, args.vm_stats)
 
         sys.stdout.flush()
 
@@ -274,6 +319,15 @@ def main():
     cmd_parser.add_argument("--heapsize", help="heapsize to use (use default if not specified)")
     cmd_parser.add_argument("--via-mpy", action="store_true", help="compile code to .mpy first")
     cmd_parser.add_argument("--mpy-cross-flags", default="", help="flags to pass to mpy-cross")
+    cmd_parser.add_argument(
+        "--vm-stats",
+        type=int,
+        nargs="?",
+        const=10,
+        default=0,
+        metavar="TOP",
+        help="print the TOP opcodes and functions from micropython.vm_stats() after each timing",
+    )
     cmd_parser.add_argument(
         "-r",
         "--result-dir",
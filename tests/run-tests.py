@@ -998,6 +998,8 @@ def run_tests(pyb, tests, args, result_dir, num_threads=1):
         skip_tests.add("float/float_struct_e_doubleprec.py")
         skip_tests.add("float/float_format_ints_doubleprec.py")
         skip_tests.add("float/float_parse_doubleprec.py")
+        skip_tests.add("float/float_parse_exact_doubleprec_intbig.py")
+        skip_tests.add("float/float_repr_shortest_doubleprec.py")
 
     if not args.unicode:
         skip_tests.add("extmod/json_loads.py")  # tests loading a utf-8 character
@@ -749,7 +749,9 @@ class CompiledModule:
                 % (
                     obj_name,
                     obj_type,
-                    qstrutil.compute_hash(obj, config.MICROPY_QSTR_BYTES_IN_HASH),
+                    qstrutil.compute_hash(
+                        obj, config.MICROPY_QSTR_BYTES_IN_HASH, config.MICROPY_QSTR_HASH_WORDWISE
+                    ),
                     len(obj),
                     "".join(("\\x%02x" % b) for b in obj),
                 )
@@ -1664,7 +1666,9 @@ def freeze_mpy(firmware_qstr_idents, compiled_modules):
         print()
         print("const qstr_hash_t mp_qstr_frozen_const_hashes[] = {")
         for _, _, _, qbytes in new:
-            qhash = qstrutil.compute_hash(qbytes, config.MICROPY_QSTR_BYTES_IN_HASH)
+            qhash = qstrutil.compute_hash(
+                qbytes, config.MICROPY_QSTR_BYTES_IN_HASH, config.MICROPY_QSTR_HASH_WORDWISE
+            )
             print("    %d," % qhash)
             qstr_content += config.MICROPY_QSTR_BYTES_IN_HASH
         print("};")
@@ -2149,9 +2153,11 @@ def main(args=None):
         firmware_qstr_idents = set(qstrutil.static_qstr_list_ident) | set(extra_qstrs.keys())
         config.MICROPY_QSTR_BYTES_IN_LEN = int(qcfgs["BYTES_IN_LEN"])
         config.MICROPY_QSTR_BYTES_IN_HASH = int(qcfgs["BYTES_IN_HASH"])
+        config.MICROPY_QSTR_HASH_WORDWISE = bool(int(qcfgs.get("HASH_WORDWISE", "0")))
     else:
         config.MICROPY_QSTR_BYTES_IN_LEN = 1
         config.MICROPY_QSTR_BYTES_IN_HASH = 1
+        config.MICROPY_QSTR_HASH_WORDWISE = False
         firmware_qstr_idents = set(qstrutil.static_qstr_list_ident)
 
     # Create initial list of global qstrs.